@@ -7,11 +7,13 @@
 
 #include "pnf_c.hpp"
 #include "pnf/pnf.hpp"
+#include <algorithm>
 #include <cstring>
+#include <span>
 #include <string>
 #include <vector>
 
-static PnfDoubleArray make_double_array(const std::vector<double>& vec) {
+static PnfDoubleArray make_double_array(const std::span<const double> vec) {
     PnfDoubleArray arr;
     arr.length = vec.size();
     if (arr.length > 0) {
@@ -107,6 +109,19 @@ extern "C" {
         return reinterpret_cast<PnfChart*>(new pnf::Chart(cfg));
     }
 
+    PnfChart* pnf_chart_create_atr(const PnfChartConfig* config, const int atr_period, const int atr_refresh) {
+        pnf::ChartConfig cfg;
+        if (config) {
+            cfg.method = static_cast<pnf::ConstructionMethod>(config->method);
+            cfg.box_size_method = static_cast<pnf::BoxSizeMethod>(config->box_size_method);
+            cfg.box_size = config->box_size;
+            cfg.reversal = config->reversal;
+        }
+        cfg.atr_period = atr_period;
+        cfg.atr_refresh = atr_refresh;
+        return reinterpret_cast<PnfChart*>(new pnf::Chart(cfg));
+    }
+
     PnfChart* pnf_chart_create_default(void) {
         return reinterpret_cast<PnfChart*>(new pnf::Chart());
     }
@@ -158,6 +173,12 @@ extern "C" {
         return c->current_box_size();
     }
 
+    double pnf_chart_atr(const PnfChart* chart) {
+        if (!chart) return 0.0;
+        auto* c = reinterpret_cast<const pnf::Chart*>(chart);
+        return c->atr();
+    }
+
     PnfColumnType pnf_chart_column_type(const PnfChart* chart, const size_t index) {
         if (!chart) return PNF_COLUMN_X;
         auto* c = reinterpret_cast<const pnf::Chart*>(chart);
@@ -187,32 +208,55 @@ extern "C" {
         return col ? col->lowest_price() : 0.0;
     }
 
+    int64_t pnf_chart_column_first_time(const PnfChart* chart, const size_t index) {
+        if (!chart) return 0;
+        auto* c = reinterpret_cast<const pnf::Chart*>(chart);
+        const auto* col = c->column(index);
+        return col ? static_cast<int64_t>(std::chrono::system_clock::to_time_t(col->first_time())) : 0;
+    }
+
+    int64_t pnf_chart_column_last_time(const PnfChart* chart, const size_t index) {
+        if (!chart) return 0;
+        auto* c = reinterpret_cast<const pnf::Chart*>(chart);
+        const auto* col = c->column(index);
+        return col ? static_cast<int64_t>(std::chrono::system_clock::to_time_t(col->last_time())) : 0;
+    }
+
+    size_t pnf_chart_column_bar_count(const PnfChart* chart, const size_t index) {
+        if (!chart) return 0;
+        auto* c = reinterpret_cast<const pnf::Chart*>(chart);
+        const auto* col = c->column(index);
+        return col ? col->bar_count() : 0;
+    }
+
+    int pnf_chart_column_at_time(const PnfChart* chart, const int64_t timestamp) {
+        if (!chart) return -1;
+        auto* c = reinterpret_cast<const pnf::Chart*>(chart);
+        return c->column_at(std::chrono::system_clock::from_time_t(timestamp));
+    }
+
     double pnf_chart_box_price(const PnfChart* chart, const size_t col_index, const size_t box_index) {
         if (!chart) return 0.0;
         auto* c = reinterpret_cast<const pnf::Chart*>(chart);
         const auto* col = c->column(col_index);
-        if (!col) return 0.0;
-        const auto* box = col->get_box_at(box_index);
-        return box ? box->price() : 0.0;
+        if (!col || box_index >= col->box_count()) return 0.0;
+        return col->box_at(box_index).price();
     }
 
     PnfBoxType pnf_chart_box_type(const PnfChart* chart, const size_t col_index, const size_t box_index) {
         if (!chart) return PNF_BOX_X;
         auto* c = reinterpret_cast<const pnf::Chart*>(chart);
         const auto* col = c->column(col_index);
-        if (!col) return PNF_BOX_X;
-        const auto* box = col->get_box_at(box_index);
-        return box ? static_cast<PnfBoxType>(box->type()) : PNF_BOX_X;
+        if (!col || box_index >= col->box_count()) return PNF_BOX_X;
+        return static_cast<PnfBoxType>(col->box_at(box_index).type());
     }
 
     const char* pnf_chart_box_marker(const PnfChart* chart, const size_t col_index, const size_t box_index) {
         if (!chart) return duplicate_string("");
         auto* c = reinterpret_cast<const pnf::Chart*>(chart);
         const auto* col = c->column(col_index);
-        if (!col) return duplicate_string("");
-        const auto* box = col->get_box_at(box_index);
-        if (!box) return duplicate_string("");
-        return duplicate_string(box->marker());
+        if (!col || box_index >= col->box_count()) return duplicate_string("");
+        return duplicate_string(col->box_at(box_index).marker());
     }
 
     bool pnf_chart_has_bullish_bias(const PnfChart* chart) {
@@ -559,13 +603,13 @@ extern "C" {
     size_t pnf_indicators_bullish_pattern_count(const PnfIndicators* ind) {
         if (!ind) return 0;
         auto* i = reinterpret_cast<const pnf::Indicators*>(ind);
-        return i->patterns()->bullish_patterns().size();
+        return i->patterns()->bullish_count();
     }
 
     size_t pnf_indicators_bearish_pattern_count(const PnfIndicators* ind) {
         if (!ind) return 0;
         auto* i = reinterpret_cast<const pnf::Indicators*>(ind);
-        return i->patterns()->bearish_patterns().size();
+        return i->patterns()->bearish_count();
     }
 
     static PnfPattern to_c_pattern(const pnf::Pattern& p) {
@@ -587,7 +631,7 @@ extern "C" {
         return {PNF_PATTERN_NONE, -1, -1, 0.0, false};
     }
 
-    static PnfPatternArray make_pattern_array(const std::vector<pnf::Pattern>& patterns) {
+    static PnfPatternArray make_pattern_array(const std::span<const pnf::Pattern> patterns) {
         PnfPatternArray arr;
         arr.length = patterns.size();
         if (arr.length > 0) {
@@ -622,13 +666,13 @@ extern "C" {
     size_t pnf_indicators_support_level_count(const PnfIndicators* ind) {
         if (!ind) return 0;
         auto* i = reinterpret_cast<const pnf::Indicators*>(ind);
-        return i->support_resistance()->support_levels().size();
+        return std::ranges::distance(i->support_resistance()->support_levels_view());
     }
 
     size_t pnf_indicators_resistance_level_count(const PnfIndicators* ind) {
         if (!ind) return 0;
         auto* i = reinterpret_cast<const pnf::Indicators*>(ind);
-        return i->support_resistance()->resistance_levels().size();
+        return std::ranges::distance(i->support_resistance()->resistance_levels_view());
     }
 
     bool pnf_indicators_is_near_support(const PnfIndicators* ind, const double price, const double tolerance) {
@@ -643,15 +687,20 @@ extern "C" {
         return i->support_resistance()->is_near_resistance(price, tolerance);
     }
 
-    static PnfLevelArray make_level_array(const std::vector<pnf::SupportResistanceLevel>& levels, const bool is_support) {
+    static PnfLevelArray make_level_array(const std::span<const pnf::SupportResistanceLevel> levels, const bool is_support) {
         PnfLevelArray arr;
-        arr.length = levels.size();
+        arr.length = std::ranges::count_if(levels, [is_support](const pnf::SupportResistanceLevel& l) {
+            return l.is_support == is_support;
+        });
         if (arr.length > 0) {
             arr.data = new PnfSupportResistanceLevel[arr.length];
-            for (size_t j = 0; j < arr.length; ++j) {
-                arr.data[j].price = levels[j].price;
-                arr.data[j].touch_count = levels[j].touch_count;
+            size_t j = 0;
+            for (const auto& level : levels) {
+                if (level.is_support != is_support) continue;
+                arr.data[j].price = level.price;
+                arr.data[j].touch_count = level.touch_count;
                 arr.data[j].is_support = is_support;
+                ++j;
             }
         } else {
             arr.data = nullptr;
@@ -662,13 +711,13 @@ extern "C" {
     PnfLevelArray pnf_indicators_support_levels(const PnfIndicators* ind) {
         if (!ind) return {nullptr, 0};
         auto* i = reinterpret_cast<const pnf::Indicators*>(ind);
-        return make_level_array(i->support_resistance()->support_levels(), true);
+        return make_level_array(i->support_resistance()->levels(), true);
     }
 
     PnfLevelArray pnf_indicators_resistance_levels(const PnfIndicators* ind) {
         if (!ind) return {nullptr, 0};
         auto* i = reinterpret_cast<const pnf::Indicators*>(ind);
-        return make_level_array(i->support_resistance()->resistance_levels(), false);
+        return make_level_array(i->support_resistance()->levels(), false);
     }
 
     PnfDoubleArray pnf_indicators_support_prices(const PnfIndicators* ind) {
@@ -698,7 +747,7 @@ extern "C" {
     PnfIndicatorData* pnf_indicators_export_data(const PnfIndicators* ind) {
         if (!ind) return nullptr;
         auto* i = reinterpret_cast<const pnf::Indicators*>(ind);
-        auto data = i->export_data();
+        const pnf::IndicatorDataView data = i->export_view();
 
         auto* result = new PnfIndicatorData;
         result->sma_short = make_double_array(data.sma_short);
@@ -724,8 +773,8 @@ extern "C" {
         }
 
         result->patterns = make_pattern_array(data.patterns);
-        result->support_levels = make_level_array(data.support_levels, true);
-        result->resistance_levels = make_level_array(data.resistance_levels, false);
+        result->support_levels = make_level_array(data.levels, true);
+        result->resistance_levels = make_level_array(data.levels, false);
 
         return result;
     }
@@ -760,6 +809,108 @@ extern "C" {
         return duplicate_string(i->to_string());
     }
 
+    // Scanner
+    PnfScanQuery pnf_scan_query_default(void) {
+        const pnf::ScanQuery defaults;
+        PnfScanQuery query;
+        query.patterns = nullptr;
+        query.pattern_count = 0;
+        query.signal = static_cast<PnfSignalType>(defaults.signal);
+        query.lookback = defaults.lookback;
+        query.context_columns = defaults.context_columns;
+        query.bias = static_cast<PnfScanBias>(defaults.bias);
+        query.above_bullish_support = defaults.above_bullish_support;
+        query.below_bearish_resistance = defaults.below_bearish_resistance;
+        query.near_support = defaults.near_support;
+        query.near_resistance = defaults.near_resistance;
+        query.congestion = static_cast<PnfScanCongestion>(defaults.congestion);
+        query.rsi_min = defaults.rsi_min;
+        query.rsi_max = defaults.rsi_max;
+        query.rsi_period = defaults.rsi_period;
+        query.min_columns = defaults.min_columns;
+        query.limit = defaults.limit;
+        return query;
+    }
+
+    PnfScanner* pnf_scanner_create(const size_t threads) {
+        return reinterpret_cast<PnfScanner*>(new pnf::Scanner(threads));
+    }
+
+    void pnf_scanner_destroy(PnfScanner* scanner) {
+        delete reinterpret_cast<pnf::Scanner*>(scanner);
+    }
+
+    size_t pnf_scanner_add(PnfScanner* scanner, const char* symbol, const PnfChart* chart, const PnfIndicators* ind) {
+        if (!scanner || !chart) return PNF_SCANNER_INVALID_INDEX;
+        auto* s = reinterpret_cast<pnf::Scanner*>(scanner);
+        return s->add(symbol ? symbol : "",
+                      *reinterpret_cast<const pnf::Chart*>(chart),
+                      reinterpret_cast<const pnf::Indicators*>(ind));
+    }
+
+    void pnf_scanner_clear(PnfScanner* scanner) {
+        if (!scanner) return;
+        reinterpret_cast<pnf::Scanner*>(scanner)->clear();
+    }
+
+    size_t pnf_scanner_size(const PnfScanner* scanner) {
+        if (!scanner) return 0;
+        return reinterpret_cast<const pnf::Scanner*>(scanner)->size();
+    }
+
+    const char* pnf_scanner_symbol(const PnfScanner* scanner, const size_t index) {
+        if (!scanner) return nullptr;
+        auto* s = reinterpret_cast<const pnf::Scanner*>(scanner);
+        if (index >= s->size()) return nullptr;
+        return duplicate_string(s->symbol(index));
+    }
+
+    PnfScanMatchArray pnf_scanner_scan(const PnfScanner* scanner, const PnfScanQuery* query) {
+        if (!scanner) return {nullptr, 0};
+        auto* s = reinterpret_cast<const pnf::Scanner*>(scanner);
+
+        pnf::ScanQuery q;
+        if (query) {
+            for (size_t j = 0; query->patterns && j < query->pattern_count; ++j) {
+                const int type = static_cast<int>(query->patterns[j]);
+                if (type < PNF_PATTERN_NONE || type > PNF_PATTERN_SPREAD_TRIPLE_BOTTOM) return {nullptr, 0};
+                q.patterns.push_back(static_cast<pnf::PatternType>(type));
+            }
+            q.signal = static_cast<pnf::SignalType>(query->signal);
+            q.lookback = query->lookback;
+            q.context_columns = query->context_columns;
+            q.bias = static_cast<pnf::ScanBias>(query->bias);
+            q.above_bullish_support = query->above_bullish_support;
+            q.below_bearish_resistance = query->below_bearish_resistance;
+            q.near_support = query->near_support;
+            q.near_resistance = query->near_resistance;
+            q.congestion = static_cast<pnf::ScanCongestion>(query->congestion);
+            q.rsi_min = query->rsi_min;
+            q.rsi_max = query->rsi_max;
+            q.rsi_period = query->rsi_period;
+            q.min_columns = query->min_columns;
+            q.limit = query->limit;
+        }
+
+        const auto matches = s->scan(q);
+        PnfScanMatchArray arr;
+        arr.length = matches.size();
+        if (arr.length > 0) {
+            arr.data = new PnfScanMatch[arr.length];
+            for (size_t j = 0; j < arr.length; ++j) {
+                arr.data[j].index = matches[j].index;
+                arr.data[j].score = matches[j].score;
+                arr.data[j].column = matches[j].column;
+                arr.data[j].price = matches[j].price;
+                arr.data[j].pattern = static_cast<PnfPatternType>(matches[j].pattern);
+                arr.data[j].signal = static_cast<PnfSignalType>(matches[j].signal);
+            }
+        } else {
+            arr.data = nullptr;
+        }
+        return arr;
+    }
+
     void pnf_free_string(const char* str) {
         delete[] str;
     }
@@ -780,6 +931,10 @@ extern "C" {
         delete[] arr.data;
     }
 
+    void pnf_free_scan_match_array(const PnfScanMatchArray arr) {
+        delete[] arr.data;
+    }
+
     // Interactive Viewer
     PnfViewer* pnf_viewer_create(const char* title, const int width, const int height) {
         pnf::ViewerConfig config;
@@ -32,6 +32,8 @@ extern "C" {
     typedef struct PnfIndicators PnfIndicators;
 /// \brief Opaque viewer handle.
     typedef struct PnfViewer PnfViewer;
+/// \brief Opaque scanner handle.
+    typedef struct PnfScanner PnfScanner;
 
 /// \brief Box type enumeration.
     typedef enum {
@@ -57,7 +59,9 @@ extern "C" {
         PNF_BOX_SIZE_FIXED = 0,
         PNF_BOX_SIZE_TRADITIONAL = 1,
         PNF_BOX_SIZE_PERCENTAGE = 2,
-        PNF_BOX_SIZE_POINTS = 3
+        PNF_BOX_SIZE_POINTS = 3,
+        PNF_BOX_SIZE_ATR = 4,
+        PNF_BOX_SIZE_LOGARITHMIC = 5
     } PnfBoxSizeMethod;
 
 /// \brief Signal type enumeration.
@@ -212,6 +216,56 @@ extern "C" {
         PnfLevelArray resistance_levels;
     } PnfIndicatorData;
 
+/// \brief Scan trend-bias filter.
+    typedef enum {
+        PNF_SCAN_BIAS_ANY = 0,
+        PNF_SCAN_BIAS_BULLISH = 1,
+        PNF_SCAN_BIAS_BEARISH = 2
+    } PnfScanBias;
+
+/// \brief Scan congestion-membership filter.
+    typedef enum {
+        PNF_SCAN_CONGESTION_ANY = 0,
+        PNF_SCAN_CONGESTION_INSIDE = 1,
+        PNF_SCAN_CONGESTION_OUTSIDE = 2
+    } PnfScanCongestion;
+
+/// \brief Declarative scan query. Obtain defaults from pnf_scan_query_default().
+    typedef struct {
+        const PnfPatternType* patterns;
+        size_t pattern_count;
+        PnfSignalType signal;
+        int lookback;
+        int context_columns;
+        PnfScanBias bias;
+        bool above_bullish_support;
+        bool below_bearish_resistance;
+        double near_support;
+        double near_resistance;
+        PnfScanCongestion congestion;
+        double rsi_min;
+        double rsi_max;
+        int rsi_period;
+        int min_columns;
+        size_t limit;
+    } PnfScanQuery;
+
+/// \brief PnfScanMatch.
+    typedef struct {
+        size_t index;
+        double score;
+        int column;
+        double price;
+        PnfPatternType pattern;
+        PnfSignalType signal;
+    } PnfScanMatch;
+
+/// \brief PnfScanMatchArray.
+    typedef struct {
+        PnfScanMatch* data;
+        size_t length;
+    } PnfScanMatchArray;
+
     // Version
 /// \brief Version string.
     /// \return 
@@ -242,6 +296,12 @@ extern "C" {
 /// \brief Chart create default.
     /// \return 
     PNF_API PnfChart* pnf_chart_create_default(void);
+/// \brief Chart create with ATR box sizing parameters.
+    /// \param config Chart config; box_size is the ATR multiple
+    /// \param atr_period ATR lookback in bars
+    /// \param atr_refresh Bars between box size refreshes, 0 to keep the first ATR box
+    /// \return 
+    PNF_API PnfChart* pnf_chart_create_atr(const PnfChartConfig* config, int atr_period, int atr_refresh);
 /// \brief Chart destroy.
     /// \param chart 
     PNF_API void pnf_chart_destroy(PnfChart* chart);
@@ -284,6 +344,10 @@ extern "C" {
     /// \param chart 
     /// \return 
     PNF_API double pnf_chart_box_size(const PnfChart* chart);
+/// \brief Chart streaming ATR (ATR box size only).
+    /// \param chart 
+    /// \return 
+    PNF_API double pnf_chart_atr(const PnfChart* chart);
 
     // Column info
 /// \brief Chart column type.
@@ -306,6 +370,26 @@ extern "C" {
     /// \param index 
     /// \return 
     PNF_API double pnf_chart_column_lowest(const PnfChart* chart, size_t index);
+/// \brief Chart column first bar time.
+    /// \param chart 
+    /// \param index 
+    /// \return Unix time in seconds, 0 if no bar was recorded
+    PNF_API int64_t pnf_chart_column_first_time(const PnfChart* chart, size_t index);
+/// \brief Chart column last bar time.
+    /// \param chart 
+    /// \param index 
+    /// \return Unix time in seconds, 0 if no bar was recorded
+    PNF_API int64_t pnf_chart_column_last_time(const PnfChart* chart, size_t index);
+/// \brief Chart column bar count.
+    /// \param chart 
+    /// \param index 
+    /// \return 
+    PNF_API size_t pnf_chart_column_bar_count(const PnfChart* chart, size_t index);
+/// \brief Chart column at time.
+    /// \param chart 
+    /// \param timestamp Unix time in seconds
+    /// \return Column index, or -1 if timestamp precedes the first column
+    PNF_API int pnf_chart_column_at_time(const PnfChart* chart, int64_t timestamp);
 
     // Box info
 /// \brief Chart box price.
@@ -661,6 +745,45 @@ extern "C" {
     /// \return 
     PNF_API const char* pnf_indicators_to_string(const PnfIndicators* ind);
 
+    // Scanner
+/// \brief Scan query default.
+    /// \return 
+    PNF_API PnfScanQuery pnf_scan_query_default(void);
+/// \brief Scanner create.
+    /// \param threads Worker count; 0 uses hardware concurrency, 1 scans on the calling thread
+    /// \return 
+    PNF_API PnfScanner* pnf_scanner_create(size_t threads);
+/// \brief Scanner destroy.
+    /// \param scanner 
+    PNF_API void pnf_scanner_destroy(PnfScanner* scanner);
+/// \brief Returned by pnf_scanner_add when the scanner or chart is NULL.
+    #define PNF_SCANNER_INVALID_INDEX SIZE_MAX
+
+/// \brief Scanner add. The chart and indicators are borrowed and must outlive the scanner.
+    /// \param scanner 
+    /// \param symbol 
+    /// \param chart 
+    /// \param ind Optional precomputed indicators, may be NULL
+    /// \return Index of the symbol, or PNF_SCANNER_INVALID_INDEX if scanner or chart is NULL
+    PNF_API size_t pnf_scanner_add(PnfScanner* scanner, const char* symbol, const PnfChart* chart, const PnfIndicators* ind);
+/// \brief Scanner clear.
+    /// \param scanner 
+    PNF_API void pnf_scanner_clear(PnfScanner* scanner);
+/// \brief Scanner size.
+    /// \param scanner 
+    /// \return 
+    PNF_API size_t pnf_scanner_size(const PnfScanner* scanner);
+/// \brief Scanner symbol.
+    /// \param scanner 
+    /// \param index 
+    /// \return Newly allocated string; release with pnf_free_string
+    PNF_API const char* pnf_scanner_symbol(const PnfScanner* scanner, size_t index);
+/// \brief Scanner scan. Matches are ranked by descending score.
+    /// \param scanner 
+    /// \param query Query, or NULL for defaults; a pattern outside the PnfPatternType range matches nothing
+    /// \return 
+    PNF_API PnfScanMatchArray pnf_scanner_scan(const PnfScanner* scanner, const PnfScanQuery* query);
+
     // Memory management
 /// \brief Free string.
     /// \param str 
@@ -677,6 +800,9 @@ extern "C" {
 /// \brief Free level array.
     /// \param arr 
     PNF_API void pnf_free_level_array(PnfLevelArray arr);
+/// \brief Free scan match array.
+    /// \param arr 
+    PNF_API void pnf_free_scan_match_array(PnfScanMatchArray arr);
 
     // Interactive viewer
 /// \brief Viewer create.
@@ -39,7 +39,9 @@ namespace PnF
         Fixed = 0,
         Traditional = 1,
         Percentage = 2,
-        Points = 3
+        Points = 3,
+        ATR = 4,
+        Logarithmic = 5
     }
 
     /// <summary>
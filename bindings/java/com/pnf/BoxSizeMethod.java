@@ -11,5 +11,9 @@ public enum BoxSizeMethod {
     /** Use a percentage of price for dynamic box sizing. */
     PERCENTAGE,
     /** Use point-based sizing from the underlying instrument tick scale. */
-    POINTS
+    POINTS,
+    /** Use a multiple of the streaming average true range. */
+    ATR,
+    /** Use a fixed logarithmic grid where each box is a constant percentage step. */
+    LOGARITHMIC
 }
@@ -130,10 +130,8 @@ JNIEXPORT jdouble JNICALL
 Java_com_pnf_Chart_nativeBoxPrice(JNIEnv* env, jclass clazz, jlong ptr, jint columnIndex, jint boxIndex) {
     Chart* chart = reinterpret_cast<Chart*>(ptr);
     Column* col = chart->column(columnIndex);
-    if (col) {
-        if (const Box* box = col->get_box_at(boxIndex)) {
-            return box->price();
-        }
+    if (col && static_cast<size_t>(boxIndex) < col->box_count()) {
+        return col->box_at(boxIndex).price();
     }
     return 0.0;
 }
@@ -142,10 +140,8 @@ JNIEXPORT jint JNICALL
 Java_com_pnf_Chart_nativeBoxType(JNIEnv* env, jclass clazz, jlong ptr, jint columnIndex, jint boxIndex) {
     Chart* chart = reinterpret_cast<Chart*>(ptr);
     Column* col = chart->column(columnIndex);
-    if (col) {
-        if (const Box* box = col->get_box_at(boxIndex)) {
-            return static_cast<jint>(box->type());
-        }
+    if (col && static_cast<size_t>(boxIndex) < col->box_count()) {
+        return static_cast<jint>(col->box_at(boxIndex).type());
     }
     return static_cast<jint>(BoxType::X);
 }
@@ -154,11 +150,9 @@ JNIEXPORT jstring JNICALL
 Java_com_pnf_Chart_nativeBoxMarker(JNIEnv* env, jclass clazz, jlong ptr, jint columnIndex, jint boxIndex) {
     Chart* chart = reinterpret_cast<Chart*>(ptr);
     Column* col = chart->column(columnIndex);
-    if (col) {
-        if (const Box* box = col->get_box_at(boxIndex)) {
-            const std::string marker = box->marker();
-            return env->NewStringUTF(marker.c_str());
-        }
+    if (col && static_cast<size_t>(boxIndex) < col->box_count()) {
+        const std::string marker = col->box_at(boxIndex).marker();
+        return env->NewStringUTF(marker.c_str());
     }
     return env->NewStringUTF("");
 }
@@ -296,7 +290,7 @@ Java_com_pnf_Indicators_nativeSmaLong(JNIEnv* env, jclass clazz, jlong ptr, jint
 JNIEXPORT jdoubleArray JNICALL
 Java_com_pnf_Indicators_nativeSmaShortValues(JNIEnv* env, jclass clazz, jlong ptr) {
     Indicators* indicators = reinterpret_cast<Indicators*>(ptr);
-    const std::vector<double>& values = indicators->sma_short()->values();
+    const auto& values = indicators->sma_short()->values();
 
     jdoubleArray result = env->NewDoubleArray(values.size());
     if (result) {
@@ -308,7 +302,7 @@ Java_com_pnf_Indicators_nativeSmaShortValues(JNIEnv* env, jclass clazz, jlong pt
 JNIEXPORT jdoubleArray JNICALL
 Java_com_pnf_Indicators_nativeSmaMediumValues(JNIEnv* env, jclass clazz, jlong ptr) {
     Indicators* indicators = reinterpret_cast<Indicators*>(ptr);
-    const std::vector<double>& values = indicators->sma_medium()->values();
+    const auto& values = indicators->sma_medium()->values();
 
     jdoubleArray result = env->NewDoubleArray(values.size());
     if (result) {
@@ -320,7 +314,7 @@ Java_com_pnf_Indicators_nativeSmaMediumValues(JNIEnv* env, jclass clazz, jlong p
 JNIEXPORT jdoubleArray JNICALL
 Java_com_pnf_Indicators_nativeSmaLongValues(JNIEnv* env, jclass clazz, jlong ptr) {
     Indicators* indicators = reinterpret_cast<Indicators*>(ptr);
-    const std::vector<double>& values = indicators->sma_long()->values();
+    const auto& values = indicators->sma_long()->values();
 
     jdoubleArray result = env->NewDoubleArray(values.size());
     if (result) {
@@ -369,7 +363,7 @@ Java_com_pnf_Indicators_nativeIsBelowLowerBand(JNIEnv* env, jclass clazz, jlong
 JNIEXPORT jdoubleArray JNICALL
 Java_com_pnf_Indicators_nativeBollingerMiddleValues(JNIEnv* env, jclass clazz, jlong ptr) {
     Indicators* indicators = reinterpret_cast<Indicators*>(ptr);
-    const std::vector<double>& values = indicators->bollinger()->middle_band();
+    const auto& values = indicators->bollinger()->middle_band();
 
     jdoubleArray result = env->NewDoubleArray(values.size());
     if (result) {
@@ -381,7 +375,7 @@ Java_com_pnf_Indicators_nativeBollingerMiddleValues(JNIEnv* env, jclass clazz, j
 JNIEXPORT jdoubleArray JNICALL
 Java_com_pnf_Indicators_nativeBollingerUpperValues(JNIEnv* env, jclass clazz, jlong ptr) {
     Indicators* indicators = reinterpret_cast<Indicators*>(ptr);
-    const std::vector<double>& values = indicators->bollinger()->upper_band();
+    const auto& values = indicators->bollinger()->upper_band();
 
     jdoubleArray result = env->NewDoubleArray(values.size());
     if (result) {
@@ -393,7 +387,7 @@ Java_com_pnf_Indicators_nativeBollingerUpperValues(JNIEnv* env, jclass clazz, jl
 JNIEXPORT jdoubleArray JNICALL
 Java_com_pnf_Indicators_nativeBollingerLowerValues(JNIEnv* env, jclass clazz, jlong ptr) {
     Indicators* indicators = reinterpret_cast<Indicators*>(ptr);
-    const std::vector<double>& values = indicators->bollinger()->lower_band();
+    const auto& values = indicators->bollinger()->lower_band();
 
     jdoubleArray result = env->NewDoubleArray(values.size());
     if (result) {
@@ -430,7 +424,7 @@ Java_com_pnf_Indicators_nativeIsOversold(JNIEnv* env, jclass clazz, jlong ptr, j
 JNIEXPORT jdoubleArray JNICALL
 Java_com_pnf_Indicators_nativeRsiValues(JNIEnv* env, jclass clazz, jlong ptr) {
     Indicators* indicators = reinterpret_cast<Indicators*>(ptr);
-    const std::vector<double>& values = indicators->rsi()->values();
+    const auto& values = indicators->rsi()->values();
 
     jdoubleArray result = env->NewDoubleArray(values.size());
     if (result) {
@@ -449,7 +443,7 @@ Java_com_pnf_Indicators_nativeObv(JNIEnv* env, jclass clazz, jlong ptr, jint col
 JNIEXPORT jdoubleArray JNICALL
 Java_com_pnf_Indicators_nativeObvValues(JNIEnv* env, jclass clazz, jlong ptr) {
     Indicators* indicators = reinterpret_cast<Indicators*>(ptr);
-    const std::vector<double>& values = indicators->obv()->values();
+    const auto& values = indicators->obv()->values();
 
     jdoubleArray result = env->NewDoubleArray(values.size());
     if (result) {
@@ -517,7 +511,7 @@ Java_com_pnf_Indicators_nativeSellSignalCount(JNIEnv* env, jclass clazz, jlong p
 JNIEXPORT jobjectArray JNICALL
 Java_com_pnf_Indicators_nativeGetSignals(JNIEnv* env, jclass clazz, jlong ptr) {
     Indicators* indicators = reinterpret_cast<Indicators*>(ptr);
-    const std::vector<Signal>& signals = indicators->signals()->signals();
+    const auto& signals = indicators->signals()->signals();
 
     jclass signalClass = env->FindClass("com/pnf/Signal");
     jclass signalTypeClass = env->FindClass("com/pnf/SignalType");
@@ -620,7 +614,7 @@ Java_com_pnf_Indicators_nativeHasPattern(JNIEnv* env, jclass clazz, jlong ptr, j
 JNIEXPORT jobjectArray JNICALL
 Java_com_pnf_Indicators_nativeGetPatterns(JNIEnv* env, jclass clazz, jlong ptr) {
     Indicators* indicators = reinterpret_cast<Indicators*>(ptr);
-    const std::vector<Pattern>& patterns = indicators->patterns()->patterns();
+    const auto& patterns = indicators->patterns()->patterns();
 
     jclass patternClass = env->FindClass("com/pnf/Pattern");
     jclass patternTypeClass = env->FindClass("com/pnf/PatternType");
@@ -700,7 +694,7 @@ Java_com_pnf_Indicators_nativeGetBearishPatterns(JNIEnv* env, jclass clazz, jlon
 JNIEXPORT jobjectArray JNICALL
 Java_com_pnf_Indicators_nativeGetLevels(JNIEnv* env, jclass clazz, jlong ptr) {
     Indicators* indicators = reinterpret_cast<Indicators*>(ptr);
-    const std::vector<SupportResistanceLevel>& levels = indicators->support_resistance()->levels();
+    const auto& levels = indicators->support_resistance()->levels();
 
     jclass levelClass = env->FindClass("com/pnf/SupportResistanceLevel");
     jclass levelTypeClass = env->FindClass("com/pnf/LevelType");
@@ -845,7 +839,7 @@ Java_com_pnf_Indicators_nativeGetResistancePrices(JNIEnv* env, jclass clazz, jlo
 JNIEXPORT jobjectArray JNICALL
 Java_com_pnf_Indicators_nativeGetPriceObjectives(JNIEnv* env, jclass clazz, jlong ptr) {
     Indicators* indicators = reinterpret_cast<Indicators*>(ptr);
-    const std::vector<PriceObjective>& objectives = indicators->objectives()->objectives();
+    const auto& objectives = indicators->objectives()->objectives();
 
     jclass objectiveClass = env->FindClass("com/pnf/PriceObjective");
     jmethodID objectiveConstructor = env->GetMethodID(objectiveClass, "<init>", "(DIZ)V");
@@ -928,7 +922,7 @@ Java_com_pnf_Indicators_nativeGetBearishTargets(JNIEnv* env, jclass clazz, jlong
 JNIEXPORT jobjectArray JNICALL
 Java_com_pnf_Indicators_nativeGetCongestionZones(JNIEnv* env, jclass clazz, jlong ptr) {
     Indicators* indicators = reinterpret_cast<Indicators*>(ptr);
-    const std::vector<CongestionDetector::CongestionZone>& zones = indicators->congestion()->zones();
+    const auto& zones = indicators->congestion()->zones();
 
     jclass zoneClass = env->FindClass("com/pnf/CongestionZone");
     jmethodID zoneConstructor = env->GetMethodID(zoneClass, "<init>", "(IIDDI)V");
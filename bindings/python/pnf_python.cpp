@@ -37,7 +37,9 @@ PYBIND11_MODULE(pypnf, m) {
         .value("Fixed", pnf::BoxSizeMethod::Fixed)
         .value("Traditional", pnf::BoxSizeMethod::Traditional)
         .value("Percentage", pnf::BoxSizeMethod::Percentage)
-        .value("Points", pnf::BoxSizeMethod::Points);
+        .value("Points", pnf::BoxSizeMethod::Points)
+        .value("ATR", pnf::BoxSizeMethod::ATR)
+        .value("Logarithmic", pnf::BoxSizeMethod::Logarithmic);
 
     py::enum_<pnf::SignalType>(m, "SignalType")
         .value("NONE", pnf::SignalType::None)
@@ -73,7 +75,11 @@ PYBIND11_MODULE(pypnf, m) {
         .def_readwrite("method", &pnf::ChartConfig::method)
         .def_readwrite("box_size_method", &pnf::ChartConfig::box_size_method)
         .def_readwrite("box_size", &pnf::ChartConfig::box_size)
-        .def_readwrite("reversal", &pnf::ChartConfig::reversal);
+        .def_readwrite("reversal", &pnf::ChartConfig::reversal)
+        .def_readwrite("atr_period", &pnf::ChartConfig::atr_period)
+        .def_readwrite("atr_refresh", &pnf::ChartConfig::atr_refresh)
+        .def_readwrite("compact_columns", &pnf::ChartConfig::compact_columns)
+        .def_readwrite("checkpoint_interval", &pnf::ChartConfig::checkpoint_interval);
 
     py::class_<pnf::IndicatorConfig>(m, "IndicatorConfig")
         .def(py::init<>())
@@ -164,10 +170,12 @@ PYBIND11_MODULE(pypnf, m) {
         .def("type", &pnf::Column::type)
         .def("highest_price", &pnf::Column::highest_price)
         .def("lowest_price", &pnf::Column::lowest_price)
-        .def("get_box_at",
-             static_cast<const pnf::Box* (pnf::Column::*)(size_t) const>(&pnf::Column::get_box_at),
-             py::return_value_policy::reference_internal)
+        .def("get_box_at", [](const pnf::Column& col, const size_t index) -> py::object {
+            if (index >= col.box_count()) return py::none();
+            return py::cast(col.box_at(index));
+        })
         .def("has_box", &pnf::Column::has_box)
+        .def("is_compact", &pnf::Column::is_compact)
         .def("__str__", &pnf::Column::to_string);
 
     py::class_<pnf::Chart>(m, "Chart")
@@ -193,24 +201,39 @@ PYBIND11_MODULE(pypnf, m) {
             const auto* col = c.column(i);
             return col ? col->lowest_price() : 0.0;
         })
+        .def("column_first_time", [](const pnf::Chart& c, size_t i) -> pnf::Timestamp {
+            const auto* col = c.column(i);
+            return col ? col->first_time() : pnf::Timestamp{};
+        })
+        .def("column_last_time", [](const pnf::Chart& c, size_t i) -> pnf::Timestamp {
+            const auto* col = c.column(i);
+            return col ? col->last_time() : pnf::Timestamp{};
+        })
+        .def("column_bar_count", [](const pnf::Chart& c, size_t i) -> size_t {
+            const auto* col = c.column(i);
+            return col ? col->bar_count() : 0;
+        })
+        .def("column_at", &pnf::Chart::column_at)
+        .def("as_of", &pnf::Chart::as_of)
+        .def("splice_data", &pnf::Chart::splice_data)
+        .def("bar_log_size", &pnf::Chart::bar_log_size)
+        .def("checkpoint_count", &pnf::Chart::checkpoint_count)
         .def("box_price", [](const pnf::Chart& c, size_t col_index, size_t box_index) -> double {
             const auto* col = c.column(col_index);
-            const auto* box = col ? col->get_box_at(box_index) : nullptr;
-            return box ? box->price() : 0.0;
+            return col && box_index < col->box_count() ? col->box_at(box_index).price() : 0.0;
         })
         .def("box_type", [](const pnf::Chart& c, size_t col_index, size_t box_index) -> pnf::BoxType {
             const auto* col = c.column(col_index);
-            const auto* box = col ? col->get_box_at(box_index) : nullptr;
-            return box ? box->type() : pnf::BoxType::X;
+            return col && box_index < col->box_count() ? col->box_at(box_index).type() : pnf::BoxType::X;
         })
         .def("box_marker", [](const pnf::Chart& c, size_t col_index, size_t box_index) -> std::string {
             const auto* col = c.column(col_index);
-            const auto* box = col ? col->get_box_at(box_index) : nullptr;
-            return box ? box->marker() : std::string{};
+            return col && box_index < col->box_count() ? col->box_at(box_index).marker() : std::string{};
         })
         .def("x_column_count", &pnf::Chart::x_column_count)
         .def("o_column_count", &pnf::Chart::o_column_count)
         .def("all_prices", &pnf::Chart::all_prices)
+        .def("price_row", &pnf::Chart::price_row)
         .def("current_box_size", &pnf::Chart::current_box_size)
         .def("has_bullish_bias", &pnf::Chart::has_bullish_bias)
         .def("has_bearish_bias", &pnf::Chart::has_bearish_bias)
@@ -33,6 +33,13 @@ def _enum_name(value: Any) -> str:
     return str(value)
 
 
+def _epoch_ms(value: Any) -> int:
+    try:
+        return int(value.timestamp() * 1000)
+    except (OverflowError, OSError, ValueError):
+        return 0
+
+
 def build_snapshot(chart: Any, indicators: Any | None = None, sequence: int = 1) -> dict[str, Any]:
     column_count = int(chart.column_count())
     columns = []
@@ -55,6 +62,9 @@ def build_snapshot(chart: Any, indicators: Any | None = None, sequence: int = 1)
                 "box_count": box_count,
                 "highest": float(chart.column_high(idx)),
                 "lowest": float(chart.column_low(idx)),
+                "bar_count": int(chart.column_bar_count(idx)),
+                "first_time": _epoch_ms(chart.column_first_time(idx)),
+                "last_time": _epoch_ms(chart.column_last_time(idx)),
                 "boxes": boxes,
             }
         )
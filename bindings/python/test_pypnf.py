@@ -317,6 +317,41 @@ class TestChartWithData:
             col_type = chart_with_data.column_type(last_idx)
             assert col_type in [pypnf.ColumnType.X, pypnf.ColumnType.O, pypnf.ColumnType.Mixed]
 
+    def test_column_timing(self, chart_with_data):
+        """Columns should record their bars and map times back to columns"""
+        from datetime import datetime
+        total = sum(chart_with_data.column_bar_count(i) for i in range(chart_with_data.column_count()))
+        assert total == 25
+        assert chart_with_data.column_first_time(0) <= chart_with_data.column_last_time(0)
+        last_idx = chart_with_data.column_count() - 1
+        assert chart_with_data.column_at(chart_with_data.column_last_time(last_idx)) == last_idx
+        assert chart_with_data.column_at(datetime(2000, 1, 1)) == -1
+
+    def test_checkpoints(self):
+        """as_of and splice_data should match a chart built from the same bars"""
+        from datetime import datetime, timedelta
+        config = pypnf.ChartConfig()
+        config.box_size = 1.0
+        config.box_size_method = pypnf.BoxSizeMethod.Fixed
+        config.checkpoint_interval = 5
+        chart = pypnf.Chart(config)
+        base_time = datetime(2024, 1, 1)
+        prices = [100, 103, 106, 102, 98, 101, 105, 109, 104, 99, 95, 100]
+        for i, price in enumerate(prices):
+            if i != 7:
+                chart.add_price(price, base_time + timedelta(days=i))
+        assert chart.splice_data(109, 109, 109, base_time + timedelta(days=7))
+        assert chart.bar_log_size() == len(prices)
+        assert chart.checkpoint_count() > 0
+
+        config.checkpoint_interval = 0
+        reference = pypnf.Chart(config)
+        for i, price in enumerate(prices[:8]):
+            reference.add_price(price, base_time + timedelta(days=i))
+        past = chart.as_of(base_time + timedelta(days=7))
+        assert past.column_count() == reference.column_count()
+        assert past.column_high(past.column_count() - 1) == reference.column_high(reference.column_count() - 1)
+
     def test_all_prices(self, chart_with_data):
         """Should return all price levels"""
         prices = chart_with_data.all_prices()
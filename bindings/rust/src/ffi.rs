@@ -48,6 +48,8 @@ pub enum PnfBoxSizeMethod {
     Traditional = 1,
     Percentage = 2,
     Points = 3,
+    Atr = 4,
+    Logarithmic = 5,
 }
 
 #[repr(C)]
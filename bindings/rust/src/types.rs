@@ -32,6 +32,8 @@ pub enum BoxSizeMethod {
     Traditional,
     Percentage,
     Points,
+    Atr,
+    Logarithmic,
 }
 
 #[derive(Debug, Clone, Copy, PartialEq, Eq)]
@@ -343,6 +345,8 @@ impl BoxSizeMethod {
             BoxSizeMethod::Traditional => ffi::PnfBoxSizeMethod::Traditional,
             BoxSizeMethod::Percentage => ffi::PnfBoxSizeMethod::Percentage,
             BoxSizeMethod::Points => ffi::PnfBoxSizeMethod::Points,
+            BoxSizeMethod::Atr => ffi::PnfBoxSizeMethod::Atr,
+            BoxSizeMethod::Logarithmic => ffi::PnfBoxSizeMethod::Logarithmic,
         }
     }
 
@@ -352,6 +356,8 @@ impl BoxSizeMethod {
             ffi::PnfBoxSizeMethod::Traditional => BoxSizeMethod::Traditional,
             ffi::PnfBoxSizeMethod::Percentage => BoxSizeMethod::Percentage,
             ffi::PnfBoxSizeMethod::Points => BoxSizeMethod::Points,
+            ffi::PnfBoxSizeMethod::Atr => BoxSizeMethod::Atr,
+            ffi::PnfBoxSizeMethod::Logarithmic => BoxSizeMethod::Logarithmic,
         }
     }
 }
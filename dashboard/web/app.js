@@ -509,6 +509,20 @@
     }
   }
 
+  function timelineLabel(value, max) {
+    const columns = state.currentChart && state.currentChart.columns ? state.currentChart.columns : [];
+    const column = columns[Number(value)];
+    const label = 'Column ' + value + ' / ' + max;
+    if (!column || !(Number(column.first_time) > 0)) {
+      return label;
+    }
+    const day = (ms) => new Date(Number(ms)).toISOString().slice(0, 10);
+    const first = day(column.first_time);
+    const last = Number(column.last_time) > 0 ? day(column.last_time) : first;
+    return label + ' · ' + (first === last ? first : first + ' → ' + last) +
+      (column.bar_count !== undefined ? ' · ' + column.bar_count + ' bars' : '');
+  }
+
   function syncTimeline(chart) {
     const max = Math.max(0, chart && chart.columns ? chart.columns.length - 1 : 0);
     suppressScrubber = true;
@@ -516,7 +530,7 @@
     if (Number(state.timelineScrubberEl.value) > max) {
       state.timelineScrubberEl.value = String(max);
     }
-    state.timelineLabelEl.textContent = 'Column ' + state.timelineScrubberEl.value + ' / ' + max;
+    state.timelineLabelEl.textContent = timelineLabel(state.timelineScrubberEl.value, max);
     suppressScrubber = false;
   }
 
@@ -534,7 +548,7 @@
     state.chartGridEl.scrollLeft += (cellRect.left - gridRect.left) - Math.max(40, gridRect.width * ratio);
     suppressScrubber = true;
     state.timelineScrubberEl.value = String(columnIndex);
-    state.timelineLabelEl.textContent = 'Column ' + columnIndex + ' / ' + state.timelineScrubberEl.max;
+    state.timelineLabelEl.textContent = timelineLabel(columnIndex, state.timelineScrubberEl.max);
     suppressScrubber = false;
     target.classList.add('flash-focus');
     window.setTimeout(() => target.classList.remove('flash-focus'), 900);
@@ -583,7 +597,7 @@
     const value = Math.min(max, approx);
     suppressScrubber = true;
     state.timelineScrubberEl.value = String(value);
-    state.timelineLabelEl.textContent = 'Column ' + value + ' / ' + max;
+    state.timelineLabelEl.textContent = timelineLabel(value, max);
     suppressScrubber = false;
   }
 
@@ -1037,7 +1051,7 @@
   state.timelineScrubberEl.addEventListener('input', function () {
     if (suppressScrubber) return;
     const value = Number(state.timelineScrubberEl.value || 0);
-    state.timelineLabelEl.textContent = 'Column ' + value + ' / ' + state.timelineScrubberEl.max;
+    state.timelineLabelEl.textContent = timelineLabel(value, state.timelineScrubberEl.max);
     scrollToColumn(value, 0.12);
   });
   state.jumpPrevSignalEl.addEventListener('click', function () { navigateEvents('signal', -1); });
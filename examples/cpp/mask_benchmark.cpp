@@ -0,0 +1,64 @@
+#include <pnf/pnf.hpp>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+using namespace pnf;
+
+namespace {
+    const char* level_name(const SimdLevel level) {
+        switch (level) {
+            case SimdLevel::AVX512: return "AVX-512";
+            case SimdLevel::AVX2: return "AVX2";
+            case SimdLevel::Scalar: break;
+        }
+        return "scalar";
+    }
+
+    template <typename F>
+    double time_ms(const int repeats, F&& body) {
+        const auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < repeats; r++) body();
+        const auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count() / repeats;
+    }
+}
+
+int main() {
+    constexpr size_t columns = 1 << 20;
+    constexpr int repeats = 50;
+
+    std::vector<double> prices(columns);
+    std::vector<double> upper(columns);
+    for (size_t i = 0; i < columns; i++) {
+        prices[i] = 100.0 + 10.0 * std::sin(static_cast<double>(i) * 0.013);
+        upper[i] = 105.0 + 3.0 * std::sin(static_cast<double>(i) * 0.007);
+    }
+
+    size_t scalar_hits = 0;
+    const double loop_ms = time_ms(repeats, [&] {
+        std::vector<bool> flags(columns);
+        for (size_t i = 0; i < columns; i++) flags[i] = prices[i] > upper[i];
+        scalar_hits = static_cast<size_t>(std::count(flags.begin(), flags.end(), true));
+    });
+
+    std::cout << "Columns: " << columns << "\n";
+    std::cout << std::fixed << std::setprecision(3)
+              << std::setw(10) << "loop" << "  " << loop_ms << " ms  "
+              << columns / loop_ms / 1000.0 << " M/s\n";
+
+    const SimdLevel saved = simd_level();
+    for (const SimdLevel level : {SimdLevel::Scalar, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if (set_simd_level(level) != level) continue;
+        size_t hits = 0;
+        const double ms = time_ms(repeats, [&] { hits = mask_greater(prices, upper).count(); });
+        std::cout << std::setw(10) << level_name(level) << "  " << ms << " ms  "
+                  << columns / ms / 1000.0 << " M/s  x" << loop_ms / ms
+                  << (hits == scalar_hits ? "" : "  MISMATCH") << "\n";
+    }
+    set_simd_level(saved);
+    return 0;
+}
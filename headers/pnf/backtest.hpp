@@ -0,0 +1,173 @@
+/// \file backtest.hpp
+/// \brief Event-driven backtesting on top of chart signals and patterns.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#ifndef BACKTEST_HPP
+#define BACKTEST_HPP
+
+#include "indicators.hpp"
+#include "thread_pool.hpp"
+#include <vector>
+#include <memory>
+
+namespace pnf {
+    /**
+     * @brief What opened a trade.
+     */
+    enum class TradeTrigger {
+        Signal,     /**< Double top / double bottom signal */
+        Pattern     /**< Bullish or bearish pattern */
+    };
+
+    /**
+     * @brief Why a trade was closed.
+     */
+    enum class TradeExitReason {
+        Target,         /**< Vertical-count price objective reached */
+        Stop,           /**< Protective stop hit */
+        OppositeSignal, /**< Opposite signal or pattern fired */
+        EndOfData       /**< Closed at the last bar */
+    };
+
+    /**
+     * @brief Entry and exit rules for a backtest.
+     */
+    struct BacktestConfig {
+        ChartConfig chart{};                    /**< Chart construction settings */
+        bool trade_signals = true;              /**< Enter on buy/sell signals */
+        bool trade_patterns = false;            /**< Enter on bullish/bearish patterns */
+        bool allow_short = false;               /**< Open short positions on bearish events */
+        bool require_trend_bias = true;         /**< Gate entries with should_take_bullish/bearish_signals() */
+        bool use_objective_targets = true;      /**< Exit at the entry column's vertical-count objective */
+        bool exit_on_opposite_signal = true;    /**< Exit when an opposite event fires */
+        int stop_boxes = 0;                     /**< Protective stop distance in boxes; 0 disables */
+        double quantity = 1.0;                  /**< Units per trade */
+        double slippage = 0.0;                  /**< Price units applied against every fill */
+        double commission = 0.0;                /**< Cost per fill */
+        double initial_equity = 0.0;            /**< Starting equity */
+    };
+
+    /**
+     * @brief A simulated round-trip trade.
+     */
+    struct Trade {
+        bool is_long = true;                                  /**< Long or short */
+        TradeTrigger trigger = TradeTrigger::Signal;          /**< Entry trigger */
+        PatternType pattern = PatternType::None;              /**< Pattern that opened the trade, None for signal entries */
+        TradeExitReason exit_reason = TradeExitReason::EndOfData; /**< Exit reason */
+        int entry_column = -1;                                /**< Chart column at entry */
+        size_t entry_bar = 0;                                 /**< Bar index of the entry fill */
+        size_t exit_bar = 0;                                  /**< Bar index of the exit fill */
+        Timestamp entry_time{};                               /**< Entry bar time */
+        Timestamp exit_time{};                                /**< Exit bar time */
+        double entry_price = 0.0;                             /**< Entry fill including slippage */
+        double exit_price = 0.0;                              /**< Exit fill including slippage */
+        double target_price = 0.0;                            /**< Objective target; 0 when unused */
+        double stop_price = 0.0;                              /**< Stop level; 0 when unused */
+        double pnl = 0.0;                                     /**< Profit net of commissions */
+    };
+
+    /**
+     * @brief Output of a backtest run.
+     */
+    struct BacktestResult {
+        std::vector<Trade> trades{};    /**< Closed trades in exit order */
+        std::vector<double> equity{};   /**< Marked-to-market equity after each bar; an open position carries its entry commission only */
+        double net_profit = 0.0;        /**< Sum of trade pnl */
+        double max_drawdown = 0.0;      /**< Largest peak-to-trough equity decline */
+        int winning_trades = 0;         /**< Trades with pnl > 0 */
+        int losing_trades = 0;          /**< Trades with pnl <= 0 */
+        double win_rate = 0.0;          /**< winning_trades / trades, 0 when none */
+    };
+
+    /**
+     * @brief Replays bars into a Chart and simulates trades.
+     *
+     * Rules are evaluated incrementally: only when a bar changes the chart
+     * structure are the signal and pattern checks run, and only against the
+     * last column. Each column can open at most one trade. Targets and stops
+     * are checked against the next bars' high/low before the chart is
+     * updated, so an entry never fills and exits on the same bar.
+     *
+     * Commission is charged per fill: a closed trade pays it twice, while
+     * the equity curve charges an open position for its entry fill only and
+     * adds the exit commission once the position closes.
+     *
+     * Patterns are detected incrementally across columns with
+     * PatternRecognizer::detect_from, so patterns that depend on earlier
+     * columns (catapults) fire exactly as PatternRecognizer::detect would.
+     */
+    class Backtester {
+    public:
+        explicit Backtester(const BacktestConfig& config = {});
+
+        /**
+         * @brief Discards the chart, open position, and results.
+         */
+        void reset();
+
+        /**
+         * @brief Processes one bar.
+         *
+         * @param bar Next bar in time order
+         */
+        void on_bar(const OHLC& bar);
+
+        /**
+         * @brief Closes any open position at the last processed close.
+         */
+        void finish();
+
+        /**
+         * @brief Runs a full backtest from a clean state.
+         *
+         * @param bars Bars in time order
+         * @return Trades and equity curve
+         */
+        BacktestResult run(const std::vector<OHLC>& bars);
+
+        /**
+         * @brief Runs the same rules over many instruments in parallel.
+         *
+         * @param instruments One bar series per instrument
+         * @param config Backtest rules
+         * @param pool Pool to run on
+         * @return One result per instrument, in input order
+         */
+        static std::vector<BacktestResult> run_many(const std::vector<std::vector<OHLC>>& instruments,
+                                                    const BacktestConfig& config, ThreadPool& pool);
+
+        [[nodiscard]] const BacktestResult& result() const { return result_; }
+        [[nodiscard]] const Chart& chart() const { return *chart_; }
+        [[nodiscard]] bool in_position() const { return in_position_; }
+        [[nodiscard]] const Trade& open_trade() const { return open_trade_; }
+        [[nodiscard]] const BacktestConfig& config() const { return config_; }
+        void set_config(const BacktestConfig& config);
+
+    private:
+        void check_exits(const OHLC& bar);
+        void evaluate_entries(const OHLC& bar);
+        void open_position(bool is_long, TradeTrigger trigger, PatternType pattern, const OHLC& bar, int column);
+        void close_position(double price, TradeExitReason reason, size_t bar_index, Timestamp time);
+        void mark_to_market(double close);
+
+        BacktestConfig config_;                 /**< Rules */
+        std::unique_ptr<Chart> chart_;          /**< Chart being replayed */
+        PatternRecognizer recognizer_;          /**< Patterns found so far, re-evaluated for the last column */
+        BacktestResult result_;                 /**< Accumulated results */
+        Trade open_trade_;                      /**< Current position, valid when in_position_ */
+        bool in_position_ = false;              /**< Whether a position is open */
+        double realized_ = 0.0;                 /**< Realized pnl */
+        double peak_equity_ = 0.0;              /**< Running equity peak */
+        int last_entry_column_ = -1;            /**< Column that last opened a trade */
+        size_t seen_columns_ = 0;               /**< Column count at last evaluation */
+        size_t seen_boxes_ = 0;                 /**< Last column box count at last evaluation */
+        size_t bar_index_ = 0;                  /**< Bars processed */
+        OHLC last_bar_{};                       /**< Last processed bar */
+    };
+} // namespace pnf
+
+#endif //BACKTEST_HPP
@@ -9,11 +9,15 @@
 #define BOX_HPP
 
 #include "types.hpp"
+#include "marker.hpp"
 
 namespace pnf {
 
     /**
      * @brief Represents a type of box with a price, type, and optional marker.
+     *
+     * The marker is held as a MarkerId into MarkerTable, so a box is a price,
+     * a type, and a 16-bit ID.
      */
     class Box {
     public:
@@ -24,7 +28,16 @@ namespace pnf {
          * @param type The type of the box (BoxType enum expected).
          * @param marker An optional string marker for the box. Defaults to an empty string.
          */
-        Box(double price, BoxType type, std::string marker = "");
+        Box(double price, BoxType type, std::string_view marker = {});
+
+        /**
+         * @brief Constructs a new Box object with an interned marker.
+         *
+         * @param price The price of the box.
+         * @param type The type of the box.
+         * @param marker Marker ID from MarkerTable.
+         */
+        Box(double price, BoxType type, MarkerId marker);
 
         /**
          * @brief Gets the price of the box.
@@ -45,14 +58,28 @@ namespace pnf {
          *
          * @return A constant reference to the marker string.
          */
-        const std::string& marker() const { return marker_; }
+        const std::string& marker() const { return MarkerTable::name(marker_); }
+
+        /**
+         * @brief Gets the interned marker ID of the box.
+         *
+         * @return MarkerId, MarkerTable::none if the box has no marker.
+         */
+        MarkerId marker_id() const { return marker_; }
 
         /**
          * @brief Sets the marker string of the box.
          *
          * @param marker The new marker string.
          */
-        void set_marker(std::string marker) { marker_ = std::move(marker); }
+        void set_marker(std::string_view marker) { marker_ = MarkerTable::intern(marker); }
+
+        /**
+         * @brief Sets the marker of the box by ID.
+         *
+         * @param marker Marker ID from MarkerTable.
+         */
+        void set_marker_id(MarkerId marker) { marker_ = marker; }
 
         /**
          * @brief Sets the type of the box.
@@ -71,7 +98,7 @@ namespace pnf {
     private:
         double price_;          /**< Price of the box */
         BoxType type_;          /**< Type of the box */
-        std::string marker_;    /**< Optional marker for the box */
+        MarkerId marker_;       /**< Interned marker, MarkerTable::none if unset */
     };
 
 } // namespace pnf
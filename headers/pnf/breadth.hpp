@@ -0,0 +1,168 @@
+/// \file breadth.hpp
+/// \brief Universe-level market breadth indicators.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#ifndef BREADTH_HPP
+#define BREADTH_HPP
+
+#include "indicators.hpp"
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <memory>
+
+namespace pnf {
+    /**
+     * @brief Bullish percent breakdown for one sector.
+     */
+    struct SectorBreadth {
+        std::string sector{};   /**< Sector name */
+        int symbols{};          /**< Symbols tracked in the sector */
+        int buy_signals{};      /**< Symbols whose last signal is Buy */
+        int sell_signals{};     /**< Symbols whose last signal is Sell */
+        double value{};         /**< Bullish percent for the sector */
+    };
+
+    /**
+     * @brief Bullish Percent Index across a universe of symbols.
+     *
+     * Keeps the last signal per symbol and running buy/sell counters, so an
+     * update costs O(1) and a refresh costs O(changed symbols). The index is
+     * the percentage of symbols on a buy signal among those that have given a
+     * signal (50 when none have). publish() feeds the current value into the
+     * index's own Point & Figure chart.
+     */
+    class UniverseBullishPercent {
+    public:
+        /**
+         * @brief Creates an empty universe.
+         *
+         * @param chart_config Configuration for the BPI chart (default: 2-point boxes, 3-box reversal)
+         */
+        explicit UniverseBullishPercent(const ChartConfig& chart_config = default_chart_config());
+
+        /**
+         * @brief Registers a symbol, or moves it to another sector.
+         *
+         * @param symbol Symbol name
+         * @param sector Sector name; empty for none
+         */
+        void add_symbol(const std::string& symbol, const std::string& sector = "");
+
+        /**
+         * @brief Removes a symbol from the universe.
+         *
+         * @param symbol Symbol name
+         * @return true if the symbol was tracked
+         */
+        bool remove_symbol(const std::string& symbol);
+
+        /**
+         * @brief Records a symbol's latest signal state.
+         *
+         * Unknown symbols are registered without a sector.
+         *
+         * @param symbol Symbol name
+         * @param signal Latest signal (None leaves the symbol unclassified)
+         * @return true if the symbol's state changed
+         */
+        bool update(const std::string& symbol, SignalType signal);
+
+        /**
+         * @brief Records a symbol's state from its signal detector.
+         *
+         * @param symbol Symbol name
+         * @param detector Detector that has run on the symbol's chart
+         * @return true if the symbol's state changed
+         */
+        bool update(const std::string& symbol, const SignalDetector& detector);
+
+        /**
+         * @brief Records a symbol's state from its chart.
+         *
+         * Walks back from the last column to the most recent signal, so the
+         * cost is proportional to the distance to that signal rather than the
+         * chart length.
+         *
+         * @param symbol Symbol name
+         * @param chart Symbol's chart
+         * @return true if the symbol's state changed
+         */
+        bool update(const std::string& symbol, const Chart& chart);
+
+        /**
+         * @brief Appends the current value to the BPI chart.
+         *
+         * @param time Timestamp of the snapshot
+         * @return true if the BPI chart changed
+         */
+        bool publish(Timestamp time);
+
+        /**
+         * @brief Returns the most recent signal of a chart.
+         *
+         * @param chart Chart to inspect
+         * @return Last Buy/Sell signal, or None
+         */
+        [[nodiscard]] static SignalType latest_signal(const Chart& chart);
+
+        [[nodiscard]] double value() const;
+        [[nodiscard]] double sector_value(const std::string& sector) const;
+        [[nodiscard]] std::vector<SectorBreadth> sectors() const;
+        [[nodiscard]] SignalType signal(const std::string& symbol) const;
+        [[nodiscard]] bool has_symbol(const std::string& symbol) const;
+        [[nodiscard]] size_t symbol_count() const { return symbols_.size(); }
+        [[nodiscard]] int buy_count() const { return buy_count_; }
+        [[nodiscard]] int sell_count() const { return sell_count_; }
+
+        void set_thresholds(double bullish, double bearish);
+        [[nodiscard]] bool is_bullish_alert() const { return value() > bullish_threshold_; }
+        [[nodiscard]] bool is_bearish_alert() const { return value() < bearish_threshold_; }
+
+        [[nodiscard]] const Chart& chart() const { return *chart_; }
+        [[nodiscard]] SignalType chart_signal() const;
+
+        void clear();
+        [[nodiscard]] std::string to_string() const;
+
+        [[nodiscard]] static ChartConfig default_chart_config();
+
+    private:
+        /**
+         * @brief Running counters for one sector.
+         */
+        struct SectorCounts {
+            std::string name{};     /**< Sector name */
+            int symbols = 0;        /**< Symbols in the sector */
+            int buy = 0;            /**< Symbols on a buy signal */
+            int sell = 0;           /**< Symbols on a sell signal */
+        };
+
+        /**
+         * @brief Per-symbol state.
+         */
+        struct SymbolState {
+            SignalType signal = SignalType::None;   /**< Last recorded signal */
+            size_t sector = 0;                      /**< Index into sectors_ */
+        };
+
+        size_t sector_slot(const std::string& sector);
+        void apply(const SymbolState& state, int direction);
+        static double percent(int buy, int sell);
+
+        std::unordered_map<std::string, SymbolState> symbols_;  /**< Symbol state */
+        std::unordered_map<std::string, size_t> sector_index_;  /**< Sector name to slot */
+        std::vector<SectorCounts> sectors_;                     /**< Sector counters; slot 0 is unassigned */
+        int buy_count_ = 0;                                     /**< Symbols on a buy signal */
+        int sell_count_ = 0;                                    /**< Symbols on a sell signal */
+        ChartConfig chart_config_;                              /**< BPI chart configuration */
+        std::unique_ptr<Chart> chart_;                          /**< BPI Point & Figure chart */
+        double bullish_threshold_ = 70.0;                       /**< Overbought level */
+        double bearish_threshold_ = 30.0;                       /**< Oversold level */
+    };
+} // namespace pnf
+
+#endif //BREADTH_HPP
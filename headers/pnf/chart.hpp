@@ -9,9 +9,14 @@
 #define CHART_HPP
 
 #include "column.hpp"
+#include "mask.hpp"
 #include "trendline.hpp"
+#include "log_grid.hpp"
+#include <cstdint>
+#include <span>
 #include <vector>
 #include <memory>
+#include <memory_resource>
 #include <chrono>
 #include <array>
 
@@ -22,8 +27,12 @@ namespace pnf {
     struct ChartConfig {
         ConstructionMethod method = ConstructionMethod::Close; /**< Chart construction method */
         BoxSizeMethod box_size_method = BoxSizeMethod::Traditional; /**< Method to determine box size */
-        double box_size = 0.0; /**< Fixed box size (if applicable) */
+        double box_size = 0.0; /**< Fixed box size, percentage (Percentage/Logarithmic), or ATR multiple (if applicable) */
         int reversal = 3; /**< Reversal amount in boxes */
+        int atr_period = 14; /**< ATR lookback in bars (ATR box size only) */
+        int atr_refresh = 0; /**< Bars between ATR box size refreshes; 0 keeps the first ATR box (ATR box size only) */
+        bool compact_columns = false; /**< Compact each column once a reversal finishes it (see Column::compact) */
+        int checkpoint_interval = 0; /**< Bars between state checkpoints; 0 keeps no bar log (see Chart::as_of) */
     };
 
     /**
@@ -37,9 +46,15 @@ namespace pnf {
         /**
          * @brief Constructs a new Chart object with optional configuration.
          *
+         * Columns, their boxes, and the ATR bar log are allocated from the given
+         * memory resource, so a chart can live in a monotonic or pooled arena
+         * and its memory can be measured by wrapping the resource.
+         *
          * @param config ChartConfig structure with settings (optional)
+         * @param resource Memory resource for chart storage; nullptr uses the default resource
          */
-        explicit Chart(const ChartConfig& config = {});
+        explicit Chart(const ChartConfig& config = {},
+                       std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
         /**
          * @brief Adds a data point using high, low, and close prices.
@@ -79,6 +94,9 @@ namespace pnf {
         /**
          * @brief Returns a pointer to a column at a given index.
          *
+         * Columns are stored by value, so the pointer is invalidated when a new
+         * column is added.
+         *
          * @param index Column index
          * @return Pointer to Column or nullptr if out of range
          */
@@ -98,50 +116,85 @@ namespace pnf {
          *
          * @return Number of X columns
          */
-        size_t x_column_count() const;
+        size_t x_column_count() const { return x_columns_.size(); }
 
         /**
          * @brief Counts O-type columns.
          *
          * @return Number of O columns
          */
-        size_t o_column_count() const;
+        size_t o_column_count() const { return o_columns_.size(); }
 
         /**
          * @brief Counts mixed-type columns.
          *
          * @return Number of mixed columns
          */
-        size_t mixed_column_count() const;
+        size_t mixed_column_count() const { return mixed_columns_.size(); }
 
         /**
          * @brief Returns indices of X columns.
          *
-         * @return Vector of X column indices
+         * @return X column indices in ascending order
          */
-        std::vector<size_t> x_column_indices() const;
+        std::span<const size_t> x_column_indices() const { return x_columns_; }
 
         /**
          * @brief Returns indices of O columns.
          *
-         * @return Vector of O column indices
+         * @return O column indices in ascending order
          */
-        std::vector<size_t> o_column_indices() const;
+        std::span<const size_t> o_column_indices() const { return o_columns_; }
 
         /**
          * @brief Returns indices of mixed columns.
          *
-         * @return Vector of mixed column indices
+         * @return Mixed column indices in ascending order
+         */
+        std::span<const size_t> mixed_column_indices() const { return mixed_columns_; }
+
+        /**
+         * @brief Finds the nearest earlier column of the same type.
+         *
+         * @param index Column index
+         * @return Index of the previous X column for an X column (O for O,
+         *         mixed for mixed), or -1 if there is none
          */
-        std::vector<size_t> mixed_column_indices() const;
+        int previous_same_type(size_t index) const {
+            return index < previous_same_type_.size() ? previous_same_type_[index] : -1;
+        }
 
         /**
          * @brief Returns all prices from all boxes in the chart.
          *
-         * @return Vector of prices
+         * Copies price_ladder(); use that when a view is enough.
+         *
+         * @return Vector of prices, highest first
          */
         std::vector<double> all_prices() const;
 
+        /**
+         * @brief Returns the distinct box prices of the chart, highest first.
+         *
+         * The ladder is kept sorted as boxes are added, so this is the
+         * allocation-free form of all_prices(). New highs and lows are
+         * amortised O(1); a price between existing ones shifts the ladder.
+         *
+         * @return Price ladder
+         */
+        std::span<const double> price_ladder() const { return std::span(price_ladder_).subspan(ladder_front_); }
+
+        /**
+         * @brief Maps a price to its row in price_ladder().
+         *
+         * O(1) for Fixed, Points and Logarithmic box sizes, whose ladder has
+         * no gaps; a binary search otherwise.
+         *
+         * @param price Box price
+         * @return Row index (0 = highest), or -1 if no box sits at that price
+         */
+        int price_row(double price) const;
+
         /**
          * @brief Returns the chart configuration.
          *
@@ -156,6 +209,38 @@ namespace pnf {
          */
         double current_box_size() const { return last_box_size_; }
 
+        /**
+         * @brief Returns the Traditional scale box size for a price.
+         *
+         * Stateless bracket lookup; the chart only calls it when a price
+         * leaves the bracket it last resolved.
+         *
+         * @param price Reference price
+         * @return Box size in price units
+         */
+        static double traditional_box_size(double price);
+
+        /**
+         * @brief Returns the streaming Wilder ATR of the input bars.
+         *
+         * Only maintained for BoxSizeMethod::ATR; 0 until atr_period bars have been seen.
+         *
+         * @return Average true range in price units
+         */
+        double atr() const { return atr_; }
+
+        /**
+         * @brief Returns the logarithmic box grid.
+         *
+         * Box prices of a Logarithmic chart are grid levels, so
+         * floor_index(box price) is a stable row index across columns.
+         *
+         * @return Grid pointer, or nullptr unless BoxSizeMethod::Logarithmic
+         */
+        const LogBoxGrid* log_grid() const {
+            return config_.box_size_method == BoxSizeMethod::Logarithmic ? &log_grid_ : nullptr;
+        }
+
         /**
          * @brief Returns the trend line manager.
          *
@@ -222,9 +307,153 @@ namespace pnf {
         /**
          * @brief Returns all columns in the chart.
          *
-         * @return Vector of unique pointers to columns
+         * @return Column storage
+         */
+        const ColumnList& columns() const { return columns_; }
+
+        /**
+         * @brief Returns the memory resource chart storage is allocated from.
+         *
+         * @return Memory resource
+         */
+        std::pmr::memory_resource* memory_resource() const { return columns_.get_allocator().resource(); }
+
+        /**
+         * @brief Returns the highest price of every column, indexed like columns().
+         *
+         * The column arrays are updated as bars are added, so indicator and
+         * render passes can stream over dense doubles.
+         *
+         * @return Column highs (0 for an empty column)
+         */
+        const std::pmr::vector<double>& column_highs() const { return column_highs_; }
+
+        /**
+         * @brief Returns the lowest price of every column, indexed like columns().
+         *
+         * @return Column lows (0 for an empty column)
+         */
+        const std::pmr::vector<double>& column_lows() const { return column_lows_; }
+
+        /**
+         * @brief Returns (high + low) / 2 of every column, indexed like columns().
+         *
+         * @return Column midpoints
+         */
+        const std::pmr::vector<double>& column_midpoints() const { return column_midpoints_; }
+
+        /**
+         * @brief Returns the first bar time of every column, indexed like columns().
+         *
+         * Non-decreasing as long as bars are added in time order.
+         *
+         * @return Column start times
+         */
+        const std::pmr::vector<Timestamp>& column_start_times() const { return column_start_times_; }
+
+        /**
+         * @brief Finds the column that was being drawn at a point in time.
+         *
+         * Binary search over column_start_times(); assumes bars arrive in
+         * time order.
+         *
+         * @param time Point in time
+         * @return Index of the last column started at or before time, or -1
+         *         if time precedes the first column
+         */
+        int column_at(Timestamp time) const;
+
+        /**
+         * @brief Returns the highest price over all columns.
+         *
+         * @return Chart high, 0 if the chart is empty
+         */
+        double highest_price() const { return series_max(column_highs_); }
+
+        /**
+         * @brief Returns the lowest price over all columns.
+         *
+         * @return Chart low, 0 if the chart is empty
+         */
+        double lowest_price() const { return series_min(column_lows_); }
+
+        /**
+         * @brief Rebuilds the column arrays after columns were edited through column().
+         */
+        void refresh_column_extremes();
+
+        /**
+         * @brief Counts rewrites of existing columns.
+         *
+         * Bumped by clear(), ATR re-projection, refresh_column_extremes() and
+         * splice_data().
+         * Between bumps only the last column grows and new columns are
+         * appended, which is what incremental consumers such as
+         * Indicators::update() rely on.
+         *
+         * @return Rewrite count
+         */
+        std::uint64_t rebuild_count() const { return rebuilds_; }
+
+        /**
+         * @brief Returns the number of bars kept for replay.
+         *
+         * Bars are only logged when ChartConfig::checkpoint_interval is set.
+         *
+         * @return Logged bar count
          */
-        const std::vector<std::unique_ptr<Column>>& columns() const { return columns_; }
+        size_t bar_log_size() const { return bar_log_.size(); }
+
+        /**
+         * @brief Returns the number of checkpoints currently held.
+         *
+         * A checkpoint is taken every checkpoint_interval logged bars. ATR
+         * re-projection, refresh_column_extremes() and clear() discard them,
+         * since they rewrite columns the checkpoints refer to.
+         *
+         * @return Checkpoint count
+         */
+        size_t checkpoint_count() const { return checkpoints_.size(); }
+
+        /**
+         * @brief Rebuilds the chart as it stood after the last bar at or before a time.
+         *
+         * Restores the nearest checkpoint at or before that bar and replays
+         * the logged bars after it, so the cost is one copy of the columns up
+         * to the checkpoint plus at most checkpoint_interval bars. Without
+         * a checkpoint the whole log is replayed. The returned chart shares
+         * this chart's memory resource and keeps the bar log and checkpoints
+         * up to the time, so it can itself be extended or spliced.
+         *
+         * @param time Point in time
+         * @return Chart as of time; empty if no bars were logged by then
+         */
+        Chart as_of(Timestamp time) const;
+
+        /**
+         * @brief Inserts a late bar or replaces the logged bar with the same time.
+         *
+         * The chart rolls back to the nearest checkpoint before the bar and
+         * replays the log from there. Columns before the checkpoint's last
+         * column are left untouched; the rest are rewritten, so
+         * rebuild_count() is bumped. Requires checkpoint_interval > 0.
+         *
+         * @param high High price
+         * @param low Low price
+         * @param close Close price
+         * @param time Bar time
+         * @return true if any column from the checkpoint on now has different
+         *         extremes or the column count changed; false if nothing changed
+         *         or checkpointing is off
+         */
+        bool splice_data(double high, double low, double close, Timestamp time);
+
+        /**
+         * @brief Counts the bars replayed by the last as_of() or splice_data() that produced this chart.
+         *
+         * @return Replayed bar count
+         */
+        size_t replayed_bars() const { return replayed_; }
 
     private:
         /**
@@ -233,18 +462,27 @@ namespace pnf {
          * @param high High price
          * @param low Low price
          * @param time Timestamp
+         * @param key Month key of time
          * @return true if chart updated
          */
-        bool process_high_low(double high, double low, Timestamp time);
+        bool process_high_low(double high, double low, Timestamp time, int key);
 
         /**
          * @brief Processes closing price for chart updates.
          *
          * @param close Closing price
          * @param time Timestamp
+         * @param key Month key of time
          * @return true if chart updated
          */
-        bool process_close(double close, Timestamp time);
+        bool process_close(double close, Timestamp time, int key);
+
+        /**
+         * @brief Appends a new column, compacting the one it finishes when enabled.
+         *
+         * @param col Column to append
+         */
+        void push_column(Column&& col);
 
         /**
          * @brief Calculates appropriate box size for a price.
@@ -263,6 +501,18 @@ namespace pnf {
          */
         double round_to_box_size(double price, bool round_up);
 
+        /**
+         * @brief Moves a grid price by a number of boxes.
+         *
+         * Linear methods add boxes * box; Logarithmic steps along the level table.
+         *
+         * @param price Price on the chart's grid
+         * @param box Linear box size
+         * @param boxes Number of boxes, negative to move down
+         * @return Offset price
+         */
+        double offset_price(double price, double box, int boxes);
+
         /**
          * @brief Checks if a price triggers a reversal.
          *
@@ -274,41 +524,265 @@ namespace pnf {
         bool is_reversal(double price, const Column* current, BoxType& new_type);
 
         /**
-         * @brief Returns a marker string for a month number.
+         * @brief Decodes a timestamp into a comparable local year/month key.
+         *
+         * @param time Timestamp
+         * @return year * 12 + month index
+         */
+        static int month_key(Timestamp time);
+
+        /**
+         * @brief Returns the month marker if the month differs from the last processed bar.
          *
-         * @param month Month index (1-12)
-         * @return Marker string
+         * @param key Month key of the current bar
+         * @return Interned month marker, MarkerTable::none if the month is unchanged
          */
-        static std::string get_month_marker(int month);
+        MarkerId month_marker_for(int key) const;
 
         /**
-         * @brief Checks if the month has changed since the last processed time.
+         * @brief Adds a data point whose month key has already been decoded.
          *
-         * @param current Current timestamp
-         * @param marker Output month marker
-         * @return true if month changed
+         * @param high High price
+         * @param low Low price
+         * @param close Close price
+         * @param time Timestamp
+         * @param key Month key of time
+         * @return true if the chart was updated
          */
-        bool has_month_changed(Timestamp current, std::string& marker) const;
+        bool add_data(double high, double low, double close, Timestamp time, int key);
 
         /**
-         * @brief Returns the month marker for a given timestamp.
+         * @brief Routes a bar for an ATR-sized chart.
          *
+         * Bars are fed to the streaming ATR. Nothing is drawn until the ATR is
+         * seeded; after that, when a scheduled refresh changes the box size, the
+         * bars since the previous refresh are re-projected at the new size.
+         *
+         * @param high High price
+         * @param low Low price
+         * @param close Close price
          * @param time Timestamp
-         * @return Month marker string
+         * @param key Month key of time
+         * @return true if the chart was updated
+         */
+        bool process_atr(double high, double low, double close, Timestamp time, int key);
+
+        /**
+         * @brief Redraws the ATR bar log at the current ATR box size.
+         *
+         * Rewinds to the state saved at the previous refresh and replays the
+         * bars since then, so the cost is bounded by atr_refresh rather than
+         * the chart's history. Before seeding the chart is drawn from scratch.
+         *
+         * @return true if the chart has any columns afterwards
          */
-        std::string get_month_marker_for_data(Timestamp time) const;
+        bool reproject();
 
-        std::vector<std::unique_ptr<Column>> columns_; /**< Chart columns */
+        /**
+         * @brief Processes one bar with the configured construction method.
+         *
+         * @param high High price
+         * @param low Low price
+         * @param close Close price
+         * @param time Timestamp
+         * @param key Month key of time
+         * @return true if the chart was updated
+         */
+        bool construct(double high, double low, double close, Timestamp time, int key);
+
+        /**
+         * @brief Brings the column arrays, price ladder, type indexes and start
+         * times up to date after construction.
+         *
+         * Only the last column can grow, so entries before it are kept.
+         */
+        void update_column_extremes();
+
+        /**
+         * @brief Counts a box at a ladder price, adding the price if it is new.
+         *
+         * @param price Box price
+         */
+        void add_ladder_price(double price);
+
+        /**
+         * @brief Uncounts a box at a ladder price, removing the price once no box uses it.
+         *
+         * @param price Box price
+         */
+        void release_ladder_price(double price);
+
+        /**
+         * @brief Makes room before the highest ladder price.
+         */
+        void grow_ladder_front();
+
+        /**
+         * @brief Cuts the column arrays, ladder and type indexes back to the first columns.
+         *
+         * Only the dropped columns are visited, so the cost does not depend
+         * on how many columns are kept.
+         *
+         * @param columns Columns the arrays currently describe
+         * @param kept Number of columns to keep
+         */
+        void truncate_column_arrays(const ColumnList& columns, size_t kept);
+
+        /**
+         * @brief Records a bar known not to change any column.
+         *
+         * @param high High price
+         * @param low Low price
+         * @param close Close price
+         * @param time Timestamp
+         * @param key Month key of time
+         */
+        void skip_data(double high, double low, double close, Timestamp time, int key);
+
+        /**
+         * @brief Appends a processed bar to the log and takes a checkpoint when one is due.
+         *
+         * No-op unless checkpoint_interval is set.
+         *
+         * @param high High price
+         * @param low Low price
+         * @param close Close price
+         * @param time Timestamp
+         * @param key Month key of time
+         */
+        void log_bar(double high, double low, double close, Timestamp time, int key);
+
+        /**
+         * @brief Clears the per-column arrays, ladder and type indexes.
+         */
+        void reset_column_arrays();
+
+        /**
+         * @brief Finds the last checkpoint covering no more than a number of logged bars.
+         *
+         * @param bars Logged bar count
+         * @return Checkpoint index, or -1 if there is none
+         */
+        int checkpoint_before(size_t bars) const;
+
+        /**
+         * @brief Saves the state at an ATR refresh and empties the ATR bar log.
+         */
+        void mark_atr_base();
+
+        /**
+         * @brief Rolls this chart back to a checkpoint and cuts the log to match.
+         *
+         * @param source Chart holding the columns the checkpoint refers to
+         * @param index Checkpoint index in source
+         */
+        void restore(const Chart& source, size_t index);
+
+        friend class ChartFamily;
+
+        ColumnList columns_; /**< Chart columns */
         std::unique_ptr<TrendLineManager> trend_manager_; /**< Trend line manager */
         ChartConfig config_; /**< Chart configuration */
         Timestamp last_time_; /**< Last timestamp added */
         Timestamp last_processed_time_; /**< Last processed timestamp */
-        int last_month_; /**< Last month number processed */
+        int last_month_; /**< Month key of the last processed timestamp */
         double last_box_size_; /**< Last computed box size in price units */
+        LogBoxGrid log_grid_; /**< Level table (Logarithmic box size only) */
+        int bracket_ = -1; /**< Traditional bracket last resolved, -1 if none */
+
+        /**
+         * @brief Input bar retained for ATR re-projection and checkpoint replay.
+         */
+        struct LoggedBar {
+            double high;        /**< High price */
+            double low;         /**< Low price */
+            double close;       /**< Close price */
+            Timestamp time;     /**< Bar time */
+            int key;            /**< Pre-decoded month key */
+        };
+
+        std::pmr::vector<LoggedBar> atr_bars_; /**< Bars since the last refresh, kept for re-projection (ATR box size only) */
+        double atr_ = 0.0; /**< Wilder ATR, 0 until seeded */
+        double atr_sum_ = 0.0; /**< Sum of true ranges while seeding */
+        int atr_samples_ = 0; /**< True ranges seen, capped at atr_period */
+        double atr_prev_close_ = 0.0; /**< Previous close for true range */
+        double atr_box_ = 0.0; /**< Box size in use, 0 until seeded */
+        int atr_since_refresh_ = 0; /**< Bars since the last ATR box refresh */
+        std::pmr::vector<double> column_highs_; /**< Highest price per column */
+        std::pmr::vector<double> column_lows_; /**< Lowest price per column */
+        std::pmr::vector<double> column_midpoints_; /**< Midpoint per column */
+        std::uint64_t rebuilds_ = 0; /**< Rewrites of existing columns */
+        std::pmr::vector<double> price_ladder_; /**< Distinct box prices, highest first, from ladder_front_ on */
+        std::pmr::vector<std::uint32_t> ladder_refs_; /**< Boxes at each ladder price */
+        size_t ladder_front_ = 0; /**< Free slots before the highest price */
+        size_t ladder_boxes_ = 0; /**< Boxes of the last column already in the ladder */
+        std::pmr::vector<size_t> x_columns_; /**< Indices of X columns */
+        std::pmr::vector<size_t> o_columns_; /**< Indices of O columns */
+        std::pmr::vector<size_t> mixed_columns_; /**< Indices of mixed columns */
+        std::pmr::vector<int> previous_same_type_; /**< Previous column of the same type, -1 if none */
+        std::pmr::vector<Timestamp> column_start_times_; /**< First bar time per column */
+
+        /**
+         * @brief Chart state after a number of logged bars.
+         *
+         * Columns before the last one are final, so only their count is kept;
+         * the last column is copied into checkpoint_columns_ because later bars
+         * may still extend it.
+         */
+        struct Checkpoint {
+            size_t bars;                    /**< Logged bars covered */
+            size_t columns;                 /**< Column count */
+            TrendLineCheckpoint trend;      /**< Trend line state */
+            Timestamp last_time;            /**< Last timestamp added */
+            Timestamp last_processed_time;  /**< Last processed timestamp */
+            int last_month;                 /**< Month key of the last processed timestamp */
+            double last_box_size;           /**< Last computed box size */
+            int bracket;                    /**< Traditional bracket last resolved */
+            double atr;                     /**< Wilder ATR */
+            double atr_sum;                 /**< Sum of true ranges while seeding */
+            int atr_samples;                /**< True ranges seen */
+            double atr_prev_close;          /**< Previous close for true range */
+            double atr_box;                 /**< Box size in use */
+            int atr_since_refresh;          /**< Bars since the last ATR box refresh */
+            size_t atr_bars;                /**< Length of the ATR bar log */
+            size_t atr_bases;               /**< ATR refresh states held */
+        };
+
+        /**
+         * @brief Captures the current state; the last column is saved separately.
+         *
+         * @return Checkpoint for the bars logged so far
+         */
+        Checkpoint snapshot() const;
+
+        /**
+         * @brief Appends a copy of the last column, or an empty column if there is none.
+         *
+         * @param columns List to append to
+         */
+        void save_last_column(ColumnList& columns) const;
+
+        /**
+         * @brief Discards every checkpoint and the ATR refresh states only they refer to.
+         */
+        void drop_checkpoints();
+
+        /**
+         * @brief Rolls the columns, trend lines and month/box state back to a checkpoint.
+         *
+         * ATR and log state are left to the caller.
+         *
+         * @param cp Checkpoint to roll back to
+         * @param last Last column at the checkpoint
+         */
+        void rewind(const Checkpoint& cp, const Column& last);
 
-        static constexpr std::array<const char*, 12> month_markers_ = {
-            "1", "2", "3", "4", "5", "6", "7", "8", "9", "A", "B", "C"
-        }; /**< Markers for each month */
+        std::pmr::vector<LoggedBar> bar_log_; /**< Every accepted bar, in time order (checkpointing only) */
+        std::pmr::vector<Checkpoint> checkpoints_; /**< Checkpoints in ascending bar order */
+        ColumnList checkpoint_columns_; /**< Last column at each checkpoint (empty column if there was none) */
+        size_t replayed_ = 0; /**< Bars replayed by the last as_of() or splice_data() */
+        std::pmr::vector<Checkpoint> atr_bases_; /**< State at each ATR refresh; only the latest without checkpointing */
+        ColumnList atr_base_columns_; /**< Last column at each ATR refresh */
     };
 } // namespace pnf
 
@@ -0,0 +1,111 @@
+/// \file chart_family.hpp
+/// \brief Several chart variants of one instrument built in a single pass.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#ifndef CHART_FAMILY_HPP
+#define CHART_FAMILY_HPP
+
+#include "chart.hpp"
+#include <vector>
+
+namespace pnf {
+    /**
+     * @brief Builds several chart configurations from one bar stream.
+     *
+     * Each bar is decoded once (its month key is shared by every variant) and
+     * then offered to all variants. For fixed and points box sizes, each
+     * variant keeps a "quiet band": the open price interval inside which a bar
+     * can neither extend the last column nor reverse it. Bands are stored as
+     * contiguous arrays and tested for all variants in one branch-free loop,
+     * so only variants whose band was left pay for a full chart update.
+     * Percentage and traditional variants always take the full update, since
+     * their box size depends on the price. Results are identical to feeding
+     * each Chart separately.
+     */
+    class ChartFamily {
+    public:
+        /**
+         * @brief Creates one chart per configuration.
+         *
+         * @param configs Variant configurations, e.g. SweepGrid::configs()
+         */
+        explicit ChartFamily(const std::vector<ChartConfig>& configs = {});
+
+        /**
+         * @brief Adds a variant; it only sees bars added after this call.
+         *
+         * @param config Chart configuration
+         * @return Index of the new variant
+         */
+        size_t add(const ChartConfig& config);
+
+        /**
+         * @brief Offers one bar to every variant.
+         *
+         * @param high High price
+         * @param low Low price
+         * @param close Close price
+         * @param time Timestamp
+         * @return Number of variants whose chart changed
+         */
+        size_t add_data(double high, double low, double close, Timestamp time);
+
+        /**
+         * @brief Offers a single price to every variant.
+         *
+         * @param price Price
+         * @param time Timestamp
+         * @return Number of variants whose chart changed
+         */
+        size_t add_data(double price, Timestamp time);
+
+        /**
+         * @brief Offers an OHLC bar to every variant.
+         *
+         * @param ohlc OHLC structure
+         * @return Number of variants whose chart changed
+         */
+        size_t add_ohlc(const OHLC& ohlc);
+
+        /**
+         * @brief Checks whether a variant changed on the last bar.
+         *
+         * @param index Variant index
+         * @return true if its chart was updated
+         */
+        [[nodiscard]] bool changed(size_t index) const { return changed_[index] != 0; }
+
+        [[nodiscard]] size_t size() const { return charts_.size(); }
+        [[nodiscard]] const Chart& chart(size_t index) const { return charts_[index]; }
+        [[nodiscard]] const std::vector<Chart>& charts() const { return charts_; }
+        [[nodiscard]] const ChartConfig& config(size_t index) const { return configs_[index]; }
+
+        /**
+         * @brief Returns how many variant updates were resolved by the quiet-band test.
+         *
+         * @return Skipped update count since construction or clear()
+         */
+        [[nodiscard]] size_t quiet_updates() const { return quiet_updates_; }
+
+        /**
+         * @brief Clears every variant, keeping the configurations.
+         */
+        void clear();
+
+    private:
+        void refresh_band(size_t index);
+
+        std::vector<ChartConfig> configs_;      /**< Variant configurations as given */
+        std::vector<Chart> charts_;             /**< One chart per variant */
+        std::vector<double> quiet_low_;         /**< Bar low must be above this to be quiet */
+        std::vector<double> quiet_high_;        /**< Bar high must be below this to be quiet */
+        std::vector<unsigned char> high_low_;   /**< 1 if the variant uses HighLow construction */
+        std::vector<unsigned char> changed_;    /**< Per-variant result of the last bar */
+        size_t quiet_updates_ = 0;              /**< Updates skipped by the band test */
+    };
+} // namespace pnf
+
+#endif //CHART_FAMILY_HPP
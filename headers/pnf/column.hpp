@@ -9,23 +9,72 @@
 #define COLUMN_HPP
 
 #include "box.hpp"
+#include <cstdint>
 #include <vector>
 #include <memory>
+#include <memory_resource>
 
 namespace pnf {
     /**
      * @brief Represents a column in a Point & Figure chart.
      *
-     * A column contains a sequence of boxes and has a type (X or O).
+     * A column contains a sequence of boxes and has a type (X or O). Boxes are
+     * stored by value in memory from the column's allocator, so a column held
+     * in a std::pmr container places its boxes in the same memory resource.
+     *
+     * A finished column can be compacted: its boxes are then kept as a first
+     * price, a signed step, a count, the few boxes that carry a marker, and
+     * the price of every 32nd box, and each box is rebuilt on demand from the
+     * nearest such anchor. Any mutating call expands the column
+     * back to full storage first.
      */
     class Column {
     public:
+        using allocator_type = std::pmr::polymorphic_allocator<>;
+
         /**
          * @brief Constructs a new Column object.
          *
          * @param type The type of the column (default is ColumnType::X)
+         * @param alloc Allocator for the box storage (default resource if omitted)
+         */
+        explicit Column(ColumnType type = ColumnType::X, const allocator_type& alloc = {});
+
+        Column(const Column& other) = default;
+        Column(Column&& other) noexcept = default;
+        Column& operator=(const Column& other) = default;
+        Column& operator=(Column&& other) = default;
+
+        /**
+         * @brief Copies a column into memory from another allocator.
+         *
+         * @param other Column to copy
+         * @param alloc Allocator for the box storage
          */
-        explicit Column(ColumnType type = ColumnType::X);
+        Column(const Column& other, const allocator_type& alloc);
+
+        /**
+         * @brief Moves a column, taking its boxes if the allocators share a resource.
+         *
+         * @param other Column to move from
+         * @param alloc Allocator for the box storage
+         */
+        Column(Column&& other, const allocator_type& alloc);
+
+        /**
+         * @brief Records a marker on one box of a compacted column.
+         */
+        struct MarkedBox {
+            std::uint32_t index;                  /**< Box index within the column */
+            MarkerId marker;                      /**< Interned marker */
+        };
+
+        /**
+         * @brief Returns the allocator used for the box storage.
+         *
+         * @return Polymorphic allocator
+         */
+        allocator_type get_allocator() const { return boxes_.get_allocator(); }
 
         /**
          * @brief Adds a box to the column with the given price and type.
@@ -46,6 +95,16 @@ namespace pnf {
          */
         bool add_box(double price, BoxType box_type, const std::string& marker);
 
+        /**
+         * @brief Adds a box with an interned marker to the column.
+         *
+         * @param price Price of the box
+         * @param box_type Type of the box (X or O)
+         * @param marker Marker ID from MarkerTable
+         * @return true if the box was successfully added, false otherwise
+         */
+        bool add_box(double price, BoxType box_type, MarkerId marker);
+
         /**
          * @brief Removes a box at the given price from the column.
          *
@@ -65,6 +124,9 @@ namespace pnf {
         /**
          * @brief Gets a pointer to the box at the given price.
          *
+         * The const overload returns nullptr on a compacted column; use
+         * has_box() or get_box_marker() there.
+         *
          * @param price Price of the box
          * @return Pointer to the Box if found, nullptr otherwise
          */
@@ -74,12 +136,29 @@ namespace pnf {
         /**
          * @brief Gets a pointer to the box at the specified index.
          *
+         * Boxes are stored by value, so the pointer is invalidated when a box
+         * is added to or removed from the column. A compacted column stores
+         * no Box objects: the const overload returns nullptr there (use
+         * box_at()), and the non-const overload expands the column.
+         *
          * @param index Index of the box in the column
          * @return Pointer to the Box if index is valid, nullptr otherwise
          */
         Box* get_box_at(size_t index);
         const Box* get_box_at(size_t index) const;
 
+        /**
+         * @brief Returns a copy of the box at the specified index.
+         *
+         * Works in both storage forms and never modifies the column. On a
+         * compacted column the price is rebuilt by replaying the step from
+         * the nearest anchor, at most 31 additions.
+         *
+         * @param index Index of the box in the column
+         * @return The box, or an X box at price 0 if index is out of range
+         */
+        Box box_at(size_t index) const;
+
         /**
          * @brief Gets the marker of the box at the given price.
          *
@@ -102,7 +181,7 @@ namespace pnf {
          *
          * @return Number of boxes
          */
-        size_t box_count() const { return boxes_.size(); }
+        size_t box_count() const { return compact_ ? compact_count_ : boxes_.size(); }
 
         /**
          * @brief Gets the highest price in the column.
@@ -132,11 +211,76 @@ namespace pnf {
          */
         void set_type(ColumnType type) { type_ = type; }
 
+        /**
+         * @brief Gets the box size the column was opened with.
+         *
+         * @return Box size in price units, 0 if not recorded
+         */
+        double box_size() const { return box_size_; }
+
+        /**
+         * @brief Records the box size the column was opened with.
+         *
+         * @param box_size Box size in price units
+         */
+        void set_box_size(double box_size) { box_size_ = box_size; }
+
+        /**
+         * @brief Records a bar processed while this was the chart's last column.
+         *
+         * @param time Bar time
+         */
+        void record_bar(Timestamp time);
+
+        /**
+         * @brief Gets the time of the first bar recorded in the column.
+         *
+         * @return First bar time, epoch if no bar was recorded
+         */
+        Timestamp first_time() const { return first_time_; }
+
+        /**
+         * @brief Gets the time of the last bar recorded in the column.
+         *
+         * @return Last bar time, epoch if no bar was recorded
+         */
+        Timestamp last_time() const { return last_time_; }
+
+        /**
+         * @brief Counts the bars recorded in the column.
+         *
+         * @return Number of bars that formed the column
+         */
+        size_t bar_count() const { return bar_count_; }
+
         /**
          * @brief Clears all boxes from the column.
          */
         void clear();
 
+        /**
+         * @brief Switches the column to compact storage.
+         *
+         * Succeeds only when every box has the same type and replaying the
+         * step from the first price reproduces each stored price exactly;
+         * otherwise the column keeps its boxes and nothing changes.
+         *
+         * @return true if the column is compact after the call
+         */
+        bool compact();
+
+        /**
+         * @brief Restores full box storage for a compacted column.
+         */
+        void expand();
+
+        /**
+         * @brief Checks whether the column is in compact storage.
+         *
+         * @return true if boxes are rebuilt on demand
+         */
+        bool is_compact() const { return compact_; }
+
         /**
          * @brief Returns a string representation of the column.
          *
@@ -145,9 +289,31 @@ namespace pnf {
         std::string to_string() const;
 
     private:
-        std::vector<std::unique_ptr<Box>> boxes_; /**< List of boxes in the column */
+        double compact_price(size_t index) const;
+        MarkerId compact_marker(size_t index) const;
+        long compact_index_of(double price) const;
+
+        static constexpr size_t anchor_stride = 32;  /**< Boxes between stored anchor prices */
+
+        std::pmr::vector<Box> boxes_;             /**< List of boxes in the column */
         ColumnType type_;                         /**< Type of the column */
+        double box_size_ = 0.0;                   /**< Box size at column start */
+        Timestamp first_time_{};                  /**< Time of the first recorded bar */
+        Timestamp last_time_{};                   /**< Time of the last recorded bar */
+        size_t bar_count_ = 0;                    /**< Bars recorded in the column */
+        double first_price_ = 0.0;                /**< Price of box 0 when compact */
+        double step_ = 0.0;                       /**< Signed price step between boxes when compact */
+        std::uint32_t compact_count_ = 0;         /**< Box count when compact */
+        BoxType compact_type_ = BoxType::X;       /**< Shared box type when compact */
+        bool compact_ = false;                    /**< Whether boxes are rebuilt on demand */
+        std::pmr::vector<MarkedBox> markers_;     /**< Boxes with a marker when compact */
+        std::pmr::vector<double> anchors_;        /**< Price of box k * anchor_stride (k >= 1) when compact */
     };
+
+    /**
+     * @brief Column storage used by Chart and the trend line manager.
+     */
+    using ColumnList = std::pmr::vector<Column>;
 } // namespace pnf
 
 
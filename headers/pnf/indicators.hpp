@@ -9,8 +9,13 @@
 #define INDICATORS_HPP
 
 #include "chart.hpp"
+#include "mask.hpp"
+#include "thread_pool.hpp"
+#include <span>
 #include <vector>
 #include <memory>
+#include <memory_resource>
+#include <ranges>
 
 namespace pnf
 {
@@ -76,27 +81,49 @@ namespace pnf
         std::vector<PriceObjective> price_objectives{}; /**< Price objectives */
     };
 
+    /**
+     * @brief Indicator results referenced in place.
+     *
+     * The spans point into the Indicators components and stay valid until the
+     * next calculate() or update().
+     */
+    struct IndicatorDataView {
+        std::span<const double> sma_short{};      /**< Short SMA values */
+        std::span<const double> sma_medium{};     /**< Medium SMA values */
+        std::span<const double> sma_long{};       /**< Long SMA values */
+        std::span<const double> bollinger_middle{}; /**< Middle Bollinger Band */
+        std::span<const double> bollinger_upper{};  /**< Upper Bollinger Band */
+        std::span<const double> bollinger_lower{};  /**< Lower Bollinger Band */
+        std::span<const double> rsi{};            /**< RSI values */
+        std::span<const double> obv{};            /**< OBV values */
+        double bullish_percent{};                 /**< Bullish percent */
+        std::span<const Signal> signals{};        /**< Trading signals */
+        std::span<const Pattern> patterns{};      /**< Detected patterns */
+        std::span<const SupportResistanceLevel> levels{}; /**< Support and resistance levels */
+        std::span<const PriceObjective> price_objectives{}; /**< Price objectives */
+    };
+
     /**
      * @brief Simple Moving Average (SMA) indicator.
      */
     class MovingAverage {
     public:
-        explicit MovingAverage(int period);
+        explicit MovingAverage(int period, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
         void calculate(const Chart& chart);
+        void truncate(size_t count);
+        void append(std::span<const double> midpoints);
         void set_period(int period);
         [[nodiscard]] double value(int column) const;
         [[nodiscard]] bool has_value(int column) const;
         [[nodiscard]] int period() const { return period_; }
-        [[nodiscard]] const std::vector<double>& values() const { return values_; }
-        [[nodiscard]] std::vector<double> values_copy() const { return values_; }
+        [[nodiscard]] const std::pmr::vector<double>& values() const { return values_; }
+        [[nodiscard]] std::vector<double> values_copy() const { return {values_.begin(), values_.end()}; }
         [[nodiscard]] std::string to_string() const;
 
     private:
-        static double column_average(const Column* col);
-
         int period_;                  /**< SMA period */
-        std::vector<double> values_;  /**< Calculated SMA values */
+        std::pmr::vector<double> values_;  /**< Calculated SMA values */
     };
 
     /**
@@ -104,9 +131,11 @@ namespace pnf
      */
     class BollingerBands {
     public:
-        explicit BollingerBands(int period = 20, double std_devs = 2.0);
+        explicit BollingerBands(int period = 20, double std_devs = 2.0, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
         void calculate(const Chart& chart);
+        void truncate(size_t count);
+        void append(std::span<const double> midpoints);
         void set_period(int period);
         void set_std_devs(double devs);
         [[nodiscard]] double middle(int column) const;
@@ -115,26 +144,26 @@ namespace pnf
         [[nodiscard]] bool has_value(int column) const;
         [[nodiscard]] bool is_above_upper(int column, double price) const;
         [[nodiscard]] bool is_below_lower(int column, double price) const;
+        [[nodiscard]] ColumnMask above_upper_mask(std::span<const double> prices) const;
+        [[nodiscard]] ColumnMask below_lower_mask(std::span<const double> prices) const;
 
         [[nodiscard]] int period() const { return period_; }
         [[nodiscard]] double std_devs() const { return std_devs_; }
-        [[nodiscard]] const std::vector<double>& middle_band() const { return middle_; }
-        [[nodiscard]] const std::vector<double>& upper_band() const { return upper_; }
-        [[nodiscard]] const std::vector<double>& lower_band() const { return lower_; }
-        [[nodiscard]] std::vector<double> middle_copy() const { return middle_; }
-        [[nodiscard]] std::vector<double> upper_copy() const { return upper_; }
-        [[nodiscard]] std::vector<double> lower_copy() const { return lower_; }
+        [[nodiscard]] const std::pmr::vector<double>& middle_band() const { return middle_; }
+        [[nodiscard]] const std::pmr::vector<double>& upper_band() const { return upper_; }
+        [[nodiscard]] const std::pmr::vector<double>& lower_band() const { return lower_; }
+        [[nodiscard]] std::vector<double> middle_copy() const { return {middle_.begin(), middle_.end()}; }
+        [[nodiscard]] std::vector<double> upper_copy() const { return {upper_.begin(), upper_.end()}; }
+        [[nodiscard]] std::vector<double> lower_copy() const { return {lower_.begin(), lower_.end()}; }
 
         [[nodiscard]] std::string to_string() const;
 
     private:
-        static double std_deviation(const std::vector<double>& vals, double mean);
-
         int period_;                   /**< Bollinger Bands period */
         double std_devs_;              /**< Number of standard deviations */
-        std::vector<double> middle_;   /**< Middle band */
-        std::vector<double> upper_;    /**< Upper band */
-        std::vector<double> lower_;    /**< Lower band */
+        std::pmr::vector<double> middle_;   /**< Middle band */
+        std::pmr::vector<double> upper_;    /**< Upper band */
+        std::pmr::vector<double> lower_;    /**< Lower band */
     };
 
     /**
@@ -142,9 +171,11 @@ namespace pnf
      */
     class RSI {
     public:
-        explicit RSI(int period = 14);
+        explicit RSI(int period = 14, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
         void calculate(const Chart& chart);
+        void truncate(size_t count);
+        void append(std::span<const double> midpoints);
         void set_period(int period);
         void set_thresholds(double overbought, double oversold);
         [[nodiscard]] double value(int column) const;
@@ -153,19 +184,25 @@ namespace pnf
         [[nodiscard]] bool is_oversold(int column) const;
         [[nodiscard]] bool is_overbought_custom(int column, double threshold) const;
         [[nodiscard]] bool is_oversold_custom(int column, double threshold) const;
+        [[nodiscard]] ColumnMask overbought_mask() const;
+        [[nodiscard]] ColumnMask oversold_mask() const;
+        [[nodiscard]] ColumnMask overbought_mask(double threshold) const;
+        [[nodiscard]] ColumnMask oversold_mask(double threshold) const;
+        [[nodiscard]] ColumnMask cross_above_mask(double threshold) const;
+        [[nodiscard]] ColumnMask cross_below_mask(double threshold) const;
 
         [[nodiscard]] int period() const { return period_; }
         [[nodiscard]] double overbought_threshold() const { return overbought_; }
         [[nodiscard]] double oversold_threshold() const { return oversold_; }
-        [[nodiscard]] const std::vector<double>& values() const { return values_; }
-        [[nodiscard]] std::vector<double> values_copy() const { return values_; }
+        [[nodiscard]] const std::pmr::vector<double>& values() const { return values_; }
+        [[nodiscard]] std::vector<double> values_copy() const { return {values_.begin(), values_.end()}; }
         [[nodiscard]] std::string to_string() const;
 
     private:
         int period_;                  /**< RSI period */
         double overbought_ = 70.0;    /**< Overbought threshold */
         double oversold_ = 30.0;      /**< Oversold threshold */
-        std::vector<double> values_;  /**< Calculated RSI values */
+        std::pmr::vector<double> values_;  /**< Calculated RSI values */
     };
 
     /**
@@ -173,18 +210,18 @@ namespace pnf
      */
     class OnBalanceVolume {
     public:
-        OnBalanceVolume() = default;
+        explicit OnBalanceVolume(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
         void calculate(const Chart& chart, const std::vector<OHLC>& ohlc_data);
         [[nodiscard]] double value(int column) const;
         [[nodiscard]] bool has_value(int column) const;
 
-        [[nodiscard]] const std::vector<double>& values() const { return values_; }
-        [[nodiscard]] std::vector<double> values_copy() const { return values_; }
+        [[nodiscard]] const std::pmr::vector<double>& values() const { return values_; }
+        [[nodiscard]] std::vector<double> values_copy() const { return {values_.begin(), values_.end()}; }
         [[nodiscard]] std::string to_string() const;
 
     private:
-        std::vector<double> values_{}; /**< OBV values */
+        std::pmr::vector<double> values_; /**< OBV values */
     };
 
     /**
@@ -195,6 +232,7 @@ namespace pnf
         BullishPercent() = default;
 
         void calculate(const Chart& chart);
+        void update(const Chart& chart, size_t first);
         void set_thresholds(double bullish, double bearish);
         [[nodiscard]] double value() const { return value_; }
         [[nodiscard]] bool is_bullish_alert() const { return value_ > bullish_threshold_; }
@@ -206,6 +244,8 @@ namespace pnf
 
     private:
         double value_ = 50.0;           /**< Current bullish percent value */
+        size_t settled_ = 0;            /**< Columns before the last one already counted */
+        size_t settled_x_ = 0;          /**< X columns among the settled ones */
         double bullish_threshold_ = 70.0; /**< Bullish alert threshold */
         double bearish_threshold_ = 30.0; /**< Bearish alert threshold */
     };
@@ -215,18 +255,25 @@ namespace pnf
      */
     class SignalDetector {
     public:
-        SignalDetector() = default;
+        explicit SignalDetector(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
         void detect(const Chart& chart);
+        void detect_from(const Chart& chart, size_t first);
+        [[nodiscard]] static SignalType signal_at(const Chart& chart, int column);
         [[nodiscard]] SignalType current_signal() const { return current_; }
-        [[nodiscard]] const std::vector<Signal>& signals() const { return signals_; }
-        [[nodiscard]] std::vector<Signal> signals_copy() const { return signals_; }
+        [[nodiscard]] const std::pmr::vector<Signal>& signals() const { return signals_; }
+        [[nodiscard]] std::vector<Signal> signals_copy() const { return {signals_.begin(), signals_.end()}; }
         [[nodiscard]] Signal last_signal() const;
         [[nodiscard]] bool has_buy_signal() const { return current_ == SignalType::Buy; }
         [[nodiscard]] bool has_sell_signal() const { return current_ == SignalType::Sell; }
 
         [[nodiscard]] std::vector<Signal> buy_signals() const;
         [[nodiscard]] std::vector<Signal> sell_signals() const;
+        [[nodiscard]] auto signals_view(SignalType type) const {
+            return signals_ | std::views::filter([type](const Signal& s) { return s.type == type; });
+        }
+        [[nodiscard]] auto buy_signals_view() const { return signals_view(SignalType::Buy); }
+        [[nodiscard]] auto sell_signals_view() const { return signals_view(SignalType::Sell); }
         [[nodiscard]] int buy_count() const;
         [[nodiscard]] int sell_count() const;
 
@@ -236,7 +283,7 @@ namespace pnf
         static bool is_buy_signal(const Chart& chart, int column);
         static bool is_sell_signal(const Chart& chart, int column);
 
-        std::vector<Signal> signals_{}; /**< Detected signals */
+        std::pmr::vector<Signal> signals_; /**< Detected signals */
         SignalType current_ = SignalType::None; /**< Current signal type */
     };
 
@@ -245,7 +292,7 @@ namespace pnf
      */
     class PatternRecognizer {
     public:
-        PatternRecognizer() = default;
+        explicit PatternRecognizer(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
         bool detect_double_top_breakout(const Chart& chart, int col);
         bool detect_double_bottom_breakdown(const Chart& chart, int col);
@@ -268,15 +315,27 @@ namespace pnf
         bool detect_bear_trap(const Chart& chart, int col);
         bool detect_spread_triple_top(const Chart& chart, int col);
         bool detect_spread_triple_bottom(const Chart& chart, int col);
+        int detect_column(const Chart& chart, int col);
         void detect(const Chart& chart);
-        [[nodiscard]] const std::vector<Pattern>& patterns() const { return patterns_; }
-        [[nodiscard]] std::vector<Pattern> patterns_copy() const { return patterns_; }
+        void detect_from(const Chart& chart, size_t first);
+        void clear() { patterns_.clear(); column_offsets_.clear(); }
+        [[nodiscard]] const std::pmr::vector<Pattern>& patterns() const { return patterns_; }
+        [[nodiscard]] std::vector<Pattern> patterns_copy() const { return {patterns_.begin(), patterns_.end()}; }
         [[nodiscard]] std::vector<Pattern> bullish_patterns() const;
         [[nodiscard]] std::vector<Pattern> bearish_patterns() const;
+        [[nodiscard]] auto bullish_patterns_view() const {
+            return patterns_ | std::views::filter([](const Pattern& p) { return is_bullish_pattern(p.type); });
+        }
+        [[nodiscard]] auto bearish_patterns_view() const {
+            return patterns_ | std::views::filter([](const Pattern& p) { return is_bearish_pattern(p.type); });
+        }
         [[nodiscard]] Pattern latest_pattern() const;
         [[nodiscard]] bool has_pattern(PatternType type) const;
 
         [[nodiscard]] std::vector<Pattern> patterns_of_type(PatternType type) const;
+        [[nodiscard]] auto patterns_of_type_view(PatternType type) const {
+            return patterns_ | std::views::filter([type](const Pattern& p) { return p.type == type; });
+        }
         [[nodiscard]] int pattern_count() const { return static_cast<int>(patterns_.size()); }
         [[nodiscard]] int bullish_count() const;
         [[nodiscard]] int bearish_count() const;
@@ -284,7 +343,10 @@ namespace pnf
         [[nodiscard]] std::string to_string() const;
 
     private:
-        std::vector<Pattern> patterns_{}; /**< Detected patterns */
+        bool detect_catapult(int col, PatternType breakout, PatternType setup, PatternType catapult);
+
+        std::pmr::vector<Pattern> patterns_; /**< Detected patterns */
+        std::pmr::vector<size_t> column_offsets_; /**< patterns_ size before each column was visited */
     };
 
     /**
@@ -292,29 +354,44 @@ namespace pnf
      */
     class SupportResistance {
     public:
-        explicit SupportResistance(double threshold = 0.01);
+        explicit SupportResistance(double threshold = 0.01, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
         void identify(const Chart& chart);
+        void identify_since(const Chart& chart, size_t first);
         void set_threshold(double threshold);
         [[nodiscard]] double threshold() const { return threshold_; }
 
-        [[nodiscard]] const std::vector<SupportResistanceLevel>& levels() const { return levels_; }
-        [[nodiscard]] std::vector<SupportResistanceLevel> levels_copy() const { return levels_; }
+        [[nodiscard]] const std::pmr::vector<SupportResistanceLevel>& levels() const { return levels_; }
+        [[nodiscard]] std::vector<SupportResistanceLevel> levels_copy() const { return {levels_.begin(), levels_.end()}; }
         [[nodiscard]] std::vector<SupportResistanceLevel> support_levels() const;
         [[nodiscard]] std::vector<SupportResistanceLevel> resistance_levels() const;
         [[nodiscard]] std::vector<SupportResistanceLevel> significant_levels(int min_touches = 3) const;
+        [[nodiscard]] auto levels_view(bool support) const {
+            return levels_ | std::views::filter([support](const SupportResistanceLevel& l) { return l.is_support == support; });
+        }
+        [[nodiscard]] auto support_levels_view() const { return levels_view(true); }
+        [[nodiscard]] auto resistance_levels_view() const { return levels_view(false); }
+        [[nodiscard]] auto significant_levels_view(int min_touches = 3) const {
+            return levels_ | std::views::filter([min_touches](const SupportResistanceLevel& l) {
+                return l.touch_count >= min_touches;
+            });
+        }
         [[nodiscard]] bool is_near_support(double price, double tolerance = 0.02) const;
         [[nodiscard]] bool is_near_resistance(double price, double tolerance = 0.02) const;
+        [[nodiscard]] ColumnMask near_support_mask(std::span<const double> prices, double tolerance = 0.02) const;
+        [[nodiscard]] ColumnMask near_resistance_mask(std::span<const double> prices, double tolerance = 0.02) const;
 
         [[nodiscard]] std::vector<double> support_prices() const;
         [[nodiscard]] std::vector<double> resistance_prices() const;
+        [[nodiscard]] auto support_prices_view() const { return levels_view(true) | std::views::transform(&SupportResistanceLevel::price); }
+        [[nodiscard]] auto resistance_prices_view() const { return levels_view(false) | std::views::transform(&SupportResistanceLevel::price); }
 
         [[nodiscard]] std::string to_string() const;
 
     private:
         void merge_similar_levels();
 
-        std::vector<SupportResistanceLevel> levels_; /**< All detected levels */
+        std::pmr::vector<SupportResistanceLevel> levels_; /**< All detected levels */
         double threshold_;                             /**< Price tolerance for merging levels */
     };
 
@@ -323,23 +400,30 @@ namespace pnf
      */
     class PriceObjectiveCalculator {
     public:
-        PriceObjectiveCalculator() = default;
+        explicit PriceObjectiveCalculator(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
         void calculate_vertical_count(const Chart& chart, int column);
         void calculate_all(const Chart& chart);
-        [[nodiscard]] const std::vector<PriceObjective>& objectives() const { return objectives_; }
-        [[nodiscard]] std::vector<PriceObjective> objectives_copy() const { return objectives_; }
+        [[nodiscard]] const std::pmr::vector<PriceObjective>& objectives() const { return objectives_; }
+        [[nodiscard]] std::vector<PriceObjective> objectives_copy() const { return {objectives_.begin(), objectives_.end()}; }
         [[nodiscard]] PriceObjective latest() const;
 
         [[nodiscard]] std::vector<PriceObjective> bullish_objectives() const;
         [[nodiscard]] std::vector<PriceObjective> bearish_objectives() const;
         [[nodiscard]] std::vector<double> bullish_targets() const;
         [[nodiscard]] std::vector<double> bearish_targets() const;
+        [[nodiscard]] auto objectives_view(bool bullish) const {
+            return objectives_ | std::views::filter([bullish](const PriceObjective& o) { return o.is_bullish == bullish; });
+        }
+        [[nodiscard]] auto bullish_objectives_view() const { return objectives_view(true); }
+        [[nodiscard]] auto bearish_objectives_view() const { return objectives_view(false); }
+        [[nodiscard]] auto bullish_targets_view() const { return objectives_view(true) | std::views::transform(&PriceObjective::target_price); }
+        [[nodiscard]] auto bearish_targets_view() const { return objectives_view(false) | std::views::transform(&PriceObjective::target_price); }
 
         [[nodiscard]] std::string to_string() const;
 
     private:
-        std::vector<PriceObjective> objectives_{}; /**< Calculated price objectives */
+        std::pmr::vector<PriceObjective> objectives_; /**< Calculated price objectives */
     };
 
     /**
@@ -358,40 +442,51 @@ namespace pnf
             int column_count;
         };
 
-        explicit CongestionDetector(int min_columns = 4, double price_range_threshold = 0.05);
+        explicit CongestionDetector(int min_columns = 4, double price_range_threshold = 0.05,
+                                    std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
         void detect(const Chart& chart);
+        void detect_since(const Chart& chart, size_t first);
         void set_min_columns(int min);
         void set_threshold(double threshold);
         [[nodiscard]] int min_columns() const { return min_columns_; }
         [[nodiscard]] double threshold() const { return threshold_; }
 
-        [[nodiscard]] const std::vector<CongestionZone>& zones() const { return zones_; }
-        [[nodiscard]] std::vector<CongestionZone> zones_copy() const { return zones_; }
+        [[nodiscard]] const std::pmr::vector<CongestionZone>& zones() const { return zones_; }
+        [[nodiscard]] std::vector<CongestionZone> zones_copy() const { return {zones_.begin(), zones_.end()}; }
         [[nodiscard]] bool is_in_congestion(int column) const;
         [[nodiscard]] CongestionZone largest_zone() const;
 
         [[nodiscard]] std::string to_string() const;
 
     private:
-        std::vector<CongestionZone> zones_; /**< Detected congestion zones */
+        std::pmr::vector<CongestionZone> zones_; /**< Detected congestion zones */
         int min_columns_;                   /**< Minimum columns for congestion */
         double threshold_;                  /**< Price range threshold for congestion */
     };
 
     /**
      * @brief High-level container for all technical indicators.
+     *
+     * Every indicator's result vectors are allocated from the memory resource
+     * given at construction, so they can share an arena with the chart.
+     * A null resource selects the default resource, here and in every
+     * component constructor.
      */
     class Indicators {
     public:
         Indicators();
-        explicit Indicators(const IndicatorConfig& config);
+        explicit Indicators(const IndicatorConfig& config,
+                            std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
         void configure(const IndicatorConfig& config);
         [[nodiscard]] IndicatorConfig config() const { return config_; }
+        [[nodiscard]] std::pmr::memory_resource* memory_resource() const { return resource_; }
 
         void calculate(const Chart& chart) const;
+        void calculate(const Chart& chart, ThreadPool& pool) const;
         void calculate_with_volume(const Chart& chart, const std::vector<OHLC>& ohlc_data) const;
+        void update(const Chart& chart) const;
 
         [[nodiscard]] MovingAverage* sma_short() { return sma_short_.get(); }
         [[nodiscard]] MovingAverage* sma_medium() { return sma_medium_.get(); }
@@ -420,6 +515,7 @@ namespace pnf
         [[nodiscard]] const CongestionDetector* congestion() const { return congestion_.get(); }
 
         [[nodiscard]] IndicatorData export_data() const;
+        [[nodiscard]] IndicatorDataView export_view() const;
         static ChartData export_chart_data(const Chart& chart);
 
         [[nodiscard]] std::string summary() const;
@@ -427,8 +523,10 @@ namespace pnf
 
     private:
         void initialize();
+        void run(const Chart& chart, size_t first, ThreadPool* pool = nullptr) const;
 
         IndicatorConfig config_;
+        std::pmr::memory_resource* resource_ = std::pmr::get_default_resource();
         std::unique_ptr<MovingAverage> sma_short_;
         std::unique_ptr<MovingAverage> sma_medium_;
         std::unique_ptr<MovingAverage> sma_long_;
@@ -441,6 +539,9 @@ namespace pnf
         std::unique_ptr<SupportResistance> support_resistance_;
         std::unique_ptr<PriceObjectiveCalculator> objectives_;
         std::unique_ptr<CongestionDetector> congestion_;
+        mutable const Chart* synced_chart_ = nullptr;  /**< Chart the series were last computed for */
+        mutable size_t synced_columns_ = 0;            /**< Column count at that time */
+        mutable std::uint64_t synced_rebuilds_ = 0;    /**< Chart::rebuild_count() at that time */
     };
 } // namespace pnf
 
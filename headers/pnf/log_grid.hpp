@@ -0,0 +1,80 @@
+/// \file log_grid.hpp
+/// \brief Logarithmic box grid with a lazily extended level table.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#ifndef LOG_GRID_HPP
+#define LOG_GRID_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace pnf {
+    /**
+     * @brief Fixed logarithmic price grid used by BoxSizeMethod::Logarithmic.
+     *
+     * Level k sits at (1 + percent / 100)^k, so every chart built with the
+     * same percentage shares identical box prices and a level index doubles as
+     * a row number. Levels touched while building a chart are cached in a
+     * contiguous table; price lookups inside the table are binary searches,
+     * outside it a log-index estimate corrected against the exact levels.
+     */
+    class LogBoxGrid {
+    public:
+        /**
+         * @brief Creates a grid.
+         *
+         * @param percent Box height as a percentage of price; non-positive values use 1%
+         */
+        explicit LogBoxGrid(double percent = 1.0);
+
+        [[nodiscard]] double percent() const { return percent_; }
+        [[nodiscard]] double ratio() const { return ratio_; }
+
+        /**
+         * @brief Returns the price of a level without touching the table.
+         *
+         * @param index Level index
+         * @return Level price
+         */
+        [[nodiscard]] double level(int index) const;
+
+        /**
+         * @brief Returns the price of a level, extending the table to cover it.
+         *
+         * @param index Level index
+         * @return Level price, identical to level(index)
+         */
+        double at(int index);
+
+        /**
+         * @brief Returns the highest level at or below a price.
+         *
+         * @param price Positive price
+         * @return Level index
+         */
+        [[nodiscard]] int floor_index(double price) const;
+
+        /**
+         * @brief Returns the lowest level at or above a price.
+         *
+         * @param price Positive price
+         * @return Level index
+         */
+        [[nodiscard]] int ceil_index(double price) const;
+
+        [[nodiscard]] int first_index() const { return first_; }
+        [[nodiscard]] size_t table_size() const { return levels_.size(); }
+
+    private:
+        double percent_;                /**< Box height in percent */
+        double ratio_;                  /**< 1 + percent / 100 */
+        double log_ratio_;              /**< log(ratio_) */
+        std::vector<double> levels_;    /**< Cached levels first_ .. first_ + size - 1 */
+        int first_ = 0;                 /**< Index of levels_[0] */
+    };
+} // namespace pnf
+
+#endif //LOG_GRID_HPP
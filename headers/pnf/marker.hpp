@@ -0,0 +1,70 @@
+/// \file marker.hpp
+/// \brief Interned box markers.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#ifndef MARKER_HPP
+#define MARKER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace pnf {
+    /**
+     * @brief Small integer ID of an interned box marker; 0 means no marker.
+     */
+    using MarkerId = std::uint16_t;
+
+    /**
+     * @brief Process-wide intern table for box markers.
+     *
+     * The twelve month codes ("1".."9", "A", "B", "C") are pre-registered as
+     * IDs 1..12, so the chart never touches the table's lock while building.
+     * Other markers are interned on demand and keep their ID for the life of
+     * the process. All functions are thread-safe.
+     */
+    class MarkerTable {
+    public:
+        static constexpr MarkerId none = 0;          /**< ID of the empty marker */
+        static constexpr MarkerId month_count = 12;  /**< Pre-registered month codes */
+
+        /**
+         * @brief Returns the ID of a month code.
+         *
+         * @param month Month number (1-12)
+         * @return Month marker ID, or none if out of range
+         */
+        static constexpr MarkerId month(const int month) {
+            return month >= 1 && month <= month_count ? static_cast<MarkerId>(month) : none;
+        }
+
+        /**
+         * @brief Returns the ID of a marker, registering it if needed.
+         *
+         * @param marker Marker text
+         * @return Marker ID; none for an empty marker or when the table is full
+         */
+        static MarkerId intern(std::string_view marker);
+
+        /**
+         * @brief Returns the text of a marker ID.
+         *
+         * @param id Marker ID
+         * @return Marker text, empty for none or unknown IDs; the reference stays valid
+         */
+        static const std::string& name(MarkerId id);
+
+        /**
+         * @brief Returns the number of registered markers, including the month codes.
+         *
+         * @return Marker count (excluding none)
+         */
+        static size_t size();
+    };
+} // namespace pnf
+
+#endif //MARKER_HPP
@@ -0,0 +1,227 @@
+/// \file mask.hpp
+/// \brief Column bitsets and vectorized series kernels.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#ifndef MASK_HPP
+#define MASK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace pnf {
+    /**
+     * @brief Instruction set used by the series kernels.
+     */
+    enum class SimdLevel {
+        Scalar,  /**< Portable loop */
+        AVX2,    /**< 4 doubles per instruction */
+        AVX512   /**< 8 doubles per instruction */
+    };
+
+    /**
+     * @brief Returns the widest instruction set this CPU and build support.
+     *
+     * @return Supported SIMD level
+     */
+    SimdLevel supported_simd_level();
+
+    /**
+     * @brief Returns the instruction set the kernels currently dispatch to.
+     *
+     * @return Active SIMD level
+     */
+    SimdLevel simd_level();
+
+    /**
+     * @brief Selects the kernel instruction set, clamped to what is supported.
+     *
+     * Intended for benchmarks and tests; results are identical at every level.
+     *
+     * @param level Requested SIMD level
+     * @return Level actually selected
+     */
+    SimdLevel set_simd_level(SimdLevel level);
+
+    /**
+     * @brief Fixed-size bitset with one bit per chart column.
+     *
+     * Bits are packed 64 per word, least significant bit first, and bits past
+     * size() are always zero.
+     */
+    class ColumnMask {
+    public:
+        ColumnMask() = default;
+
+        /**
+         * @brief Constructs an all-clear mask.
+         *
+         * @param size Number of columns
+         */
+        explicit ColumnMask(size_t size);
+
+        /**
+         * @brief Returns the number of columns covered.
+         *
+         * @return Mask size in bits
+         */
+        size_t size() const { return size_; }
+
+        /**
+         * @brief Checks a column bit.
+         *
+         * @param index Column index
+         * @return true if set, false if clear or out of range
+         */
+        bool test(size_t index) const;
+
+        /**
+         * @brief Sets or clears a column bit; out of range indices are ignored.
+         *
+         * @param index Column index
+         * @param value New bit value
+         */
+        void set(size_t index, bool value = true);
+
+        /**
+         * @brief Counts set bits.
+         *
+         * @return Number of flagged columns
+         */
+        size_t count() const;
+
+        /**
+         * @brief Checks whether any bit is set.
+         *
+         * @return true if at least one column is flagged
+         */
+        bool any() const;
+
+        /**
+         * @brief Lists the flagged columns in ascending order.
+         *
+         * @return Column indices
+         */
+        std::vector<size_t> indices() const;
+
+        /**
+         * @brief Returns the packed words.
+         *
+         * @return Words, 64 columns each
+         */
+        const std::vector<std::uint64_t>& words() const { return words_; }
+        std::vector<std::uint64_t>& words() { return words_; }
+
+        /**
+         * @brief Clears every bit below a column index.
+         *
+         * @param first First column to keep
+         */
+        void clear_before(size_t first);
+
+        ColumnMask& operator&=(const ColumnMask& other);
+        ColumnMask& operator|=(const ColumnMask& other);
+        friend ColumnMask operator&(ColumnMask a, const ColumnMask& b) { return a &= b; }
+        friend ColumnMask operator|(ColumnMask a, const ColumnMask& b) { return a |= b; }
+        bool operator==(const ColumnMask& other) const = default;
+
+    private:
+        size_t size_ = 0;                    /**< Number of columns */
+        std::vector<std::uint64_t> words_;   /**< Packed bits */
+    };
+
+    /**
+     * @brief Flags columns where values[i] > bounds[i].
+     *
+     * @param values Series to test
+     * @param bounds Per-column bounds
+     * @param first First column to evaluate; earlier bits stay clear
+     * @return Mask over min(values.size(), bounds.size()) columns
+     */
+    ColumnMask mask_greater(std::span<const double> values, std::span<const double> bounds, size_t first = 0);
+
+    /**
+     * @brief Flags columns where values[i] < bounds[i].
+     *
+     * @param values Series to test
+     * @param bounds Per-column bounds
+     * @param first First column to evaluate; earlier bits stay clear
+     * @return Mask over min(values.size(), bounds.size()) columns
+     */
+    ColumnMask mask_less(std::span<const double> values, std::span<const double> bounds, size_t first = 0);
+
+    /**
+     * @brief Flags columns where values[i] > threshold.
+     *
+     * @param values Series to test
+     * @param threshold Constant bound
+     * @param first First column to evaluate; earlier bits stay clear
+     * @return Mask over values.size() columns
+     */
+    ColumnMask mask_greater(std::span<const double> values, double threshold, size_t first = 0);
+
+    /**
+     * @brief Flags columns where values[i] < threshold.
+     *
+     * @param values Series to test
+     * @param threshold Constant bound
+     * @param first First column to evaluate; earlier bits stay clear
+     * @return Mask over values.size() columns
+     */
+    ColumnMask mask_less(std::span<const double> values, double threshold, size_t first = 0);
+
+    /**
+     * @brief Flags columns where the series moves from <= threshold to > threshold.
+     *
+     * @param values Series to test
+     * @param threshold Level being crossed
+     * @param first First column whose predecessor may be compared
+     * @return Mask over values.size() columns
+     */
+    ColumnMask mask_cross_above(std::span<const double> values, double threshold, size_t first = 0);
+
+    /**
+     * @brief Flags columns where the series moves from >= threshold to < threshold.
+     *
+     * @param values Series to test
+     * @param threshold Level being crossed
+     * @param first First column whose predecessor may be compared
+     * @return Mask over values.size() columns
+     */
+    ColumnMask mask_cross_below(std::span<const double> values, double threshold, size_t first = 0);
+
+    /**
+     * @brief Flags columns within a relative tolerance of any level.
+     *
+     * Matches |values[i] - level| / level < tolerance, as used by the
+     * support/resistance proximity checks.
+     *
+     * @param values Series to test
+     * @param levels Candidate price levels
+     * @param tolerance Relative distance
+     * @return Mask over values.size() columns
+     */
+    ColumnMask mask_near_any(std::span<const double> values, std::span<const double> levels, double tolerance);
+
+    /**
+     * @brief Returns the smallest value of a series without NaNs.
+     *
+     * @param values Series to reduce
+     * @return Minimum, or 0 for an empty series
+     */
+    double series_min(std::span<const double> values);
+
+    /**
+     * @brief Returns the largest value of a series without NaNs.
+     *
+     * @param values Series to reduce
+     * @return Maximum, or 0 for an empty series
+     */
+    double series_max(std::span<const double> values);
+} // namespace pnf
+
+#endif //MASK_HPP
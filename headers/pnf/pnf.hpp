@@ -18,5 +18,16 @@
 #include "visualization.hpp"
 #include "viewer.hpp"
 #include "csv_loader.hpp"
+#include "thread_pool.hpp"
+#include "sweep.hpp"
+#include "backtest.hpp"
+#include "breadth.hpp"
+#include "scanner.hpp"
+#include "relative_strength.hpp"
+#include "timeframe.hpp"
+#include "chart_family.hpp"
+#include "log_grid.hpp"
+#include "marker.hpp"
+#include "mask.hpp"
 
 #endif //PNF_HPP
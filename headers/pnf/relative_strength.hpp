@@ -0,0 +1,118 @@
+/// \file relative_strength.hpp
+/// \brief Relative strength (symbol vs benchmark) Point & Figure charts.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#ifndef RELATIVE_STRENGTH_HPP
+#define RELATIVE_STRENGTH_HPP
+
+#include "chart.hpp"
+#include "thread_pool.hpp"
+#include <vector>
+#include <memory>
+
+namespace pnf {
+    /**
+     * @brief Configuration for a relative strength chart.
+     */
+    struct RelativeStrengthConfig {
+        ChartConfig chart{ConstructionMethod::Close, BoxSizeMethod::Percentage, 3.25, 3}; /**< Ratio chart settings */
+        double scale = 100.0; /**< Multiplier applied to symbol / benchmark */
+    };
+
+    /**
+     * @brief Charts the ratio of a symbol to a benchmark.
+     *
+     * The two legs are joined with as-of semantics: whenever either leg ticks,
+     * the ratio is formed from the latest known price of each leg and fed into
+     * the chart. Nothing is emitted until both legs have a price. Emitted
+     * timestamps never go backwards, even if the legs interleave out of order.
+     */
+    class RelativeStrengthChart {
+    public:
+        explicit RelativeStrengthChart(const RelativeStrengthConfig& config = {});
+
+        /**
+         * @brief Records a symbol price.
+         *
+         * @param price Symbol price
+         * @param time Tick time
+         * @return true if the ratio chart changed
+         */
+        bool update_symbol(double price, Timestamp time);
+
+        /**
+         * @brief Records a benchmark price.
+         *
+         * @param price Benchmark price
+         * @param time Tick time
+         * @return true if the ratio chart changed
+         */
+        bool update_benchmark(double price, Timestamp time);
+
+        /**
+         * @brief Records aligned prices for both legs and emits one ratio.
+         *
+         * @param symbol_price Symbol price
+         * @param benchmark_price Benchmark price
+         * @param time Tick time
+         * @return true if the ratio chart changed
+         */
+        bool update(double symbol_price, double benchmark_price, Timestamp time);
+
+        /**
+         * @brief Builds a ratio chart from two time-ordered bar series.
+         *
+         * Bars are merged by time using closes; bars sharing a timestamp are
+         * applied together so only one ratio is emitted for that time.
+         *
+         * @param symbol Symbol bars
+         * @param benchmark Benchmark bars
+         * @param config Chart configuration
+         * @return Populated chart
+         */
+        static RelativeStrengthChart build(const std::vector<OHLC>& symbol, const std::vector<OHLC>& benchmark,
+                                           const RelativeStrengthConfig& config = {});
+
+        /**
+         * @brief Builds ratio charts for a universe against one benchmark in parallel.
+         *
+         * @param symbols One bar series per symbol
+         * @param benchmark Benchmark bars, shared read-only by every task
+         * @param pool Pool to run on
+         * @param config Chart configuration
+         * @return One chart per symbol, in input order
+         */
+        static std::vector<RelativeStrengthChart> build_universe(const std::vector<std::vector<OHLC>>& symbols,
+                                                                 const std::vector<OHLC>& benchmark,
+                                                                 ThreadPool& pool,
+                                                                 const RelativeStrengthConfig& config = {});
+
+        [[nodiscard]] const Chart& chart() const { return *chart_; }
+        [[nodiscard]] double ratio() const { return ratio_; }
+        [[nodiscard]] bool has_ratio() const { return ratio_count_ > 0; }
+        [[nodiscard]] size_t ratio_count() const { return ratio_count_; }
+        [[nodiscard]] double symbol_price() const { return symbol_price_; }
+        [[nodiscard]] double benchmark_price() const { return benchmark_price_; }
+        [[nodiscard]] const RelativeStrengthConfig& config() const { return config_; }
+
+        void clear();
+
+    private:
+        bool emit(Timestamp time);
+
+        RelativeStrengthConfig config_;     /**< Configuration */
+        std::unique_ptr<Chart> chart_;      /**< Ratio chart */
+        double symbol_price_ = 0.0;         /**< Latest symbol price */
+        double benchmark_price_ = 0.0;      /**< Latest benchmark price */
+        bool has_symbol_ = false;           /**< Symbol leg has ticked */
+        bool has_benchmark_ = false;        /**< Benchmark leg has ticked */
+        double ratio_ = 0.0;                /**< Last emitted ratio */
+        size_t ratio_count_ = 0;            /**< Ratios emitted */
+        Timestamp last_time_{};             /**< Last emitted time */
+    };
+} // namespace pnf
+
+#endif //RELATIVE_STRENGTH_HPP
@@ -0,0 +1,193 @@
+/// \file scanner.hpp
+/// \brief Cross-symbol chart scanner with compiled queries.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#ifndef SCANNER_HPP
+#define SCANNER_HPP
+
+#include "indicators.hpp"
+#include "thread_pool.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace pnf {
+    /**
+     * @brief Trend-line bias filter.
+     */
+    enum class ScanBias {
+        Any,        /**< No bias filter */
+        Bullish,    /**< Chart must have a bullish bias */
+        Bearish     /**< Chart must have a bearish bias */
+    };
+
+    /**
+     * @brief Congestion membership filter for the last column.
+     */
+    enum class ScanCongestion {
+        Any,        /**< No congestion filter */
+        Inside,     /**< Last column must be inside a congestion zone */
+        Outside     /**< Last column must be outside every congestion zone */
+    };
+
+    /**
+     * @brief Declarative scan query.
+     *
+     * Every enabled criterion must hold. Pattern and signal criteria look at
+     * the trailing lookback columns. Without Indicators, congestion,
+     * support/resistance and the patterns a catapult builds on are derived
+     * from the trailing context_columns only, so they cost
+     * O(context_columns) per symbol. All other criteria look at
+     * the last column.
+     */
+    struct ScanQuery {
+        std::vector<PatternType> patterns{};            /**< Any of these patterns; empty disables */
+        SignalType signal = SignalType::None;           /**< Required signal; None disables */
+        int lookback = 1;                               /**< Trailing columns searched for patterns and signals */
+        int context_columns = 50;                       /**< Trailing columns for congestion, support/resistance and pattern setups without Indicators; 0 uses the whole chart */
+        ScanBias bias = ScanBias::Any;                  /**< Trend-line bias */
+        bool above_bullish_support = false;             /**< Last price above the bullish support line */
+        bool below_bearish_resistance = false;          /**< Last price below the bearish resistance line */
+        double near_support = 0.0;                      /**< Max relative distance to a support level; 0 disables */
+        double near_resistance = 0.0;                   /**< Max relative distance to a resistance level; 0 disables */
+        ScanCongestion congestion = ScanCongestion::Any; /**< Congestion membership */
+        double rsi_min = 0.0;                           /**< Minimum RSI of the last column */
+        double rsi_max = 100.0;                         /**< Maximum RSI of the last column */
+        int rsi_period = 14;                            /**< RSI period when no Indicators are attached */
+        int min_columns = 0;                            /**< Minimum chart length */
+        size_t limit = 0;                               /**< Maximum matches returned; 0 for all */
+    };
+
+    /**
+     * @brief A symbol that satisfied a query.
+     */
+    struct ScanMatch {
+        size_t index{};                             /**< Index of the symbol in the scanner */
+        std::string symbol{};                       /**< Symbol name */
+        double score{};                             /**< Ranking score (breakout strength in boxes) */
+        int column{};                               /**< Last column index */
+        double price{};                             /**< Last column extreme in its direction */
+        PatternType pattern = PatternType::None;    /**< Most recent matching pattern, if requested */
+        SignalType signal = SignalType::None;       /**< Most recent matching signal, if requested */
+    };
+
+    /**
+     * @brief A ScanQuery lowered to an ordered list of predicate steps.
+     *
+     * Steps run cheapest first and stop at the first failure, so most symbols
+     * are rejected after touching only their last column. When an Indicators
+     * instance is supplied its stored results are used; otherwise the trailing
+     * lookback or context_columns columns are evaluated directly from the chart.
+     */
+    class CompiledScanQuery {
+    public:
+        explicit CompiledScanQuery(const ScanQuery& query);
+
+        /**
+         * @brief Evaluates the query against one chart.
+         *
+         * @param chart Chart to test
+         * @param indicators Precomputed indicators for the chart, or nullptr
+         * @param match Filled with match details on success
+         * @return true if every step passed
+         */
+        bool evaluate(const Chart& chart, const Indicators* indicators, ScanMatch& match) const;
+
+        [[nodiscard]] const ScanQuery& query() const { return query_; }
+        [[nodiscard]] size_t step_count() const { return steps_.size(); }
+
+    private:
+        /**
+         * @brief Predicate step kinds, in evaluation order.
+         */
+        enum class Step {
+            MinColumns,
+            Bias,
+            AboveSupport,
+            BelowResistance,
+            Signal,
+            Rsi,
+            Congestion,
+            NearSupport,
+            NearResistance,
+            Pattern
+        };
+
+        bool run_step(Step step, const Chart& chart, const Indicators* indicators, ScanMatch& match) const;
+        bool match_signal(const Chart& chart, const Indicators* indicators, ScanMatch& match) const;
+        size_t context_start(const Chart& chart) const;
+        bool match_pattern(const Chart& chart, const Indicators* indicators, ScanMatch& match) const;
+        bool wants_pattern(PatternType type) const;
+
+        ScanQuery query_;               /**< Source query */
+        std::vector<Step> steps_;       /**< Enabled steps, cheapest first */
+        uint32_t pattern_mask_ = 0;     /**< Bit per requested PatternType */
+    };
+
+    /**
+     * @brief Scans many charts in parallel and ranks the matches.
+     *
+     * Charts and indicators are referenced, not owned, and must outlive the
+     * scanner (or be removed with clear()). They must not be mutated while a
+     * scan runs.
+     */
+    class Scanner {
+    public:
+        /**
+         * @brief Creates a scanner that runs on an existing pool.
+         *
+         * @param pool Pool to run on, or nullptr to scan on the calling thread
+         */
+        explicit Scanner(ThreadPool* pool = nullptr);
+
+        /**
+         * @brief Creates a scanner that owns its pool.
+         *
+         * @param threads Worker count; 0 uses hardware concurrency, 1 scans on the calling thread
+         */
+        explicit Scanner(size_t threads);
+
+        /**
+         * @brief Adds a symbol to the scan universe.
+         *
+         * @param symbol Symbol name
+         * @param chart Symbol's chart
+         * @param indicators Precomputed indicators, or nullptr
+         * @return Index of the symbol
+         */
+        size_t add(const std::string& symbol, const Chart& chart, const Indicators* indicators = nullptr);
+
+        /**
+         * @brief Runs a query over every symbol.
+         *
+         * @param query Query to run
+         * @return Matches sorted by descending score, then by index
+         */
+        [[nodiscard]] std::vector<ScanMatch> scan(const ScanQuery& query) const;
+        [[nodiscard]] std::vector<ScanMatch> scan(const CompiledScanQuery& query) const;
+
+        [[nodiscard]] size_t size() const { return entries_.size(); }
+        [[nodiscard]] const std::string& symbol(size_t index) const { return entries_[index].symbol; }
+        void clear() { entries_.clear(); }
+
+    private:
+        /**
+         * @brief One symbol in the universe.
+         */
+        struct Entry {
+            std::string symbol;             /**< Symbol name */
+            const Chart* chart;             /**< Chart (not owned) */
+            const Indicators* indicators;   /**< Indicators (not owned), may be null */
+        };
+
+        std::vector<Entry> entries_;                /**< Scan universe */
+        std::unique_ptr<ThreadPool> owned_pool_;    /**< Pool owned by this scanner, if any */
+        ThreadPool* pool_;                          /**< Pool used for scans, may be null */
+    };
+} // namespace pnf
+
+#endif //SCANNER_HPP
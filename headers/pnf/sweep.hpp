@@ -0,0 +1,139 @@
+/// \file sweep.hpp
+/// \brief Parallel parameter sweeps over chart configurations.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#ifndef SWEEP_HPP
+#define SWEEP_HPP
+
+#include "chart.hpp"
+#include "thread_pool.hpp"
+#include <vector>
+#include <memory>
+
+namespace pnf {
+    /**
+     * @brief Cartesian grid of chart configurations.
+     *
+     * Every combination of the listed values becomes one ChartConfig.
+     */
+    struct SweepGrid {
+        std::vector<double> box_sizes{0.0};                                         /**< Box sizes (or percentages) */
+        std::vector<BoxSizeMethod> box_size_methods{BoxSizeMethod::Traditional};    /**< Box size methods */
+        std::vector<int> reversals{3};                                              /**< Reversal amounts */
+        std::vector<ConstructionMethod> methods{ConstructionMethod::Close};         /**< Construction methods */
+
+        /**
+         * @brief Expands the grid into a flat list of configurations.
+         *
+         * Ordering is methods, then box size methods, then box sizes, then
+         * reversals, with reversals varying fastest.
+         *
+         * @return Vector of ChartConfig
+         */
+        [[nodiscard]] std::vector<ChartConfig> configs() const;
+
+        /**
+         * @brief Returns the number of configurations in the grid.
+         *
+         * @return Grid size
+         */
+        [[nodiscard]] size_t size() const;
+    };
+
+    /**
+     * @brief Selects which indicators a sweep evaluates per chart.
+     */
+    struct SweepOptions {
+        bool signals = true;     /**< Run SignalDetector */
+        bool patterns = true;    /**< Run PatternRecognizer */
+        bool objectives = true;  /**< Run PriceObjectiveCalculator and score hits */
+        size_t threads = 0;      /**< Worker count for an owned pool; 0 uses hardware concurrency */
+    };
+
+    /**
+     * @brief Summary row produced for one configuration.
+     */
+    struct SweepResult {
+        ChartConfig config{};           /**< Configuration that produced the row */
+        int column_count{};             /**< Total columns */
+        int x_column_count{};           /**< X columns */
+        int o_column_count{};           /**< O columns */
+        int buy_signals{};              /**< Buy signals */
+        int sell_signals{};             /**< Sell signals */
+        int pattern_count{};            /**< Detected patterns */
+        int bullish_patterns{};         /**< Bullish patterns */
+        int bearish_patterns{};         /**< Bearish patterns */
+        int objective_count{};          /**< Vertical-count objectives */
+        int objectives_hit{};           /**< Objectives reached by a later column */
+        double objective_hit_rate{};    /**< objectives_hit / objective_count, 0 when none */
+        double box_size{};              /**< Box size in effect after the last bar */
+    };
+
+    /**
+     * @brief Builds and scores many charts from one bar series in parallel.
+     *
+     * The bar series is shared read-only between workers; each configuration
+     * builds its own Chart and indicators, so no synchronisation is needed
+     * beyond the pool itself. Results are returned in configuration order.
+     */
+    class ParameterSweep {
+    public:
+        /**
+         * @brief Creates a sweep that owns its thread pool.
+         *
+         * @param options Indicator selection and worker count
+         */
+        explicit ParameterSweep(const SweepOptions& options = {});
+
+        /**
+         * @brief Creates a sweep that runs on an existing pool.
+         *
+         * @param pool Pool to run on; must outlive the sweep
+         * @param options Indicator selection (threads is ignored)
+         */
+        explicit ParameterSweep(ThreadPool& pool, const SweepOptions& options = {});
+
+        /**
+         * @brief Runs every configuration against the bar series.
+         *
+         * @param bars Input bars, in time order
+         * @param configs Configurations to evaluate
+         * @return One SweepResult per configuration, in the same order
+         */
+        [[nodiscard]] std::vector<SweepResult> run(const std::vector<OHLC>& bars,
+                                                   const std::vector<ChartConfig>& configs) const;
+
+        /**
+         * @brief Runs every configuration of a grid against the bar series.
+         *
+         * @param bars Input bars, in time order
+         * @param grid Configuration grid
+         * @return One SweepResult per grid entry, in SweepGrid::configs() order
+         */
+        [[nodiscard]] std::vector<SweepResult> run(const std::vector<OHLC>& bars, const SweepGrid& grid) const;
+
+        /**
+         * @brief Builds and scores a single configuration on the calling thread.
+         *
+         * @param bars Input bars, in time order
+         * @param config Chart configuration
+         * @param options Indicator selection
+         * @return Summary row
+         */
+        [[nodiscard]] static SweepResult evaluate(const std::vector<OHLC>& bars, const ChartConfig& config,
+                                                  const SweepOptions& options = {});
+
+        [[nodiscard]] const SweepOptions& options() const { return options_; }
+        void set_options(const SweepOptions& options) { options_ = options; }
+
+    private:
+        SweepOptions options_;                    /**< Indicator selection */
+        std::unique_ptr<ThreadPool> owned_pool_;  /**< Pool owned by this sweep, if any */
+        ThreadPool* pool_;                        /**< Pool used for run() */
+    };
+} // namespace pnf
+
+#endif //SWEEP_HPP
@@ -0,0 +1,112 @@
+/// \file thread_pool.hpp
+/// \brief Work-stealing thread pool used by batch APIs.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pnf {
+    /**
+     * @brief Fixed-size work-stealing thread pool.
+     *
+     * Each worker owns a task deque. Workers pop from the back of their own
+     * deque and steal from the front of other deques when idle, so uneven
+     * task costs (for example charts with very different box sizes) balance
+     * out without a central queue becoming a bottleneck.
+     */
+    class ThreadPool {
+    public:
+        /**
+         * @brief Starts the worker threads.
+         *
+         * @param threads Number of workers; 0 uses the hardware concurrency
+         */
+        explicit ThreadPool(size_t threads = 0);
+
+        /**
+         * @brief Drains outstanding tasks and joins the workers.
+         */
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /**
+         * @brief Returns the number of worker threads.
+         *
+         * @return Worker count
+         */
+        [[nodiscard]] size_t size() const { return threads_.size(); }
+
+        /**
+         * @brief Queues a task for execution.
+         *
+         * Tasks submitted from a worker go to that worker's own deque.
+         *
+         * @param task Callable to run
+         */
+        void submit(std::function<void()> task);
+
+        /**
+         * @brief Blocks until every submitted task has finished.
+         *
+         * The calling thread executes queued tasks while it waits. Rethrows
+         * the first exception raised by a task submitted with submit().
+         */
+        void wait();
+
+        /**
+         * @brief Runs body(i) for every i in [0, count) and waits for completion.
+         *
+         * The range is split into chunks that are distributed over the workers;
+         * the caller participates, so nested calls from a worker cannot deadlock.
+         * Rethrows the first exception raised by body.
+         *
+         * @param count Number of iterations
+         * @param body Iteration callable
+         */
+        void parallel_for(size_t count, const std::function<void(size_t)>& body);
+
+    private:
+        /**
+         * @brief Per-worker task deque.
+         */
+        struct WorkQueue {
+            std::mutex mutex;                          /**< Guards tasks */
+            std::deque<std::function<void()>> tasks;   /**< Pending tasks */
+        };
+
+        void push(std::function<void()> task);
+        bool pop_local(size_t index, std::function<void()>& task);
+        bool steal(size_t thief, std::function<void()>& task);
+        bool run_pending_task();
+        void worker_loop(size_t index);
+
+        std::vector<std::unique_ptr<WorkQueue>> queues_; /**< One deque per worker */
+        std::vector<std::thread> threads_;               /**< Worker threads */
+        std::mutex wake_mutex_;                          /**< Guards sleeping workers */
+        std::condition_variable wake_;                   /**< Signals queued work or shutdown */
+        std::condition_variable idle_;                   /**< Signals that in_flight_ reached zero */
+        std::atomic<size_t> queued_{0};                  /**< Tasks waiting in any deque */
+        std::atomic<size_t> in_flight_{0};               /**< Submitted tasks not yet finished */
+        std::atomic<size_t> next_queue_{0};              /**< Round-robin cursor for external submits */
+        std::exception_ptr error_;                       /**< First exception from submit() tasks */
+        bool stop_ = false;                              /**< Shutdown flag */
+    };
+} // namespace pnf
+
+#endif //THREAD_POOL_HPP
@@ -0,0 +1,134 @@
+/// \file timeframe.hpp
+/// \brief Multi-timeframe chart construction from a single base stream.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#ifndef TIMEFRAME_HPP
+#define TIMEFRAME_HPP
+
+#include "chart.hpp"
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace pnf {
+    /**
+     * @brief One target timeframe.
+     */
+    struct TimeframeSpec {
+        std::string name{};                 /**< Label, e.g. "H1" */
+        std::chrono::seconds period{60};    /**< Bar length; buckets are aligned to the Unix epoch (UTC) */
+        ChartConfig chart{};                /**< Chart configuration for this timeframe */
+    };
+
+    /**
+     * @brief Read-only view of one timeframe handed to snapshot callbacks.
+     */
+    struct TimeframeView {
+        const TimeframeSpec* spec;  /**< Timeframe definition */
+        const Chart* chart;         /**< Chart built from completed bars */
+        const OHLC* forming;        /**< Bar still being aggregated, or nullptr */
+        size_t completed_bars;      /**< Bars fed into the chart so far */
+    };
+
+    /**
+     * @brief Resamples one base stream into several timeframes in a single pass.
+     *
+     * Every tick (or base bar) is folded into the forming bar of each
+     * timeframe in place; when a tick falls into a new bucket the finished bar
+     * is fed to that timeframe's Chart. No intermediate bar vectors are kept.
+     * Writers and snapshot() readers are serialised, so a snapshot always sees
+     * every timeframe at the same input position.
+     */
+    class MultiTimeframeChart {
+    public:
+        /**
+         * @brief Creates the timeframe charts.
+         *
+         * @param specs Target timeframes; periods below one second are clamped to one second
+         */
+        explicit MultiTimeframeChart(const std::vector<TimeframeSpec>& specs);
+
+        MultiTimeframeChart(const MultiTimeframeChart&) = delete;
+        MultiTimeframeChart& operator=(const MultiTimeframeChart&) = delete;
+
+        /**
+         * @brief Consumes one trade or quote.
+         *
+         * @param price Tick price
+         * @param volume Tick volume
+         * @param time Tick time; must not decrease
+         */
+        void add_tick(double price, double volume, Timestamp time);
+
+        /**
+         * @brief Consumes one base bar (e.g. M1) into every target timeframe.
+         *
+         * @param bar Base bar; its time is the bar's open time
+         */
+        void add_bar(const OHLC& bar);
+
+        /**
+         * @brief Feeds every forming bar to its chart and starts fresh buckets.
+         */
+        void flush();
+
+        /**
+         * @brief Calls fn with a consistent view of every timeframe.
+         *
+         * The writer lock is held for the duration of the call, so fn should
+         * copy what it needs and return promptly.
+         *
+         * @param fn Callback receiving one view per timeframe and the last input time
+         */
+        void snapshot(const std::function<void(const std::vector<TimeframeView>&, Timestamp)>& fn) const;
+
+        [[nodiscard]] size_t timeframe_count() const { return frames_.size(); }
+        [[nodiscard]] const TimeframeSpec& spec(size_t index) const { return frames_[index].spec; }
+
+        /**
+         * @brief Returns a timeframe's chart without locking.
+         *
+         * Only safe when no other thread is writing; use snapshot() otherwise.
+         *
+         * @param index Timeframe index
+         * @return Chart reference
+         */
+        [[nodiscard]] const Chart& chart(size_t index) const { return *frames_[index].chart; }
+
+        /**
+         * @brief Looks up a timeframe by name.
+         *
+         * @param name Timeframe label
+         * @return Index, or timeframe_count() if not found
+         */
+        [[nodiscard]] size_t find(const std::string& name) const;
+
+    private:
+        /**
+         * @brief Aggregation state for one timeframe.
+         */
+        struct Frame {
+            TimeframeSpec spec;             /**< Definition */
+            std::unique_ptr<Chart> chart;   /**< Chart fed with completed bars */
+            OHLC forming{};                 /**< Bar being aggregated */
+            int64_t bucket = 0;             /**< Bucket index of the forming bar */
+            bool has_forming = false;       /**< Whether forming holds data */
+            size_t completed = 0;           /**< Bars fed into the chart */
+        };
+
+        void fold(Frame& frame, const OHLC& bar);
+        static void close_bar(Frame& frame);
+
+        std::vector<Frame> frames_;     /**< One entry per timeframe */
+        Timestamp last_time_{};         /**< Time of the last input */
+        mutable std::mutex mutex_;      /**< Serialises writers and snapshots */
+    };
+} // namespace pnf
+
+#endif //TIMEFRAME_HPP
@@ -9,6 +9,10 @@
 #define TRENDLINE_HPP
 
 #include "column.hpp"
+#include <array>
+#include <memory>
+#include <memory_resource>
+#include <utility>
 #include <vector>
 
 namespace pnf {
@@ -20,7 +24,7 @@ namespace pnf {
         /**
          * @brief Constructs a new TrendLine.
          *
-         * @param type Type of trend line (BullishSupport or BearishResistance)
+         * @param type Type of trend line
          * @param start_column Index of the starting column
          * @param start_price Price at the start
          * @param start_box_index Index of the starting box in the column
@@ -71,6 +75,30 @@ namespace pnf {
          */
         TrendLineType type() const { return type_; }
 
+        /**
+         * @brief Gets the family the line type belongs to.
+         *
+         * @return TrendLineFamily
+         */
+        TrendLineFamily family() const;
+
+        /**
+         * @brief Checks whether the line slopes upwards (one box per column).
+         *
+         * @return true for bullish line types
+         */
+        bool is_rising() const;
+
+        /**
+         * @brief Checks whether price is expected to stay above the line.
+         *
+         * Support and internal lines hold price above them and break downwards
+         * in a bullish trend; channel lines sit on the opposite side.
+         *
+         * @return true if a break is a move below the line
+         */
+        bool holds_above() const;
+
         /**
          * @brief Gets the starting point of the trend line.
          *
@@ -99,6 +127,20 @@ namespace pnf {
          */
         void set_active(bool active) { active_ = active; }
 
+        /**
+         * @brief Deactivates the line and records the column that ended it.
+         *
+         * @param column Breaking (or retiring) column index
+         */
+        void mark_broken(int column) { active_ = false; break_column_ = column; }
+
+        /**
+         * @brief Returns the column that ended the line.
+         *
+         * @return Column index, or -1 while the line has not ended
+         */
+        int break_column() const { return break_column_; }
+
         /**
          * @brief Checks if the trend line was touched by price action.
          *
@@ -113,6 +155,13 @@ namespace pnf {
          */
         int touch_count() const { return touch_count_; }
 
+        /**
+         * @brief Returns the box size fixed when the line was drawn.
+         *
+         * @return Box size used for the line's slope
+         */
+        double box_size() const { return box_size_; }
+
         /**
          * @brief Returns a string representation of the trend line.
          *
@@ -128,10 +177,73 @@ namespace pnf {
         bool active_;           /**< Whether the trend line is active */
         bool touched_;          /**< Whether it has been touched by price */
         int touch_count_;       /**< Number of touches */
+        int break_column_ = -1; /**< Column that broke the line, -1 if unbroken */
     };
 
+    /**
+     * @brief Interval of columns governed by one trend line.
+     *
+     * The line governs columns from from_column up to, but not including,
+     * its break column (or every later column if it is still unbroken).
+     */
+    struct TrendLineSpan {
+        int from_column;        /**< Column at which the line became active */
+        const TrendLine* line;  /**< Governing line, owned by the manager */
+    };
+
+    /**
+     * @brief Break, touch, or draw event on a trend line.
+     */
+    struct TrendLineEvent {
+        TrendLineEventType type;    /**< What happened */
+        int column;                 /**< Column at which it happened */
+        const TrendLine* line;      /**< Line concerned, owned by the manager */
+    };
+
+    /**
+     * @brief Saved TrendLineManager state for rolling back to an earlier column.
+     *
+     * Lines, events, history spans and pivots are only ever appended, so most
+     * of the state is a set of lengths. Only the live lines (active, internal
+     * and channel) can still change, and those are copied by value.
+     */
+    struct TrendLineCheckpoint {
+        size_t lines = 0;                          /**< Lines drawn so far */
+        size_t events = 0;                         /**< Events emitted so far */
+        std::array<size_t, 3> history{};           /**< Span count per family */
+        size_t pivot_lows = 0;                     /**< Significant lows found so far */
+        size_t pivot_highs = 0;                    /**< Significant highs found so far */
+        int indexed = 0;                           /**< Columns already classified */
+        int active = -1;                           /**< Index of the active line, -1 if none */
+        int internal = -1;                         /**< Index of the internal line, -1 if none */
+        int channel = -1;                          /**< Index of the channel line, -1 if none */
+        int parent = -1;                           /**< Index of the secondary lines' primary, -1 if none */
+        std::vector<std::pair<int, TrendLine>> live; /**< Copies of the lines that may still change */
+        double box_size = 0.0;                     /**< Fallback box size */
+        int internal_pivot = -1;                   /**< Latest pivot used for an internal line */
+        int hull_indexed = 0;                      /**< Columns folded into the channel hull */
+        int hull_column = -1;                      /**< Column with the extreme slope-adjusted price */
+        double hull_offset = 0.0;                  /**< Extreme price minus (plus) slope * distance */
+    };
+
+    /**
+     * @brief Returns a trend line to the memory resource it was allocated from.
+     */
+    struct TrendLineDeleter {
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource(); /**< Owning resource */
+
+        void operator()(TrendLine* line) const {
+            std::pmr::polymorphic_allocator<TrendLine>(resource).delete_object(line);
+        }
+    };
+
+    using TrendLinePtr = std::unique_ptr<TrendLine, TrendLineDeleter>; /**< Owning trend line pointer */
+
     /**
      * @brief Manages all trend lines in a Point & Figure chart.
+     *
+     * Lines, pivots, history spans and events grow with the column count, so
+     * they are all allocated from the manager's memory resource.
      */
     class TrendLineManager {
     public:
@@ -139,16 +251,34 @@ namespace pnf {
          * @brief Constructs a TrendLineManager.
          *
          * @param box_size Box size used for trend line calculations
+         * @param resource Memory resource for lines and bookkeeping; nullptr uses the default resource
          */
-        explicit TrendLineManager(double box_size);
+        explicit TrendLineManager(double box_size,
+                                  std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+        /**
+         * @brief Deep-copies another manager into its memory resource.
+         *
+         * @param other Manager to copy
+         */
+        TrendLineManager(const TrendLineManager& other);
+
+        /**
+         * @brief Deep-copies another manager; events and history refer to the copied lines.
+         *
+         * @param other Manager to copy
+         * @param resource Memory resource for the copy; nullptr uses the default resource
+         */
+        TrendLineManager(const TrendLineManager& other, std::pmr::memory_resource* resource);
+        TrendLineManager& operator=(const TrendLineManager&) = delete;
 
         /**
          * @brief Updates trend lines based on the latest column data.
          *
-         * @param columns Vector of column pointers
+         * @param columns Chart columns
          * @param new_column_index Index of the newly added column
          */
-        void update(const std::vector<std::unique_ptr<Column>>& columns, int new_column_index);
+        void update(const ColumnList& columns, int new_column_index);
 
         /**
          * @brief Processes a new column to update trend lines.
@@ -156,7 +286,7 @@ namespace pnf {
          * @param columns Vector of columns
          * @param column_index Index of the new column
          */
-        void process_new_column(const std::vector<std::unique_ptr<Column>>& columns, int column_index);
+        void process_new_column(const ColumnList& columns, int column_index);
 
         /**
          * @brief Checks if any trend lines have been broken at the given column.
@@ -164,7 +294,7 @@ namespace pnf {
          * @param columns Vector of columns
          * @param column_index Column index to check
          */
-        void check_break(const std::vector<std::unique_ptr<Column>>& columns, int column_index) const;
+        void check_break(const ColumnList& columns, int column_index);
 
         /**
          * @brief Returns the currently active trend line.
@@ -176,16 +306,96 @@ namespace pnf {
         /**
          * @brief Access all trend lines for modification.
          *
-         * @return Vector of unique pointers to TrendLine objects
+         * @return Vector of owning pointers to TrendLine objects
          */
-        std::vector<std::unique_ptr<TrendLine>>& all_trend_lines() { return lines_; }
+        std::pmr::vector<TrendLinePtr>& all_trend_lines() { return lines_; }
 
         /**
          * @brief Access all trend lines for read-only operations.
          *
          * @return Constant reference to the vector of TrendLine pointers
          */
-        const std::vector<std::unique_ptr<TrendLine>>& all_trend_lines() const { return lines_; }
+        const std::pmr::vector<TrendLinePtr>& all_trend_lines() const { return lines_; }
+
+        /**
+         * @brief Returns the indices of significant low columns found so far, ascending.
+         *
+         * Maintained incrementally as columns are finalised (every column before
+         * the one passed to update()).
+         *
+         * @return Column indices
+         */
+        const std::pmr::vector<int>& significant_lows() const { return pivot_lows_; }
+
+        /**
+         * @brief Returns the indices of significant high columns found so far, ascending.
+         *
+         * @return Column indices
+         */
+        const std::pmr::vector<int>& significant_highs() const { return pivot_highs_; }
+
+        /**
+         * @brief Returns every line of a family that has been active, ordered by activation column.
+         *
+         * @param family Line family
+         * @return Spans in ascending from_column order
+         */
+        const std::pmr::vector<TrendLineSpan>& history(TrendLineFamily family = TrendLineFamily::Primary) const {
+            return history_[static_cast<size_t>(family)];
+        }
+
+        /**
+         * @brief Returns the line of a family that governed a column, in O(log n).
+         *
+         * For the primary family the answer matches active_trend_line() as it
+         * stood right after the column was created, so the chart need not be
+         * replayed.
+         *
+         * @param column Column index
+         * @param family Line family
+         * @return Governing line, or nullptr if no line was active
+         */
+        const TrendLine* line_at(int column, TrendLineFamily family = TrendLineFamily::Primary) const;
+
+        /**
+         * @brief Returns the live internal line, if any.
+         *
+         * @return Internal line, or nullptr
+         */
+        const TrendLine* internal_line() const { return internal_; }
+
+        /**
+         * @brief Returns the live channel line, if any.
+         *
+         * @return Channel line, or nullptr
+         */
+        const TrendLine* channel_line() const { return channel_; }
+
+        /**
+         * @brief Returns every draw, touch, and break event so far, in column order.
+         *
+         * The list only grows between clear() calls, so callers can keep the
+         * size they last saw and read new events from there.
+         *
+         * @return Events
+         */
+        const std::pmr::vector<TrendLineEvent>& events() const { return events_; }
+
+        /**
+         * @brief Checks whether a column was governed by a bullish support line.
+         *
+         * @param column Column index
+         * @return true if bullish bias held at the column
+         */
+        bool bullish_bias_at(int column) const;
+
+        /**
+         * @brief Checks whether a column was governed by a bearish resistance line.
+         *
+         * @param column Column index
+         * @return true if bearish bias held at the column
+         */
+        bool bearish_bias_at(int column) const;
 
         /**
          * @brief Checks if a price is above the nearest bullish support trend line.
@@ -225,7 +435,27 @@ namespace pnf {
         void clear();
 
         /**
-         * @brief Update the box size used for trend line calculations.
+         * @brief Saves the current state for a later restore().
+         *
+         * @return Checkpoint holding lengths and copies of the live lines
+         */
+        TrendLineCheckpoint checkpoint() const;
+
+        /**
+         * @brief Rolls back to a checkpoint taken from this manager (or the one it was copied from).
+         *
+         * Lines drawn after the checkpoint are destroyed, so pointers to them
+         * become invalid.
+         *
+         * @param checkpoint State returned by checkpoint()
+         */
+        void restore(const TrendLineCheckpoint& checkpoint);
+
+        /**
+         * @brief Update the fallback box size for new trend lines.
+         *
+         * Lines already drawn keep their own box size; new lines use their
+         * anchor column's box size when it is recorded.
          *
          * @param box_size New box size
          */
@@ -240,22 +470,32 @@ namespace pnf {
 
     private:
         /**
-         * @brief Finds a significant low starting from a specific column.
+         * @brief Finds the latest significant low at or before a column.
          *
          * @param columns Vector of columns
          * @param from Column index to start search
-         * @return Index of the significant low column
+         * @return Index of the significant low column, or -1
          */
-        static int find_significant_low(const std::vector<std::unique_ptr<Column>>& columns, int from);
+        int find_significant_low(const ColumnList& columns, int from);
 
         /**
-         * @brief Finds a significant high starting from a specific column.
+         * @brief Finds the latest significant high at or before a column.
          *
          * @param columns Vector of columns
          * @param from Column index to start search
-         * @return Index of the significant high column
+         * @return Index of the significant high column, or -1
          */
-        static int find_significant_high(const std::vector<std::unique_ptr<Column>>& columns, int from);
+        int find_significant_high(const ColumnList& columns, int from);
+
+        /**
+         * @brief Classifies every not yet indexed column up to a given index.
+         *
+         * Each column is examined once, so pivot lookups are O(1) amortised.
+         *
+         * @param columns Vector of columns
+         * @param through Last column index to index
+         */
+        void index_pivots(const ColumnList& columns, int through);
 
         /**
          * @brief Checks if a column is a significant low relative to surrounding columns.
@@ -265,7 +505,7 @@ namespace pnf {
          * @param index Index of the column
          * @return true if significant low
          */
-        static bool is_significant_low(const Column* col, const std::vector<std::unique_ptr<Column>>& all, int index);
+        static bool is_significant_low(const Column* col, const ColumnList& all, int index);
 
         /**
          * @brief Checks if a column is a significant high relative to surrounding columns.
@@ -275,11 +515,82 @@ namespace pnf {
          * @param index Index of the column
          * @return true if significant high
          */
-        static bool is_significant_high(const Column* col, const std::vector<std::unique_ptr<Column>>& all, int index);
+        static bool is_significant_high(const Column* col, const ColumnList& all, int index);
+
+        /**
+         * @brief Returns the box size a new line anchored at a column should use.
+         *
+         * @param anchor Anchor column
+         * @return Column box size, or the manager's box size if not recorded
+         */
+        double line_box_size(const Column* anchor) const;
+
+        /**
+         * @brief Takes ownership of a new line and records it in its family's history.
+         *
+         * @param line New trend line
+         * @param column Column at which the line becomes active
+         * @return The stored line
+         */
+        TrendLine* activate(TrendLinePtr line, int column);
+
+        /**
+         * @brief Allocates a trend line from the manager's memory resource.
+         *
+         * @param args TrendLine constructor arguments
+         * @return Owning pointer to the new line
+         */
+        template <typename... Args>
+        TrendLinePtr make_line(Args&&... args) const {
+            std::pmr::memory_resource* resource = lines_.get_allocator().resource();
+            std::pmr::polymorphic_allocator<TrendLine> alloc(resource);
+            return TrendLinePtr(alloc.new_object<TrendLine>(std::forward<Args>(args)...), TrendLineDeleter{resource});
+        }
+
+        /**
+         * @brief Ends a line at a column and emits a break event.
+         *
+         * @param line Line to end
+         * @param column Breaking column index
+         */
+        void break_line(TrendLine* line, int column);
+
+        /**
+         * @brief Tests a live line against a column extreme, emitting break or touch events.
+         *
+         * @param line Line to test
+         * @param column Column index
+         * @param price Column extreme on the line's break side
+         * @return true if the line was broken
+         */
+        bool test_line(TrendLine* line, int column, double price);
+
+        /**
+         * @brief Maintains the internal and channel lines of the active primary line.
+         *
+         * Folds finalised columns into the channel hull, then re-draws, tests,
+         * or retires the secondary lines against the new column.
+         *
+         * @param columns Vector of columns
+         * @param column_index Index of the new column
+         */
+        void update_secondary(const ColumnList& columns, int column_index);
 
-        std::vector<std::unique_ptr<TrendLine>> lines_; /**< All trend lines managed */
+        std::pmr::vector<TrendLinePtr> lines_;           /**< All trend lines managed */
         TrendLine* active_;                              /**< Currently active trend line */
         double box_size_;                                /**< Box size used for trend line calculations */
+        std::pmr::vector<int> pivot_lows_;               /**< Significant low column indices, ascending */
+        std::pmr::vector<int> pivot_highs_;              /**< Significant high column indices, ascending */
+        int indexed_ = 0;                                /**< Columns already classified */
+        std::array<std::pmr::vector<TrendLineSpan>, 3> history_; /**< Activation spans per family, ascending */
+        std::pmr::vector<TrendLineEvent> events_;        /**< Draw, touch, and break events */
+        TrendLine* internal_ = nullptr;                  /**< Live internal line */
+        TrendLine* channel_ = nullptr;                   /**< Live channel line */
+        const TrendLine* parent_ = nullptr;              /**< Primary line the secondary lines belong to */
+        int internal_pivot_ = -1;                        /**< Latest pivot used for an internal line */
+        int hull_indexed_ = 0;                           /**< Columns folded into the channel hull */
+        int hull_column_ = -1;                           /**< Column with the extreme slope-adjusted price */
+        double hull_offset_ = 0.0;                       /**< Extreme price minus (plus) slope * distance */
     };
 } // namespace pnf
 
@@ -29,12 +29,33 @@ namespace pnf {
     /**
      * @brief Methods for determining box size.
      */
-    enum class BoxSizeMethod { Fixed, Traditional, Percentage, Points };
+    enum class BoxSizeMethod { Fixed, Traditional, Percentage, Points, ATR, Logarithmic };
 
     /**
      * @brief Types of trend lines.
+     *
+     * Internal lines are 45-degree lines through pivots inside the primary
+     * trend; channel lines run parallel to the primary line on the opposite
+     * side of price.
+     */
+    enum class TrendLineType {
+        BullishSupport,
+        BearishResistance,
+        BullishInternal,
+        BearishInternal,
+        BullishChannel,
+        BearishChannel
+    };
+
+    /**
+     * @brief Families of trend lines tracked by TrendLineManager, each with its own history.
+     */
+    enum class TrendLineFamily { Primary, Internal, Channel };
+
+    /**
+     * @brief Trend line events emitted as columns are added.
      */
-    enum class TrendLineType { BullishSupport, BearishResistance };
+    enum class TrendLineEventType { Drawn, Touched, Broken };
 
     /**
      * @brief Types of trading signals.
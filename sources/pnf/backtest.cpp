@@ -0,0 +1,218 @@
+/// \file backtest.cpp
+/// \brief Backtester implementation.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#include "pnf/backtest.hpp"
+#include <algorithm>
+
+namespace pnf {
+    Backtester::Backtester(const BacktestConfig& config) : config_(config) {
+        reset();
+    }
+
+    void Backtester::set_config(const BacktestConfig& config) {
+        config_ = config;
+        reset();
+    }
+
+    void Backtester::reset() {
+        chart_ = std::make_unique<Chart>(config_.chart);
+        recognizer_.clear();
+        result_ = {};
+        open_trade_ = {};
+        in_position_ = false;
+        realized_ = 0.0;
+        peak_equity_ = config_.initial_equity;
+        last_entry_column_ = -1;
+        seen_columns_ = 0;
+        seen_boxes_ = 0;
+        bar_index_ = 0;
+        last_bar_ = {};
+    }
+
+    void Backtester::on_bar(const OHLC& bar) {
+        if (in_position_) check_exits(bar);
+
+        chart_->add_ohlc(bar);
+
+        // Rules only depend on chart structure, so unchanged bars skip evaluation.
+        const size_t columns = chart_->column_count();
+        const size_t boxes = columns > 0 ? chart_->last_column()->box_count() : 0;
+        if (columns != seen_columns_ || boxes != seen_boxes_) {
+            seen_columns_ = columns;
+            seen_boxes_ = boxes;
+            evaluate_entries(bar);
+        }
+
+        mark_to_market(bar.close);
+        last_bar_ = bar;
+        bar_index_++;
+    }
+
+    void Backtester::finish() {
+        if (!in_position_ || bar_index_ == 0) return;
+        const double fill = last_bar_.close + (open_trade_.is_long ? -config_.slippage : config_.slippage);
+        close_position(fill, TradeExitReason::EndOfData, bar_index_ - 1, last_bar_.time);
+        if (!result_.equity.empty()) {
+            result_.equity.pop_back();
+            mark_to_market(last_bar_.close);
+        }
+    }
+
+    BacktestResult Backtester::run(const std::vector<OHLC>& bars) {
+        reset();
+        result_.equity.reserve(bars.size());
+        for (const auto& bar : bars) {
+            on_bar(bar);
+        }
+        finish();
+        return result_;
+    }
+
+    std::vector<BacktestResult> Backtester::run_many(const std::vector<std::vector<OHLC>>& instruments,
+                                                     const BacktestConfig& config, ThreadPool& pool) {
+        std::vector<BacktestResult> results(instruments.size());
+        pool.parallel_for(instruments.size(), [&](const size_t i) {
+            Backtester backtester(config);
+            results[i] = backtester.run(instruments[i]);
+        });
+        return results;
+    }
+
+    void Backtester::check_exits(const OHLC& bar) {
+        const Trade& t = open_trade_;
+        if (t.is_long) {
+            if (t.stop_price > 0.0 && bar.low <= t.stop_price) {
+                close_position(std::min(bar.open, t.stop_price) - config_.slippage, TradeExitReason::Stop, bar_index_, bar.time);
+            } else if (t.target_price > 0.0 && bar.high >= t.target_price) {
+                close_position(std::max(bar.open, t.target_price) - config_.slippage, TradeExitReason::Target, bar_index_, bar.time);
+            }
+        } else {
+            if (t.stop_price > 0.0 && bar.high >= t.stop_price) {
+                close_position(std::max(bar.open, t.stop_price) + config_.slippage, TradeExitReason::Stop, bar_index_, bar.time);
+            } else if (t.target_price > 0.0 && bar.low <= t.target_price) {
+                close_position(std::min(bar.open, t.target_price) + config_.slippage, TradeExitReason::Target, bar_index_, bar.time);
+            }
+        }
+    }
+
+    void Backtester::evaluate_entries(const OHLC& bar) {
+        const int col = static_cast<int>(chart_->column_count()) - 1;
+        if (col < 0) return;
+
+        bool bullish = false;
+        bool bearish = false;
+        TradeTrigger trigger = TradeTrigger::Signal;
+
+        if (config_.trade_signals) {
+            const SignalType signal = SignalDetector::signal_at(*chart_, col);
+            bullish = signal == SignalType::Buy;
+            bearish = signal == SignalType::Sell;
+        }
+
+        PatternType pattern = PatternType::None;
+        if (config_.trade_patterns) {
+            // Earlier columns are final, so only the last one is rolled back and re-detected.
+            recognizer_.detect_from(*chart_, static_cast<size_t>(col));
+            if (!bullish && !bearish) {
+                const auto& patterns = recognizer_.patterns();
+                for (size_t i = patterns.size(); i > 0 && patterns[i - 1].end_column == col; i--) {
+                    const PatternType type = patterns[i - 1].type;
+                    const bool up = is_bullish_pattern(type);
+                    const bool down = is_bearish_pattern(type);
+                    if (pattern == PatternType::None && (up || down)) pattern = type;
+                    bullish = bullish || up;
+                    bearish = bearish || down;
+                }
+                // Conflicting patterns on one column carry no direction.
+                if (bullish && bearish) {
+                    bullish = bearish = false;
+                    pattern = PatternType::None;
+                }
+                if (pattern != PatternType::None) trigger = TradeTrigger::Pattern;
+            }
+        }
+
+        if (!bullish && !bearish) return;
+
+        if (in_position_ && config_.exit_on_opposite_signal && open_trade_.is_long == bearish) {
+            const double fill = bar.close + (open_trade_.is_long ? -config_.slippage : config_.slippage);
+            close_position(fill, TradeExitReason::OppositeSignal, bar_index_, bar.time);
+        }
+
+        if (in_position_ || col == last_entry_column_) return;
+
+        if (bullish) {
+            if (!config_.require_trend_bias || chart_->should_take_bullish_signals())
+                open_position(true, trigger, pattern, bar, col);
+        } else if (config_.allow_short) {
+            if (!config_.require_trend_bias || chart_->should_take_bearish_signals())
+                open_position(false, trigger, pattern, bar, col);
+        }
+    }
+
+    void Backtester::open_position(const bool is_long, const TradeTrigger trigger, const PatternType pattern,
+                                   const OHLC& bar, const int column) {
+        Trade t;
+        t.is_long = is_long;
+        t.trigger = trigger;
+        t.pattern = pattern;
+        t.entry_column = column;
+        t.entry_bar = bar_index_;
+        t.entry_time = bar.time;
+        t.entry_price = bar.close + (is_long ? config_.slippage : -config_.slippage);
+
+        if (config_.use_objective_targets) {
+            PriceObjectiveCalculator calculator;
+            calculator.calculate_vertical_count(*chart_, column);
+            if (const auto& objectives = calculator.objectives();
+                !objectives.empty() && objectives.back().is_bullish == is_long) {
+                t.target_price = objectives.back().target_price;
+            }
+        }
+
+        if (config_.stop_boxes > 0) {
+            const double distance = config_.stop_boxes * chart_->current_box_size();
+            t.stop_price = is_long ? t.entry_price - distance : t.entry_price + distance;
+        }
+
+        open_trade_ = t;
+        in_position_ = true;
+        last_entry_column_ = column;
+    }
+
+    void Backtester::close_position(const double price, const TradeExitReason reason,
+                                    const size_t bar_index, const Timestamp time) {
+        Trade t = open_trade_;
+        t.exit_reason = reason;
+        t.exit_bar = bar_index;
+        t.exit_time = time;
+        t.exit_price = price;
+        const double direction = t.is_long ? 1.0 : -1.0;
+        t.pnl = (t.exit_price - t.entry_price) * direction * config_.quantity - 2.0 * config_.commission;
+
+        realized_ += t.pnl;
+        result_.net_profit += t.pnl;
+        if (t.pnl > 0.0) result_.winning_trades++;
+        else result_.losing_trades++;
+        result_.trades.push_back(t);
+        result_.win_rate = static_cast<double>(result_.winning_trades) /
+                           static_cast<double>(result_.trades.size());
+
+        in_position_ = false;
+    }
+
+    void Backtester::mark_to_market(const double close) {
+        double equity = config_.initial_equity + realized_;
+        if (in_position_) {
+            const double direction = open_trade_.is_long ? 1.0 : -1.0;
+            equity += (close - open_trade_.entry_price) * direction * config_.quantity - config_.commission;
+        }
+        result_.equity.push_back(equity);
+        peak_equity_ = std::max(peak_equity_, equity);
+        result_.max_drawdown = std::max(result_.max_drawdown, peak_equity_ - equity);
+    }
+} // namespace pnf
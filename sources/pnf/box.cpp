@@ -10,13 +10,16 @@
 
 namespace pnf {
 
-    Box::Box(const double price, const BoxType type, std::string marker)
-        : price_(price), type_(type), marker_(std::move(marker)) {}
+    Box::Box(const double price, const BoxType type, const std::string_view marker)
+        : price_(price), type_(type), marker_(MarkerTable::intern(marker)) {}
+
+    Box::Box(const double price, const BoxType type, const MarkerId marker)
+        : price_(price), type_(type), marker_(marker) {}
 
     std::string Box::to_string() const {
         std::ostringstream oss;
         const char box_char = (type_ == BoxType::X) ? 'X' : 'O';
-        const std::string display = marker_.empty() ? std::string(1, box_char) : marker_;
+        const std::string display = marker_ == MarkerTable::none ? std::string(1, box_char) : marker();
         oss << price_ << display;
         return oss.str();
     }
@@ -0,0 +1,166 @@
+/// \file breadth.cpp
+/// \brief Market breadth implementation.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#include "pnf/breadth.hpp"
+#include <sstream>
+
+namespace pnf {
+    UniverseBullishPercent::UniverseBullishPercent(const ChartConfig& chart_config)
+        : chart_config_(chart_config), chart_(std::make_unique<Chart>(chart_config)) {
+        sectors_.push_back({});
+    }
+
+    ChartConfig UniverseBullishPercent::default_chart_config() {
+        ChartConfig cfg;
+        cfg.box_size_method = BoxSizeMethod::Fixed;
+        cfg.box_size = 2.0;
+        cfg.reversal = 3;
+        return cfg;
+    }
+
+    size_t UniverseBullishPercent::sector_slot(const std::string& sector) {
+        if (sector.empty()) return 0;
+        if (const auto it = sector_index_.find(sector); it != sector_index_.end()) return it->second;
+        const size_t slot = sectors_.size();
+        sectors_.push_back({sector, 0, 0, 0});
+        sector_index_.emplace(sector, slot);
+        return slot;
+    }
+
+    void UniverseBullishPercent::apply(const SymbolState& state, const int direction) {
+        SectorCounts& counts = sectors_[state.sector];
+        counts.symbols += direction;
+        if (state.signal == SignalType::Buy) {
+            buy_count_ += direction;
+            counts.buy += direction;
+        } else if (state.signal == SignalType::Sell) {
+            sell_count_ += direction;
+            counts.sell += direction;
+        }
+    }
+
+    void UniverseBullishPercent::add_symbol(const std::string& symbol, const std::string& sector) {
+        const size_t slot = sector_slot(sector);
+        if (const auto it = symbols_.find(symbol); it != symbols_.end()) {
+            apply(it->second, -1);
+            it->second.sector = slot;
+            apply(it->second, 1);
+            return;
+        }
+        const SymbolState state{SignalType::None, slot};
+        symbols_.emplace(symbol, state);
+        apply(state, 1);
+    }
+
+    bool UniverseBullishPercent::remove_symbol(const std::string& symbol) {
+        const auto it = symbols_.find(symbol);
+        if (it == symbols_.end()) return false;
+        apply(it->second, -1);
+        symbols_.erase(it);
+        return true;
+    }
+
+    bool UniverseBullishPercent::update(const std::string& symbol, const SignalType signal) {
+        auto it = symbols_.find(symbol);
+        if (it == symbols_.end()) {
+            add_symbol(symbol);
+            it = symbols_.find(symbol);
+        }
+        if (it->second.signal == signal) return false;
+        apply(it->second, -1);
+        it->second.signal = signal;
+        apply(it->second, 1);
+        return true;
+    }
+
+    bool UniverseBullishPercent::update(const std::string& symbol, const SignalDetector& detector) {
+        return update(symbol, detector.current_signal());
+    }
+
+    bool UniverseBullishPercent::update(const std::string& symbol, const Chart& chart) {
+        return update(symbol, latest_signal(chart));
+    }
+
+    SignalType UniverseBullishPercent::latest_signal(const Chart& chart) {
+        for (int i = static_cast<int>(chart.column_count()) - 1; i >= 2; i--) {
+            if (const SignalType s = SignalDetector::signal_at(chart, i); s != SignalType::None)
+                return s;
+        }
+        return SignalType::None;
+    }
+
+    bool UniverseBullishPercent::publish(const Timestamp time) {
+        return chart_->add_data(value(), time);
+    }
+
+    double UniverseBullishPercent::percent(const int buy, const int sell) {
+        const int total = buy + sell;
+        if (total == 0) return 50.0;
+        return (static_cast<double>(buy) / static_cast<double>(total)) * 100.0;
+    }
+
+    double UniverseBullishPercent::value() const {
+        return percent(buy_count_, sell_count_);
+    }
+
+    double UniverseBullishPercent::sector_value(const std::string& sector) const {
+        const auto it = sector_index_.find(sector);
+        if (it == sector_index_.end()) return 50.0;
+        const SectorCounts& counts = sectors_[it->second];
+        return percent(counts.buy, counts.sell);
+    }
+
+    std::vector<SectorBreadth> UniverseBullishPercent::sectors() const {
+        std::vector<SectorBreadth> result;
+        result.reserve(sectors_.size());
+        for (size_t i = 1; i < sectors_.size(); i++) {
+            const SectorCounts& c = sectors_[i];
+            if (c.symbols == 0) continue;
+            result.push_back({c.name, c.symbols, c.buy, c.sell, percent(c.buy, c.sell)});
+        }
+        return result;
+    }
+
+    SignalType UniverseBullishPercent::signal(const std::string& symbol) const {
+        const auto it = symbols_.find(symbol);
+        return it == symbols_.end() ? SignalType::None : it->second.signal;
+    }
+
+    bool UniverseBullishPercent::has_symbol(const std::string& symbol) const {
+        return symbols_.find(symbol) != symbols_.end();
+    }
+
+    void UniverseBullishPercent::set_thresholds(const double bullish, const double bearish) {
+        bullish_threshold_ = bullish;
+        bearish_threshold_ = bearish;
+    }
+
+    SignalType UniverseBullishPercent::chart_signal() const {
+        return latest_signal(*chart_);
+    }
+
+    void UniverseBullishPercent::clear() {
+        symbols_.clear();
+        sector_index_.clear();
+        sectors_.assign(1, {});
+        buy_count_ = 0;
+        sell_count_ = 0;
+        chart_ = std::make_unique<Chart>(chart_config_);
+    }
+
+    std::string UniverseBullishPercent::to_string() const {
+        std::ostringstream oss;
+        oss << "Universe Bullish Percent: " << value() << "% ("
+            << buy_count_ << " buy, " << sell_count_ << " sell, "
+            << symbols_.size() << " symbols)\n";
+        for (const auto& s : sectors()) {
+            oss << "  " << s.sector << ": " << s.value << "% ("
+                << s.buy_signals << "/" << s.symbols << ")\n";
+        }
+        return oss.str();
+    }
+} // namespace pnf
@@ -10,58 +10,69 @@
 #include <sstream>
 #include <ctime>
 #include <cmath>
+#include <limits>
 
 namespace pnf
 {
-    Chart::Chart(const ChartConfig& config) : config_(config), last_month_(-1), last_box_size_(config_.box_size) {
-        last_time_ = std::chrono::system_clock::now();
-        last_processed_time_ = std::chrono::system_clock::now();
-        trend_manager_ = std::make_unique<TrendLineManager>(config_.box_size);
-    }
+    namespace {
+        struct TraditionalBracket {
+            double upper;   // exclusive upper price bound
+            double box;     // box size inside the bracket
+        };
+
+        constexpr std::array<TraditionalBracket, 10> traditional_scale = {{
+            {0.25, 0.0625}, {1.0, 0.125}, {5.0, 0.25}, {20.0, 0.5}, {100.0, 1.0},
+            {200.0, 2.0}, {500.0, 4.0}, {1000.0, 5.0}, {25000.0, 50.0},
+            {std::numeric_limits<double>::infinity(), 500.0}
+        }};
+
+        int traditional_bracket(const double price) {
+            for (size_t i = 0; i + 1 < traditional_scale.size(); i++) {
+                if (price < traditional_scale[i].upper) return static_cast<int>(i);
+            }
+            return static_cast<int>(traditional_scale.size()) - 1;
+        }
 
-    std::string Chart::get_month_marker(const int month) {
-        if (month >= 1 && month <= 12)
-            return month_markers_[month - 1];
-        return "";
+        double bracket_floor(const int bracket) {
+            return bracket == 0 ? -std::numeric_limits<double>::infinity() : traditional_scale[bracket - 1].upper;
+        }
     }
 
-    bool Chart::has_month_changed(const Timestamp current, std::string& marker) const
-    {
-        std::time_t current_tt = std::chrono::system_clock::to_time_t(current);
-        std::tm current_tm{};
-#ifdef _WIN32
-        localtime_s(&current_tm, &current_tt);
-#else
-        localtime_r(&current_tt, &current_tm);
-#endif
-
-        if (last_processed_time_ == Timestamp{}) {
-            marker = get_month_marker(current_tm.tm_mon + 1);
-            return true;
-        }
+    Chart::Chart(const ChartConfig& config, std::pmr::memory_resource* resource)
+        : columns_(resource ? resource : std::pmr::get_default_resource()), config_(config), last_month_(-1),
+          last_box_size_(config_.box_size), log_grid_(config_.box_size), atr_bars_(columns_.get_allocator()),
+          column_highs_(columns_.get_allocator()), column_lows_(columns_.get_allocator()),
+          column_midpoints_(columns_.get_allocator()), price_ladder_(columns_.get_allocator()),
+          ladder_refs_(columns_.get_allocator()),
+          x_columns_(columns_.get_allocator()), o_columns_(columns_.get_allocator()),
+          mixed_columns_(columns_.get_allocator()), previous_same_type_(columns_.get_allocator()),
+          column_start_times_(columns_.get_allocator()), bar_log_(columns_.get_allocator()),
+          checkpoints_(columns_.get_allocator()), checkpoint_columns_(columns_.get_allocator()),
+          atr_bases_(columns_.get_allocator()), atr_base_columns_(columns_.get_allocator()) {
+        last_time_ = std::chrono::system_clock::now();
+        last_processed_time_ = std::chrono::system_clock::now();
+        last_month_ = month_key(last_processed_time_);
+        trend_manager_ = std::make_unique<TrendLineManager>(config_.box_size, columns_.get_allocator().resource());
+    }
 
-        std::time_t last_tt = std::chrono::system_clock::to_time_t(last_processed_time_);
-        std::tm last_tm{};
+    int Chart::month_key(const Timestamp time) {
+        const std::time_t tt = std::chrono::system_clock::to_time_t(time);
+        std::tm tm{};
 #ifdef _WIN32
-        localtime_s(&last_tm, &last_tt);
+        localtime_s(&tm, &tt);
 #else
-        localtime_r(&last_tt, &last_tm);
+        localtime_r(&tt, &tm);
 #endif
+        return tm.tm_year * 12 + tm.tm_mon;
+    }
 
-        if (current_tm.tm_year != last_tm.tm_year || current_tm.tm_mon != last_tm.tm_mon) {
-            marker = get_month_marker(current_tm.tm_mon + 1);
-            return true;
-        }
-
-        marker = "";
-        return false;
+    MarkerId Chart::month_marker_for(const int key) const {
+        if (key == last_month_) return MarkerTable::none;
+        return MarkerTable::month(((key % 12) + 12) % 12 + 1);
     }
 
-    std::string Chart::get_month_marker_for_data(const Timestamp time) const
-    {
-        if (std::string marker; has_month_changed(time, marker))
-            return marker;
-        return "";
+    double Chart::traditional_box_size(const double price) {
+        return traditional_scale[traditional_bracket(price)].box;
     }
 
     double Chart::calculate_box_size(const double price) {
@@ -74,35 +85,49 @@ namespace pnf
         case BoxSizeMethod::Percentage:
             box = price * config_.box_size / 100.0;
             break;
+        case BoxSizeMethod::ATR:
+            box = atr_box_;
+            break;
+        case BoxSizeMethod::Logarithmic: {
+            const int k = log_grid_.floor_index(price);
+            box = log_grid_.at(k + 1) - log_grid_.at(k);
+            break;
+        }
         case BoxSizeMethod::Traditional:
         default:
-            if (price < 0.25) { config_.box_size = 0.0625; box = config_.box_size; break; }
-            if (price < 1.0) { config_.box_size = 0.125; box = config_.box_size; break; }
-            if (price < 5.0) { config_.box_size = 0.25; box = config_.box_size; break; }
-            if (price < 20.0) { config_.box_size = 0.5; box = config_.box_size; break; }
-            if (price < 100.0) { config_.box_size = 1.0; box = config_.box_size; break; }
-            if (price < 200.0) { config_.box_size = 2.0; box = config_.box_size; break; }
-            if (price < 500.0) { config_.box_size = 4.0; box = config_.box_size; break; }
-            if (price < 1000.0) { config_.box_size = 5.0; box = config_.box_size; break; }
-            if (price < 25000.0) { config_.box_size = 50.0; box = config_.box_size; break; }
-            config_.box_size = 500.0;
-            box = config_.box_size;
+            if (bracket_ < 0 || price < bracket_floor(bracket_) || !(price < traditional_scale[bracket_].upper))
+                bracket_ = traditional_bracket(price);
+            box = traditional_scale[bracket_].box;
             break;
         }
-        last_box_size_ = box;
-        if (trend_manager_) {
+        if (box != last_box_size_ && trend_manager_) {
             trend_manager_->set_box_size(box);
         }
+        last_box_size_ = box;
         return box;
     }
 
+    void Chart::push_column(Column&& col) {
+        columns_.push_back(std::move(col));
+        if (config_.compact_columns && columns_.size() > 1)
+            columns_[columns_.size() - 2].compact();
+    }
+
     double Chart::round_to_box_size(const double price, const bool round_up) {
         const double box = calculate_box_size(price);
+        if (config_.box_size_method == BoxSizeMethod::Logarithmic)
+            return log_grid_.at(round_up ? log_grid_.ceil_index(price) : log_grid_.floor_index(price));
         if (round_up)
             return std::ceil(price / box) * box;
         return std::floor(price / box) * box;
     }
 
+    double Chart::offset_price(const double price, const double box, const int boxes) {
+        if (config_.box_size_method == BoxSizeMethod::Logarithmic)
+            return log_grid_.at(log_grid_.floor_index(price) + boxes);
+        return price + boxes * box;
+    }
+
     bool Chart::is_reversal(const double price, const Column* current, BoxType& new_type) {
         if (!current || current->box_count() == 0) return false;
 
@@ -111,21 +136,21 @@ namespace pnf
         const double lowest = current->lowest_price();
 
         if (const ColumnType col_type = current->type(); col_type == ColumnType::X) {
-            if (const double reversal_level = highest - (config_.reversal * box); price <= reversal_level) {
+            if (const double reversal_level = offset_price(highest, box, -config_.reversal); price <= reversal_level) {
                 new_type = BoxType::O;
                 return true;
             }
         } else if (col_type == ColumnType::O) {
-            if (const double reversal_level = lowest + (config_.reversal * box); price >= reversal_level) {
+            if (const double reversal_level = offset_price(lowest, box, config_.reversal); price >= reversal_level) {
                 new_type = BoxType::X;
                 return true;
             }
         } else if (col_type == ColumnType::Mixed && config_.reversal == 1) {
-            if (price > highest + box) {
+            if (price > offset_price(highest, box, 1)) {
                 new_type = BoxType::X;
                 return true;
             }
-            if (price < lowest - box) {
+            if (price < offset_price(lowest, box, -1)) {
                 new_type = BoxType::O;
                 return true;
             }
@@ -133,24 +158,26 @@ namespace pnf
         return false;
     }
 
-    bool Chart::process_high_low(const double high, const double low, const Timestamp time)
+    bool Chart::process_high_low(const double high, const double low, const Timestamp time, const int key)
     {
         last_time_ = time;
         bool changed = false;
-        const std::string month_marker = get_month_marker_for_data(time);
-        const bool month_changed = !month_marker.empty();
+        const MarkerId month_marker = month_marker_for(key);
+        const bool month_changed = month_marker != MarkerTable::none;
         Column* last = last_column();
         const double box = calculate_box_size(high);
 
         if (!last) {
-            auto col = std::make_unique<Column>(ColumnType::X);
+            Column col(ColumnType::X, columns_.get_allocator());
+            col.set_box_size(box);
             const double start_price = round_to_box_size(high, false);
             if (month_changed)
-                col->add_box(start_price, BoxType::X, month_marker);
+                col.add_box(start_price, BoxType::X, month_marker);
             else
-                col->add_box(start_price, BoxType::X);
-            columns_.push_back(std::move(col));
+                col.add_box(start_price, BoxType::X);
+            push_column(std::move(col));
             last_processed_time_ = time;
+            last_month_ = key;
             return true;
         }
 
@@ -162,40 +189,41 @@ namespace pnf
             const double reversal_price = reversal_high ? high : low;
             ColumnType new_col_type = (reversal_type == BoxType::X) ? ColumnType::X : ColumnType::O;
             if (config_.reversal == 1) new_col_type = ColumnType::Mixed;
-            auto col = std::make_unique<Column>(new_col_type);
+            Column col(new_col_type, columns_.get_allocator());
+            col.set_box_size(box);
             if (reversal_type == BoxType::X) {
-                double current_price = last->lowest_price() + box;
+                double current_price = offset_price(last->lowest_price(), box, 1);
                 bool marker_applied = false;
                 while (current_price <= round_to_box_size(reversal_price, true)) {
                     if (month_changed && !marker_applied) {
-                        col->add_box(current_price, BoxType::X, month_marker);
+                        col.add_box(current_price, BoxType::X, month_marker);
                         marker_applied = true;
                     } else {
-                        col->add_box(current_price, BoxType::X);
+                        col.add_box(current_price, BoxType::X);
                     }
-                    current_price += box;
+                    current_price = offset_price(current_price, box, 1);
                 }
             } else {
-                double current_price = last->highest_price() - box;
+                double current_price = offset_price(last->highest_price(), box, -1);
                 bool marker_applied = false;
                 while (current_price >= round_to_box_size(reversal_price, false)) {
                     if (month_changed && !marker_applied) {
-                        col->add_box(current_price, BoxType::O, month_marker);
+                        col.add_box(current_price, BoxType::O, month_marker);
                         marker_applied = true;
                     } else {
-                        col->add_box(current_price, BoxType::O);
+                        col.add_box(current_price, BoxType::O);
                     }
-                    current_price -= box;
+                    current_price = offset_price(current_price, box, -1);
                 }
             }
-            columns_.push_back(std::move(col));
+            push_column(std::move(col));
             if (trend_manager_)
                 trend_manager_->update(columns_, static_cast<int>(columns_.size()) - 1);
         } else {
             const ColumnType col_type = last->type();
             if (col_type == ColumnType::X && high > last->highest_price()) {
                 changed = true;
-                double current_price = last->highest_price() + box;
+                double current_price = offset_price(last->highest_price(), box, 1);
                 bool marker_applied = false;
                 while (current_price <= round_to_box_size(high, true)) {
                     if (month_changed && !marker_applied) {
@@ -204,11 +232,11 @@ namespace pnf
                     } else {
                         last->add_box(current_price, BoxType::X);
                     }
-                    current_price += box;
+                    current_price = offset_price(current_price, box, 1);
                 }
             } else if (col_type == ColumnType::O && low < last->lowest_price()) {
                 changed = true;
-                double current_price = last->lowest_price() - box;
+                double current_price = offset_price(last->lowest_price(), box, -1);
                 bool marker_applied = false;
                 while (current_price >= round_to_box_size(low, false)) {
                     if (month_changed && !marker_applied) {
@@ -217,33 +245,36 @@ namespace pnf
                     } else {
                         last->add_box(current_price, BoxType::O);
                     }
-                    current_price -= box;
+                    current_price = offset_price(current_price, box, -1);
                 }
             }
         }
 
         last_processed_time_ = time;
+        last_month_ = key;
         return changed;
     }
 
-    bool Chart::process_close(const double close, const Timestamp time)
+    bool Chart::process_close(const double close, const Timestamp time, const int key)
     {
         last_time_ = time;
         bool changed = false;
-        const std::string month_marker = get_month_marker_for_data(time);
-        const bool month_changed = !month_marker.empty();
+        const MarkerId month_marker = month_marker_for(key);
+        const bool month_changed = month_marker != MarkerTable::none;
         Column* last = last_column();
         const double box = calculate_box_size(close);
 
         if (!last) {
-            auto col = std::make_unique<Column>(ColumnType::X);
+            Column col(ColumnType::X, columns_.get_allocator());
+            col.set_box_size(box);
             const double start_price = round_to_box_size(close, false);
             if (month_changed)
-                col->add_box(start_price, BoxType::X, month_marker);
+                col.add_box(start_price, BoxType::X, month_marker);
             else
-                col->add_box(start_price, BoxType::X);
-            columns_.push_back(std::move(col));
+                col.add_box(start_price, BoxType::X);
+            push_column(std::move(col));
             last_processed_time_ = time;
+            last_month_ = key;
             return true;
         }
 
@@ -251,42 +282,43 @@ namespace pnf
             changed = true;
             ColumnType new_col_type = (reversal_type == BoxType::X) ? ColumnType::X : ColumnType::O;
             if (config_.reversal == 1) new_col_type = ColumnType::Mixed;
-            auto col = std::make_unique<Column>(new_col_type);
+            Column col(new_col_type, columns_.get_allocator());
+            col.set_box_size(box);
 
             if (reversal_type == BoxType::X) {
-                double current_price = last->lowest_price() + box;
+                double current_price = offset_price(last->lowest_price(), box, 1);
                 bool marker_applied = false;
                 while (current_price <= round_to_box_size(close, true)) {
                     if (month_changed && !marker_applied) {
-                        col->add_box(current_price, BoxType::X, month_marker);
+                        col.add_box(current_price, BoxType::X, month_marker);
                         marker_applied = true;
                     } else {
-                        col->add_box(current_price, BoxType::X);
+                        col.add_box(current_price, BoxType::X);
                     }
-                    current_price += box;
+                    current_price = offset_price(current_price, box, 1);
                 }
             } else {
-                double current_price = last->highest_price() - box;
+                double current_price = offset_price(last->highest_price(), box, -1);
                 bool marker_applied = false;
                 while (current_price >= round_to_box_size(close, false)) {
                     if (month_changed && !marker_applied) {
-                        col->add_box(current_price, BoxType::O, month_marker);
+                        col.add_box(current_price, BoxType::O, month_marker);
                         marker_applied = true;
                     } else {
-                        col->add_box(current_price, BoxType::O);
+                        col.add_box(current_price, BoxType::O);
                     }
-                    current_price -= box;
+                    current_price = offset_price(current_price, box, -1);
                 }
             }
 
-            columns_.push_back(std::move(col));
+            push_column(std::move(col));
             if (trend_manager_)
                 trend_manager_->update(columns_, static_cast<int>(columns_.size()) - 1);
 
         } else {
             if (const ColumnType col_type = last->type(); (col_type == ColumnType::X || col_type == ColumnType::Mixed) && close > last->highest_price()) {
                 changed = true;
-                double current_price = last->highest_price() + box;
+                double current_price = offset_price(last->highest_price(), box, 1);
                 bool marker_applied = false;
                 while (current_price <= round_to_box_size(close, true)) {
                     const BoxType bt = (col_type == ColumnType::Mixed) ?
@@ -297,12 +329,12 @@ namespace pnf
                     } else {
                         last->add_box(current_price, bt);
                     }
-                    current_price += box;
+                    current_price = offset_price(current_price, box, 1);
                 }
 
             } else if ((col_type == ColumnType::O || col_type == ColumnType::Mixed) && close < last->lowest_price()) {
                 changed = true;
-                double current_price = last->lowest_price() - box;
+                double current_price = offset_price(last->lowest_price(), box, -1);
                 bool marker_applied = false;
                 while (current_price >= round_to_box_size(close, false)) {
                     const BoxType bt = (col_type == ColumnType::Mixed) ?
@@ -313,106 +345,471 @@ namespace pnf
                     } else {
                         last->add_box(current_price, bt);
                     }
-                    current_price -= box;
+                    current_price = offset_price(current_price, box, -1);
                 }
             }
         }
 
         last_processed_time_ = time;
+        last_month_ = key;
         return changed;
     }
 
     bool Chart::add_data(const double high, const double low, const double close, const Timestamp time) {
-        if (config_.method == ConstructionMethod::HighLow)
-            return process_high_low(high, low, time);
-        return process_close(close, time);
+        return add_data(high, low, close, time, month_key(time));
     }
 
-    bool Chart::add_data(const double price, const Timestamp time) {
-        return add_data(price, price, price, time);
+    bool Chart::add_data(const double high, const double low, const double close, const Timestamp time,
+                         const int key) {
+        if (config_.box_size_method == BoxSizeMethod::Logarithmic) {
+            const bool high_low = config_.method == ConstructionMethod::HighLow;
+            if (high_low ? (high <= 0.0 || low <= 0.0) : close <= 0.0) return false;
+        }
+        const bool changed = config_.box_size_method == BoxSizeMethod::ATR
+                                 ? process_atr(high, low, close, time, key)
+                                 : construct(high, low, close, time, key);
+        log_bar(high, low, close, time, key);
+        return changed;
     }
 
-    bool Chart::add_ohlc(const OHLC& ohlc) {
-        return add_data(ohlc.high, ohlc.low, ohlc.close, ohlc.time);
+    bool Chart::construct(const double high, const double low, const double close, const Timestamp time,
+                          const int key) {
+        const bool changed = config_.method == ConstructionMethod::HighLow
+                                 ? process_high_low(high, low, time, key)
+                                 : process_close(close, time, key);
+        if (!columns_.empty()) columns_.back().record_bar(time);
+        update_column_extremes();
+        return changed;
     }
 
-    Column* Chart::column(const size_t index) {
-        return (index < columns_.size()) ? columns_[index].get() : nullptr;
+    void Chart::update_column_extremes() {
+        const size_t count = columns_.size();
+        const size_t from = std::min(column_highs_.empty() ? 0 : column_highs_.size() - 1, count);
+        column_highs_.resize(count);
+        column_lows_.resize(count);
+        column_midpoints_.resize(count);
+        for (size_t i = from; i < count; i++) {
+            const double high = columns_[i].highest_price();
+            const double low = columns_[i].lowest_price();
+            column_highs_[i] = high;
+            column_lows_[i] = low;
+            column_midpoints_[i] = (high + low) / 2.0;
+
+            // Boxes are only ever appended, so earlier ones are already indexed.
+            const Column& col = columns_[i];
+            for (size_t j = i == from ? ladder_boxes_ : 0; j < col.box_count(); j++) {
+                add_ladder_price(col.box_at(j).price());
+            }
+        }
+        ladder_boxes_ = count ? columns_[count - 1].box_count() : 0;
+
+        // A column keeps the type it was created with, so only new columns are indexed.
+        for (size_t i = previous_same_type_.size(); i < count; i++) {
+            const ColumnType type = columns_[i].type();
+            auto& indices = type == ColumnType::X ? x_columns_ : type == ColumnType::O ? o_columns_ : mixed_columns_;
+            previous_same_type_.push_back(indices.empty() ? -1 : static_cast<int>(indices.back()));
+            indices.push_back(i);
+            column_start_times_.push_back(columns_[i].first_time());
+        }
     }
 
-    const Column* Chart::column(const size_t index) const {
-        return (index < columns_.size()) ? columns_[index].get() : nullptr;
+    void Chart::add_ladder_price(const double price) {
+        const std::span<const double> ladder = price_ladder();
+        // New highs and lows land at the ends, which take no shifting.
+        if (ladder.empty() || price > ladder.front() + 0.00001) {
+            if (ladder_front_ == 0) grow_ladder_front();
+            --ladder_front_;
+            price_ladder_[ladder_front_] = price;
+            ladder_refs_[ladder_front_] = 1;
+            return;
+        }
+        if (price < ladder.back() - 0.00001) {
+            price_ladder_.push_back(price);
+            ladder_refs_.push_back(1);
+            return;
+        }
+
+        const auto pos = std::ranges::lower_bound(ladder, price + 0.00001, std::greater<>());
+        const auto index = static_cast<std::ptrdiff_t>(ladder_front_) + (pos - ladder.begin());
+        if (pos != ladder.end() && std::abs(*pos - price) < 0.00001) {
+            ++ladder_refs_[index];
+            return;
+        }
+        price_ladder_.insert(price_ladder_.begin() + index, price);
+        ladder_refs_.insert(ladder_refs_.begin() + index, 1);
     }
 
-    Column* Chart::last_column() {
-        return columns_.empty() ? nullptr : columns_.back().get();
+    void Chart::grow_ladder_front() {
+        // Doubling the free space keeps a run of new highs amortised O(1).
+        const size_t room = std::max<size_t>(price_ladder_.size(), 8);
+        price_ladder_.insert(price_ladder_.begin(), room, 0.0);
+        ladder_refs_.insert(ladder_refs_.begin(), room, 0);
+        ladder_front_ += room;
     }
 
-    const Column* Chart::last_column() const {
-        return columns_.empty() ? nullptr : columns_.back().get();
+    void Chart::release_ladder_price(const double price) {
+        const int row = price_row(price);
+        if (row < 0) return;
+        const size_t index = ladder_front_ + static_cast<size_t>(row);
+        if (--ladder_refs_[index] > 0) return;
+        if (row == 0) {
+            ++ladder_front_;
+        } else {
+            price_ladder_.erase(price_ladder_.begin() + static_cast<std::ptrdiff_t>(index));
+            ladder_refs_.erase(ladder_refs_.begin() + static_cast<std::ptrdiff_t>(index));
+        }
     }
 
-    size_t Chart::x_column_count() const {
-        return std::ranges::count_if(columns_,
-                                     [](const auto& c) { return c->type() == ColumnType::X; });
+    void Chart::truncate_column_arrays(const ColumnList& columns, const size_t kept) {
+        for (size_t i = kept; i < columns.size(); i++) {
+            const size_t boxes = i + 1 == columns.size() ? ladder_boxes_ : columns[i].box_count();
+            for (size_t j = 0; j < boxes; j++) {
+                release_ladder_price(columns[i].box_at(j).price());
+            }
+        }
+        ladder_boxes_ = kept ? columns[kept - 1].box_count() : 0;
+
+        column_highs_.resize(std::min(column_highs_.size(), kept));
+        column_lows_.resize(std::min(column_lows_.size(), kept));
+        column_midpoints_.resize(std::min(column_midpoints_.size(), kept));
+        for (auto* indices : {&x_columns_, &o_columns_, &mixed_columns_}) {
+            while (!indices->empty() && indices->back() >= kept) indices->pop_back();
+        }
+        previous_same_type_.resize(std::min(previous_same_type_.size(), kept));
+        column_start_times_.resize(std::min(column_start_times_.size(), kept));
     }
 
-    size_t Chart::o_column_count() const {
-        return std::ranges::count_if(columns_,
-                                     [](const auto& c) { return c->type() == ColumnType::O; });
+    void Chart::reset_column_arrays() {
+        column_highs_.clear();
+        column_lows_.clear();
+        column_midpoints_.clear();
+        price_ladder_.clear();
+        ladder_refs_.clear();
+        ladder_front_ = 0;
+        ladder_boxes_ = 0;
+        x_columns_.clear();
+        o_columns_.clear();
+        mixed_columns_.clear();
+        previous_same_type_.clear();
+        column_start_times_.clear();
     }
 
-    size_t Chart::mixed_column_count() const {
-        return std::ranges::count_if(columns_,
-                                     [](const auto& c) { return c->type() == ColumnType::Mixed; });
+    void Chart::refresh_column_extremes() {
+        ++rebuilds_;
+        reset_column_arrays();
+        drop_checkpoints();
+        update_column_extremes();
     }
 
-    std::vector<size_t> Chart::x_column_indices() const {
-        std::vector<size_t> indices;
-        for (size_t i = 0; i < columns_.size(); i++) {
-            if (columns_[i]->type() == ColumnType::X)
-                indices.push_back(i);
+    bool Chart::process_atr(const double high, const double low, const double close, const Timestamp time,
+                            const int key) {
+        const int period = std::max(1, config_.atr_period);
+        double tr = high - low;
+        if (atr_samples_ > 0) {
+            tr = std::max({tr, std::abs(high - atr_prev_close_), std::abs(low - atr_prev_close_)});
+        }
+        atr_prev_close_ = close;
+
+        // Simple average over the first period, Wilder smoothing afterwards.
+        if (atr_samples_ < period) {
+            atr_sum_ += tr;
+            if (++atr_samples_ == period) atr_ = atr_sum_ / period;
+        } else {
+            atr_ = (atr_ * (period - 1) + tr) / period;
+        }
+
+        const bool refreshing = config_.atr_refresh > 0;
+        if (atr_box_ == 0.0 || refreshing)
+            atr_bars_.push_back({high, low, close, time, key});
+
+        const double multiple = config_.box_size > 0.0 ? config_.box_size : 1.0;
+        const double target = atr_ * multiple;
+
+        if (atr_box_ == 0.0) {
+            last_time_ = time;
+            if (target <= 0.0) return false;
+            atr_box_ = target;
+            const bool drawn = reproject();
+            if (refreshing) {
+                mark_atr_base();
+            } else {
+                atr_bars_.clear();
+                atr_bars_.shrink_to_fit();
+            }
+            return drawn;
         }
-        return indices;
+
+        if (refreshing && ++atr_since_refresh_ >= config_.atr_refresh) {
+            atr_since_refresh_ = 0;
+            bool drawn;
+            if (target > 0.0 && target != atr_box_) {
+                atr_box_ = target;
+                drawn = reproject();
+            } else {
+                drawn = construct(high, low, close, time, key);
+            }
+            mark_atr_base();
+            return drawn;
+        }
+        return construct(high, low, close, time, key);
     }
 
-    std::vector<size_t> Chart::o_column_indices() const {
-        std::vector<size_t> indices;
-        for (size_t i = 0; i < columns_.size(); i++) {
-            if (columns_[i]->type() == ColumnType::O)
-                indices.push_back(i);
+    bool Chart::reproject() {
+        drop_checkpoints();
+        if (atr_bases_.empty()) {
+            ++rebuilds_;
+            columns_.clear();
+            reset_column_arrays();
+            if (trend_manager_) trend_manager_->clear();
+            last_processed_time_ = std::chrono::system_clock::now();
+            last_month_ = month_key(last_processed_time_);
+        } else {
+            // Columns closed before the previous refresh keep the box size they were drawn with.
+            rewind(atr_bases_.back(), atr_base_columns_.back());
+        }
+        for (const auto& bar : atr_bars_) {
+            construct(bar.high, bar.low, bar.close, bar.time, bar.key);
         }
-        return indices;
+        return !columns_.empty();
     }
 
-    std::vector<size_t> Chart::mixed_column_indices() const {
-        std::vector<size_t> indices;
-        for (size_t i = 0; i < columns_.size(); i++) {
-            if (columns_[i]->type() == ColumnType::Mixed)
-                indices.push_back(i);
+    void Chart::mark_atr_base() {
+        // Checkpoints may need older bases; otherwise only the latest is ever rewound to.
+        if (config_.checkpoint_interval <= 0) {
+            atr_bases_.clear();
+            atr_base_columns_.clear();
+        }
+        atr_bars_.clear();
+        atr_bases_.push_back(snapshot());
+        save_last_column(atr_base_columns_);
+    }
+
+    void Chart::skip_data(const double high, const double low, const double close, const Timestamp time,
+                          const int key) {
+        if (!columns_.empty()) columns_.back().record_bar(time);
+        last_time_ = time;
+        last_processed_time_ = time;
+        last_month_ = key;
+        log_bar(high, low, close, time, key);
+    }
+
+    void Chart::log_bar(const double high, const double low, const double close, const Timestamp time,
+                        const int key) {
+        if (config_.checkpoint_interval <= 0) return;
+        bar_log_.push_back({high, low, close, time, key});
+        if (bar_log_.size() % static_cast<size_t>(config_.checkpoint_interval) != 0) return;
+        // An unseeded ATR chart has drawn nothing yet; replaying from the start is just as cheap.
+        if (config_.box_size_method == BoxSizeMethod::ATR && atr_box_ == 0.0) return;
+
+        checkpoints_.push_back(snapshot());
+        save_last_column(checkpoint_columns_);
+    }
+
+    Chart::Checkpoint Chart::snapshot() const {
+        return {bar_log_.size(), columns_.size(),
+                trend_manager_ ? trend_manager_->checkpoint() : TrendLineCheckpoint{},
+                last_time_, last_processed_time_, last_month_, last_box_size_, bracket_,
+                atr_, atr_sum_, atr_samples_, atr_prev_close_, atr_box_, atr_since_refresh_,
+                atr_bars_.size(), atr_bases_.size()};
+    }
+
+    void Chart::save_last_column(ColumnList& columns) const {
+        if (columns_.empty())
+            columns.emplace_back(ColumnType::X);
+        else
+            columns.push_back(columns_.back());
+    }
+
+    void Chart::drop_checkpoints() {
+        checkpoints_.clear();
+        checkpoint_columns_.clear();
+        // Only checkpoints refer to older ATR bases.
+        if (atr_bases_.size() > 1) {
+            atr_bases_.erase(atr_bases_.begin(), atr_bases_.end() - 1);
+            atr_base_columns_.erase(atr_base_columns_.begin(), atr_base_columns_.end() - 1);
+        }
+    }
+
+    int Chart::checkpoint_before(const size_t bars) const {
+        const auto pos = std::ranges::upper_bound(checkpoints_, bars, {}, &Checkpoint::bars);
+        return static_cast<int>(pos - checkpoints_.begin()) - 1;
+    }
+
+    void Chart::rewind(const Checkpoint& cp, const Column& last) {
+        ++rebuilds_;
+        const size_t kept = cp.columns ? cp.columns - 1 : 0;
+        truncate_column_arrays(columns_, kept);
+        columns_.erase(columns_.begin() + static_cast<std::ptrdiff_t>(kept), columns_.end());
+        if (cp.columns) columns_.push_back(last);
+        if (trend_manager_) trend_manager_->restore(cp.trend);
+        last_time_ = cp.last_time;
+        last_processed_time_ = cp.last_processed_time;
+        last_month_ = cp.last_month;
+        last_box_size_ = cp.last_box_size;
+        bracket_ = cp.bracket;
+        update_column_extremes();
+    }
+
+    void Chart::restore(const Chart& source, const size_t index) {
+        const Checkpoint& cp = source.checkpoints_[index];
+        const auto bases = static_cast<std::ptrdiff_t>(cp.atr_bases);
+        if (&source != this) {
+            const size_t kept = cp.columns ? cp.columns - 1 : 0;
+            columns_.assign(source.columns_.begin(), source.columns_.begin() + static_cast<std::ptrdiff_t>(kept));
+            // Copy the arrays and cut them back rather than re-index the kept columns.
+            column_highs_ = source.column_highs_;
+            column_lows_ = source.column_lows_;
+            column_midpoints_ = source.column_midpoints_;
+            price_ladder_ = source.price_ladder_;
+            ladder_refs_ = source.ladder_refs_;
+            ladder_front_ = source.ladder_front_;
+            ladder_boxes_ = source.ladder_boxes_;
+            x_columns_ = source.x_columns_;
+            o_columns_ = source.o_columns_;
+            mixed_columns_ = source.mixed_columns_;
+            previous_same_type_ = source.previous_same_type_;
+            column_start_times_ = source.column_start_times_;
+            truncate_column_arrays(source.columns_, kept);
+            trend_manager_ = std::make_unique<TrendLineManager>(*source.trend_manager_,
+                                                                columns_.get_allocator().resource());
+            bar_log_.assign(source.bar_log_.begin(), source.bar_log_.begin() + static_cast<std::ptrdiff_t>(cp.bars));
+            checkpoints_.assign(source.checkpoints_.begin(),
+                                source.checkpoints_.begin() + static_cast<std::ptrdiff_t>(index) + 1);
+            checkpoint_columns_.assign(source.checkpoint_columns_.begin(),
+                                       source.checkpoint_columns_.begin() + static_cast<std::ptrdiff_t>(index) + 1);
+            atr_bases_.assign(source.atr_bases_.begin(), source.atr_bases_.begin() + bases);
+            atr_base_columns_.assign(source.atr_base_columns_.begin(), source.atr_base_columns_.begin() + bases);
+        }
+        // The ATR bars since the last refresh are the tail of the logged bars.
+        atr_bars_.assign(source.bar_log_.begin() + static_cast<std::ptrdiff_t>(cp.bars - cp.atr_bars),
+                         source.bar_log_.begin() + static_cast<std::ptrdiff_t>(cp.bars));
+        rewind(cp, source.checkpoint_columns_[index]);
+        atr_ = cp.atr;
+        atr_sum_ = cp.atr_sum;
+        atr_samples_ = cp.atr_samples;
+        atr_prev_close_ = cp.atr_prev_close;
+        atr_box_ = cp.atr_box;
+        atr_since_refresh_ = cp.atr_since_refresh;
+
+        if (&source == this) {
+            bar_log_.resize(cp.bars);
+            atr_bases_.erase(atr_bases_.begin() + bases, atr_bases_.end());
+            atr_base_columns_.erase(atr_base_columns_.begin() + bases, atr_base_columns_.end());
+            checkpoints_.erase(checkpoints_.begin() + static_cast<std::ptrdiff_t>(index) + 1, checkpoints_.end());
+            checkpoint_columns_.erase(checkpoint_columns_.begin() + static_cast<std::ptrdiff_t>(index) + 1,
+                                      checkpoint_columns_.end());
+        }
+    }
+
+    Chart Chart::as_of(const Timestamp time) const {
+        Chart chart(config_, columns_.get_allocator().resource());
+        const size_t end = static_cast<size_t>(
+            std::ranges::upper_bound(bar_log_, time, {}, &LoggedBar::time) - bar_log_.begin());
+        size_t from = 0;
+        if (const int index = checkpoint_before(end); index >= 0) {
+            chart.restore(*this, static_cast<size_t>(index));
+            from = checkpoints_[index].bars;
+        }
+        for (size_t i = from; i < end; i++) {
+            const LoggedBar& bar = bar_log_[i];
+            chart.add_data(bar.high, bar.low, bar.close, bar.time, bar.key);
+        }
+        chart.replayed_ = end - from;
+        return chart;
+    }
+
+    bool Chart::splice_data(const double high, const double low, const double close, const Timestamp time) {
+        if (config_.checkpoint_interval <= 0) return false;
+        const size_t pos = static_cast<size_t>(
+            std::ranges::lower_bound(bar_log_, time, {}, &LoggedBar::time) - bar_log_.begin());
+        const bool replace = pos < bar_log_.size() && bar_log_[pos].time == time;
+        const int index = checkpoint_before(pos);
+        const size_t from = index >= 0 ? checkpoints_[index].bars : 0;
+
+        std::vector<LoggedBar> replay(bar_log_.begin() + static_cast<std::ptrdiff_t>(from), bar_log_.end());
+        const LoggedBar bar{high, low, close, time, month_key(time)};
+        if (replace)
+            replay[pos - from] = bar;
+        else
+            replay.insert(replay.begin() + static_cast<std::ptrdiff_t>(pos - from), bar);
+
+        // Columns before the checkpoint's last one are kept as they are; remember the rest to compare.
+        const size_t kept = index >= 0 && checkpoints_[index].columns ? checkpoints_[index].columns - 1 : 0;
+        const std::vector<double> highs(column_highs_.begin() + static_cast<std::ptrdiff_t>(kept), column_highs_.end());
+        const std::vector<double> lows(column_lows_.begin() + static_cast<std::ptrdiff_t>(kept), column_lows_.end());
+
+        if (index >= 0)
+            restore(*this, static_cast<size_t>(index));
+        else
+            clear();
+        for (const LoggedBar& b : replay) {
+            add_data(b.high, b.low, b.close, b.time, b.key);
         }
-        return indices;
+        replayed_ = replay.size();
+        return !std::ranges::equal(highs, std::span(column_highs_).subspan(kept)) ||
+               !std::ranges::equal(lows, std::span(column_lows_).subspan(kept));
+    }
+
+    bool Chart::add_data(const double price, const Timestamp time) {
+        return add_data(price, price, price, time);
+    }
+
+    bool Chart::add_ohlc(const OHLC& ohlc) {
+        return add_data(ohlc.high, ohlc.low, ohlc.close, ohlc.time);
+    }
+
+    Column* Chart::column(const size_t index) {
+        return (index < columns_.size()) ? &columns_[index] : nullptr;
+    }
+
+    const Column* Chart::column(const size_t index) const {
+        return (index < columns_.size()) ? &columns_[index] : nullptr;
+    }
+
+    Column* Chart::last_column() {
+        return columns_.empty() ? nullptr : &columns_.back();
+    }
+
+    const Column* Chart::last_column() const {
+        return columns_.empty() ? nullptr : &columns_.back();
     }
 
     std::vector<double> Chart::all_prices() const {
-        std::vector<double> prices;
-        for (const auto& col : columns_) {
-            for (size_t j = 0; j < col->box_count(); j++) {
-                const Box* box = col->get_box_at(j);
-                if (!box) continue;
-                double price = box->price();
-                bool found = false;
-                for (const double existing : prices) {
-                    if (std::abs(existing - price) < 0.00001) {
-                        found = true;
-                        break;
-                    }
-                }
-                if (!found) prices.push_back(price);
-            }
+        const std::span<const double> ladder = price_ladder();
+        return {ladder.begin(), ladder.end()};
+    }
+
+    int Chart::column_at(const Timestamp time) const {
+        const auto pos = std::ranges::upper_bound(column_start_times_, time);
+        return static_cast<int>(pos - column_start_times_.begin()) - 1;
+    }
+
+    int Chart::price_row(const double price) const {
+        const std::span<const double> ladder = price_ladder();
+        if (ladder.empty()) return -1;
+
+        // Grid box sizes leave no gaps in the ladder, so the row is the number
+        // of boxes below the top price. Off-grid boxes fall through to the search.
+        double offset = -1.0;
+        switch (config_.box_size_method) {
+        case BoxSizeMethod::Fixed:
+        case BoxSizeMethod::Points:
+            if (config_.box_size > 0.0) offset = std::round((ladder.front() - price) / config_.box_size);
+            break;
+        case BoxSizeMethod::Logarithmic:
+            if (price > 0.0) offset = log_grid_.floor_index(ladder.front()) - log_grid_.floor_index(price);
+            break;
+        default:
+            break;
+        }
+        if (offset >= 0.0 && offset < static_cast<double>(ladder.size())) {
+            const auto row = static_cast<size_t>(offset);
+            if (std::abs(ladder[row] - price) < 0.00001) return static_cast<int>(row);
         }
-        std::ranges::sort(prices, std::greater<>());
-        return prices;
+
+        const auto pos = std::ranges::lower_bound(ladder, price + 0.00001, std::greater<>());
+        if (pos == ladder.end() || std::abs(*pos - price) >= 0.00001) return -1;
+        return static_cast<int>(pos - ladder.begin());
     }
 
     bool Chart::has_bullish_bias() const {
@@ -444,9 +841,28 @@ namespace pnf
     }
 
     void Chart::clear() {
+        ++rebuilds_;
         columns_.clear();
-        last_month_ = -1;
-        last_processed_time_ = std::chrono::system_clock::now();
+        reset_column_arrays();
+        if (trend_manager_) trend_manager_->clear();
+        last_time_ = std::chrono::system_clock::now();
+        last_processed_time_ = last_time_;
+        last_month_ = month_key(last_processed_time_);
+        last_box_size_ = config_.box_size;
+        bracket_ = -1;
+        atr_bars_.clear();
+        atr_ = 0.0;
+        atr_sum_ = 0.0;
+        atr_samples_ = 0;
+        atr_prev_close_ = 0.0;
+        atr_box_ = 0.0;
+        atr_since_refresh_ = 0;
+        bar_log_.clear();
+        checkpoints_.clear();
+        checkpoint_columns_.clear();
+        atr_bases_.clear();
+        atr_base_columns_.clear();
+        replayed_ = 0;
     }
 
     std::string Chart::to_string() const {
@@ -457,13 +873,16 @@ namespace pnf
         case BoxSizeMethod::Fixed: box_method_str = "Fixed"; break;
         case BoxSizeMethod::Percentage: box_method_str = "Percentage"; break;
         case BoxSizeMethod::Points: box_method_str = "Points"; break;
+        case BoxSizeMethod::ATR: box_method_str = "ATR"; break;
+        case BoxSizeMethod::Logarithmic: box_method_str = "Logarithmic"; break;
         default: box_method_str = "Traditional"; break;
         }
 
         std::ostringstream oss;
         oss << "Point & Figure Chart\n"
             << "Construction: " << method_str
-            << ", Box Size: " << box_method_str << " (" << config_.box_size << ")"
+            << ", Box Size: " << box_method_str << " ("
+            << (config_.box_size_method == BoxSizeMethod::Traditional ? last_box_size_ : config_.box_size) << ")"
             << ", Reversal: " << config_.reversal << "\n"
             << "Columns: " << columns_.size() << "\n";
 
@@ -475,9 +894,7 @@ namespace pnf
         oss << "\n";
 
         for (size_t i = 0; i < columns_.size(); i++) {
-            if (columns_[i]) {
-                oss << "Column " << (i + 1) << ":\n" << columns_[i]->to_string() << "\n";
-            }
+            oss << "Column " << (i + 1) << ":\n" << columns_[i].to_string() << "\n";
         }
 
         if (trend_manager_)
@@ -0,0 +1,122 @@
+/// \file chart_family.cpp
+/// \brief Chart family implementation.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#include "pnf/chart_family.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace pnf {
+    ChartFamily::ChartFamily(const std::vector<ChartConfig>& configs) {
+        configs_.reserve(configs.size());
+        charts_.reserve(configs.size());
+        for (const auto& config : configs) add(config);
+    }
+
+    size_t ChartFamily::add(const ChartConfig& config) {
+        configs_.push_back(config);
+        charts_.emplace_back(config);
+        quiet_low_.push_back(std::numeric_limits<double>::infinity());
+        quiet_high_.push_back(-std::numeric_limits<double>::infinity());
+        high_low_.push_back(config.method == ConstructionMethod::HighLow ? 1 : 0);
+        changed_.push_back(0);
+        return charts_.size() - 1;
+    }
+
+    void ChartFamily::refresh_band(const size_t index) {
+        constexpr double inf = std::numeric_limits<double>::infinity();
+        const Chart& chart = charts_[index];
+        const ChartConfig& config = chart.config_;
+        const Column* last = chart.last_column();
+
+        // An empty band (low = +inf) forces the full update path.
+        quiet_low_[index] = inf;
+        quiet_high_[index] = -inf;
+        if (!last || last->box_count() == 0) return;
+        if (config.box_size_method != BoxSizeMethod::Fixed && config.box_size_method != BoxSizeMethod::Points)
+            return;
+
+        // Bounds mirror Chart::is_reversal and the column extension tests so
+        // that low > quiet_low && high < quiet_high implies no change at all.
+        const double box = config.box_size;
+        const double highest = last->highest_price();
+        const double lowest = last->lowest_price();
+        switch (last->type()) {
+        case ColumnType::X:
+            quiet_low_[index] = highest - (config.reversal * box);
+            quiet_high_[index] = std::nextafter(highest, inf);
+            break;
+        case ColumnType::O:
+            quiet_low_[index] = std::nextafter(lowest, -inf);
+            quiet_high_[index] = lowest + (config.reversal * box);
+            break;
+        case ColumnType::Mixed:
+            // Mixed columns only occur with one-box reversal.
+            if (config.reversal != 1) break;
+            if (config.method == ConstructionMethod::HighLow) {
+                quiet_low_[index] = std::nextafter(lowest - box, -inf);
+                quiet_high_[index] = std::nextafter(highest + box, inf);
+            } else {
+                quiet_low_[index] = std::nextafter(lowest, -inf);
+                quiet_high_[index] = std::nextafter(highest, inf);
+            }
+            break;
+        }
+    }
+
+    size_t ChartFamily::add_data(const double high, const double low, const double close, const Timestamp time) {
+        const int key = Chart::month_key(time);
+        const double hl_low = std::min(high, low);
+        const double hl_high = std::max(high, low);
+        const size_t count = charts_.size();
+
+        // Band test for every variant; plain arrays and no branches so the
+        // compiler can vectorise it.
+        const double* lo = quiet_low_.data();
+        const double* hi = quiet_high_.data();
+        const unsigned char* hl = high_low_.data();
+        unsigned char* quiet = changed_.data();
+        for (size_t i = 0; i < count; i++) {
+            const double probe_low = hl[i] ? hl_low : close;
+            const double probe_high = hl[i] ? hl_high : close;
+            quiet[i] = static_cast<unsigned char>((probe_low > lo[i]) & (probe_high < hi[i]));
+        }
+
+        size_t updated = 0;
+        for (size_t i = 0; i < count; i++) {
+            if (quiet[i]) {
+                charts_[i].skip_data(high, low, close, time, key);
+                quiet_updates_++;
+                quiet[i] = 0;
+                continue;
+            }
+            if (charts_[i].add_data(high, low, close, time, key)) {
+                quiet[i] = 1;
+                updated++;
+                refresh_band(i);
+            }
+        }
+        return updated;
+    }
+
+    size_t ChartFamily::add_data(const double price, const Timestamp time) {
+        return add_data(price, price, price, time);
+    }
+
+    size_t ChartFamily::add_ohlc(const OHLC& ohlc) {
+        return add_data(ohlc.high, ohlc.low, ohlc.close, ohlc.time);
+    }
+
+    void ChartFamily::clear() {
+        for (size_t i = 0; i < charts_.size(); i++) {
+            charts_[i] = Chart(configs_[i]);
+            changed_[i] = 0;
+            refresh_band(i);
+        }
+        quiet_updates_ = 0;
+    }
+} // namespace pnf
@@ -7,27 +7,59 @@
 
 #include "pnf/column.hpp"
 #include <algorithm>
+#include <functional>
 #include <sstream>
 
 namespace pnf
 {
-    Column::Column(const ColumnType type) : type_(type) {}
+    Column::Column(const ColumnType type, const allocator_type& alloc)
+        : boxes_(alloc), type_(type), markers_(alloc), anchors_(alloc) {}
+
+    Column::Column(const Column& other, const allocator_type& alloc)
+        : boxes_(other.boxes_, alloc), type_(other.type_), box_size_(other.box_size_),
+          first_time_(other.first_time_), last_time_(other.last_time_), bar_count_(other.bar_count_),
+          first_price_(other.first_price_), step_(other.step_), compact_count_(other.compact_count_),
+          compact_type_(other.compact_type_), compact_(other.compact_), markers_(other.markers_, alloc),
+          anchors_(other.anchors_, alloc) {}
+
+    Column::Column(Column&& other, const allocator_type& alloc)
+        : boxes_(std::move(other.boxes_), alloc), type_(other.type_), box_size_(other.box_size_),
+          first_time_(other.first_time_), last_time_(other.last_time_), bar_count_(other.bar_count_),
+          first_price_(other.first_price_), step_(other.step_), compact_count_(other.compact_count_),
+          compact_type_(other.compact_type_), compact_(other.compact_), markers_(std::move(other.markers_), alloc),
+          anchors_(std::move(other.anchors_), alloc) {}
+
+    void Column::record_bar(const Timestamp time) {
+        if (bar_count_++ == 0) first_time_ = time;
+        last_time_ = time;
+    }
 
     bool Column::add_box(double price, BoxType box_type) {
         if (has_box(price)) return false;
-        boxes_.push_back(std::make_unique<Box>(price, box_type));
+        expand();
+        boxes_.emplace_back(price, box_type);
         return true;
     }
 
     bool Column::add_box(double price, BoxType box_type, const std::string& marker) {
         if (has_box(price)) return false;
-        boxes_.push_back(std::make_unique<Box>(price, box_type, marker));
+        expand();
+        boxes_.emplace_back(price, box_type, marker);
+        return true;
+    }
+
+    bool Column::add_box(double price, BoxType box_type, const MarkerId marker) {
+        if (has_box(price)) return false;
+        expand();
+        boxes_.emplace_back(price, box_type, marker);
         return true;
     }
 
     bool Column::remove_box(double price) {
+        if (compact_ && compact_index_of(price) < 0) return false;
+        expand();
         const auto it = std::ranges::find_if(boxes_,
-                                             [price](const auto& box) { return box && box->price() == price; });
+                                             [price](const Box& box) { return box.price() == price; });
         if (it != boxes_.end()) {
             boxes_.erase(it);
             return true;
@@ -36,31 +68,48 @@ namespace pnf
     }
 
     bool Column::has_box(double price) const {
+        if (compact_) return compact_index_of(price) >= 0;
         return std::ranges::any_of(boxes_,
-                                   [price](const auto& box) { return box && box->price() == price; });
+                                   [price](const Box& box) { return box.price() == price; });
     }
 
     Box* Column::get_box(double price) {
+        if (compact_ && compact_index_of(price) < 0) return nullptr;
+        expand();
         const auto it = std::ranges::find_if(boxes_,
-                                             [price](const auto& box) { return box && box->price() == price; });
-        return (it != boxes_.end()) ? it->get() : nullptr;
+                                             [price](const Box& box) { return box.price() == price; });
+        return (it != boxes_.end()) ? &*it : nullptr;
     }
 
     const Box* Column::get_box(double price) const {
+        if (compact_) return nullptr;
         const auto it = std::ranges::find_if(boxes_,
-                                             [price](const auto& box) { return box && box->price() == price; });
-        return (it != boxes_.end()) ? it->get() : nullptr;
+                                             [price](const Box& box) { return box.price() == price; });
+        return (it != boxes_.end()) ? &*it : nullptr;
     }
 
     Box* Column::get_box_at(const size_t index) {
-        return (index < boxes_.size()) ? boxes_[index].get() : nullptr;
+        if (index >= box_count()) return nullptr;
+        expand();
+        return (index < boxes_.size()) ? &boxes_[index] : nullptr;
     }
 
     const Box* Column::get_box_at(const size_t index) const {
-        return (index < boxes_.size()) ? boxes_[index].get() : nullptr;
+        if (compact_) return nullptr;
+        return (index < boxes_.size()) ? &boxes_[index] : nullptr;
+    }
+
+    Box Column::box_at(const size_t index) const {
+        if (index >= box_count()) return {0.0, BoxType::X};
+        if (compact_) return {compact_price(index), compact_type_, compact_marker(index)};
+        return boxes_[index];
     }
 
     std::string Column::get_box_marker(const double price) const {
+        if (compact_) {
+            const long index = compact_index_of(price);
+            return index >= 0 ? box_at(static_cast<size_t>(index)).marker() : std::string();
+        }
         const Box* box = get_box(price);
         return box ? box->marker() : std::string();
     }
@@ -74,30 +123,120 @@ namespace pnf
     }
 
     double Column::highest_price() const {
+        if (compact_) return step_ < 0.0 ? first_price_ : compact_price(compact_count_ - 1);
         if (boxes_.empty()) return 0.0;
         const auto it = std::ranges::max_element(boxes_,
-                                                 [](const auto& a, const auto& b) { return a->price() < b->price(); });
-        return (*it)->price();
+                                                 [](const Box& a, const Box& b) { return a.price() < b.price(); });
+        return it->price();
     }
 
     double Column::lowest_price() const {
+        if (compact_) return step_ < 0.0 ? compact_price(compact_count_ - 1) : first_price_;
         if (boxes_.empty()) return 0.0;
         const auto it = std::ranges::min_element(boxes_,
-                                                 [](const auto& a, const auto& b) { return a->price() < b->price(); });
-        return (*it)->price();
+                                                 [](const Box& a, const Box& b) { return a.price() < b.price(); });
+        return it->price();
     }
 
     void Column::clear() {
         boxes_.clear();
+        markers_.clear();
+        anchors_.clear();
+        compact_count_ = 0;
+        compact_ = false;
+    }
+
+    bool Column::compact() {
+        if (compact_) return true;
+        if (boxes_.empty()) return false;
+
+        const BoxType shared_type = boxes_.front().type();
+        double step = 0.0;
+        if (boxes_.size() > 1) {
+            const double diff = boxes_[1].price() - boxes_[0].price();
+            step = box_size_ > 0.0 ? (diff < 0.0 ? -box_size_ : box_size_) : diff;
+        }
+
+        size_t marked = 0;
+        double price = boxes_.front().price();
+        for (const auto& box : boxes_) {
+            if (box.type() != shared_type || box.price() != price) return false;
+            if (box.marker_id() != MarkerTable::none) ++marked;
+            price = price + step;
+        }
+
+        markers_.reserve(marked);
+        anchors_.reserve((boxes_.size() - 1) / anchor_stride);
+        for (size_t i = 0; i < boxes_.size(); i++) {
+            if (const MarkerId marker = boxes_[i].marker_id(); marker != MarkerTable::none)
+                markers_.push_back({static_cast<std::uint32_t>(i), marker});
+            if (i > 0 && i % anchor_stride == 0) anchors_.push_back(boxes_[i].price());
+        }
+        first_price_ = boxes_.front().price();
+        step_ = step;
+        compact_count_ = static_cast<std::uint32_t>(boxes_.size());
+        compact_type_ = shared_type;
+        compact_ = true;
+        std::pmr::vector<Box>(boxes_.get_allocator()).swap(boxes_);
+        return true;
+    }
+
+    void Column::expand() {
+        if (!compact_) return;
+        boxes_.reserve(compact_count_);
+        double price = first_price_;
+        for (size_t i = 0; i < compact_count_; i++) {
+            boxes_.emplace_back(price, compact_type_, compact_marker(i));
+            price = price + step_;
+        }
+        std::pmr::vector<MarkedBox>(markers_.get_allocator()).swap(markers_);
+        std::pmr::vector<double>(anchors_.get_allocator()).swap(anchors_);
+        compact_count_ = 0;
+        compact_ = false;
+    }
+
+    double Column::compact_price(const size_t index) const {
+        // Replays the chart's own price + box additions from the nearest anchor,
+        // so every rebuilt price is bit-identical to the one the chart stored.
+        const size_t block = index / anchor_stride;
+        double price = block > 0 ? anchors_[block - 1] : first_price_;
+        for (size_t i = block * anchor_stride; i < index; i++) price = price + step_;
+        return price;
+    }
+
+    MarkerId Column::compact_marker(const size_t index) const {
+        for (const auto& [marked_index, marker] : markers_) {
+            if (marked_index == index) return marker;
+        }
+        return MarkerTable::none;
+    }
+
+    long Column::compact_index_of(const double price) const {
+        // Replayed prices move monotonically with the step, so the anchors are
+        // sorted and the only block that can hold the price is found by bisection.
+        size_t block = 0;
+        if (step_ > 0.0) {
+            block = static_cast<size_t>(std::ranges::upper_bound(anchors_, price) - anchors_.begin());
+        } else if (step_ < 0.0) {
+            block = static_cast<size_t>(std::ranges::upper_bound(anchors_, price, std::ranges::greater{}) -
+                                        anchors_.begin());
+        }
+        double current = block > 0 ? anchors_[block - 1] : first_price_;
+        const size_t end = std::min<size_t>(compact_count_, (block + 1) * anchor_stride);
+        for (size_t i = block * anchor_stride; i < end; i++) {
+            if (current == price) return static_cast<long>(i);
+            current = current + step_;
+        }
+        return -1;
     }
 
     std::string Column::to_string() const {
         const char* type_str = (type_ == ColumnType::X) ? "X" :
                               (type_ == ColumnType::O) ? "O" : "Mixed";
         std::ostringstream oss;
-        oss << "Column Type: " << type_str << ", Boxes: " << boxes_.size() << "\n";
-        for (const auto& box : boxes_) {
-            if (box) oss << box->to_string() << "\n";
+        oss << "Column Type: " << type_str << ", Boxes: " << box_count() << "\n";
+        for (size_t i = 0; i < box_count(); i++) {
+            oss << box_at(i).to_string() << "\n";
         }
         return oss.str();
     }
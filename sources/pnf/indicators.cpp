@@ -7,36 +7,48 @@
 
 #include "pnf/indicators.hpp"
 #include <algorithm>
-#include <numeric>
 #include <sstream>
 #include <cmath>
 
 namespace pnf {
-    MovingAverage::MovingAverage(const int period) : period_(period) {}
+    namespace {
+        // col (or nothing for -1) followed by earlier columns of its type, newest first.
+        std::vector<int> same_type_chain(const Chart& chart, int col, const size_t count) {
+            std::vector<int> indices;
+            for (; col >= 0 && indices.size() < count; col = chart.previous_same_type(col)) indices.push_back(col);
+            return indices;
+        }
+    }
+
+    MovingAverage::MovingAverage(const int period, std::pmr::memory_resource* resource)
+        : period_(period), values_(resource ? resource : std::pmr::get_default_resource()) {}
 
     void MovingAverage::set_period(const int period) {
         period_ = period;
         values_.clear();
     }
 
-    double MovingAverage::column_average(const Column* col) {
-        if (!col || col->box_count() == 0) return 0.0;
-        return (col->highest_price() + col->lowest_price()) / 2.0;
-    }
-
     void MovingAverage::calculate(const Chart& chart) {
         values_.clear();
-        const size_t count = chart.column_count();
-        for (size_t i = 0; i < count; i++) {
-            if (static_cast<int>(i) < period_ - 1) {
-                values_.push_back(0.0);
-                continue;
-            }
-            double sum = 0.0;
-            for (int j = 0; j < period_; j++)
-                sum += column_average(chart.column(i - j));
-            values_.push_back(sum / period_);
+        const auto& midpoints = chart.column_midpoints();
+        while (values_.size() < midpoints.size()) append(midpoints);
+    }
+
+    void MovingAverage::truncate(const size_t count) {
+        if (count < values_.size()) values_.resize(count);
+    }
+
+    void MovingAverage::append(const std::span<const double> midpoints) {
+        const size_t i = values_.size();
+        if (i >= midpoints.size()) return;
+        if (static_cast<int>(i) < period_ - 1) {
+            values_.push_back(0.0);
+            return;
         }
+        double sum = 0.0;
+        for (int j = 0; j < period_; j++)
+            sum += midpoints[i - j];
+        values_.push_back(sum / period_);
     }
 
     double MovingAverage::value(const int column) const {
@@ -54,8 +66,9 @@ namespace pnf {
         return oss.str();
     }
 
-    BollingerBands::BollingerBands(const int period, const double std_devs)
-        : period_(period), std_devs_(std_devs) {}
+    BollingerBands::BollingerBands(const int period, const double std_devs, std::pmr::memory_resource* resource)
+        : period_(period), std_devs_(std_devs), middle_(resource ? resource : std::pmr::get_default_resource()),
+          upper_(middle_.get_allocator()), lower_(middle_.get_allocator()) {}
 
     void BollingerBands::set_period(const int period) {
         period_ = period;
@@ -68,42 +81,46 @@ namespace pnf {
         std_devs_ = devs;
     }
 
-    double BollingerBands::std_deviation(const std::vector<double>& vals, const double mean) {
-        double sum = 0.0;
-        for (const double v : vals) {
-            const double diff = v - mean;
-            sum += diff * diff;
-        }
-        return std::sqrt(sum / static_cast<double>(vals.size()));
-    }
 
     void BollingerBands::calculate(const Chart& chart) {
         middle_.clear();
         upper_.clear();
         lower_.clear();
+        const auto& midpoints = chart.column_midpoints();
+        while (middle_.size() < midpoints.size()) append(midpoints);
+    }
 
-        const size_t count = chart.column_count();
-        for (size_t i = 0; i < count; i++) {
-            if (static_cast<int>(i) < period_ - 1) {
-                middle_.push_back(0.0);
-                upper_.push_back(0.0);
-                lower_.push_back(0.0);
-                continue;
-            }
-
-            std::vector<double> avgs;
-            for (int j = 0; j < period_; j++) {
-                const Column* col = chart.column(i - j);
-                avgs.push_back((col->highest_price() + col->lowest_price()) / 2.0);
-            }
+    void BollingerBands::truncate(const size_t count) {
+        if (count >= middle_.size()) return;
+        middle_.resize(count);
+        upper_.resize(count);
+        lower_.resize(count);
+    }
 
-            double mean = std::accumulate(avgs.begin(), avgs.end(), 0.0) / period_;
-            const double stddev = std_deviation(avgs, mean);
+    void BollingerBands::append(const std::span<const double> midpoints) {
+        const size_t i = middle_.size();
+        if (i >= midpoints.size()) return;
+        if (static_cast<int>(i) < period_ - 1) {
+            middle_.push_back(0.0);
+            upper_.push_back(0.0);
+            lower_.push_back(0.0);
+            return;
+        }
 
-            middle_.push_back(mean);
-            upper_.push_back(mean + std_devs_ * stddev);
-            lower_.push_back(mean - std_devs_ * stddev);
+        // The window is summed newest first, as the band has always been.
+        double sum = 0.0;
+        for (int j = 0; j < period_; j++) sum += midpoints[i - j];
+        const double mean = sum / period_;
+        double squares = 0.0;
+        for (int j = 0; j < period_; j++) {
+            const double diff = midpoints[i - j] - mean;
+            squares += diff * diff;
         }
+        const double stddev = std::sqrt(squares / static_cast<double>(period_));
+
+        middle_.push_back(mean);
+        upper_.push_back(mean + std_devs_ * stddev);
+        lower_.push_back(mean - std_devs_ * stddev);
     }
 
     double BollingerBands::middle(const int column) const {
@@ -130,6 +147,14 @@ namespace pnf {
         return has_value(column) && price < lower_[column];
     }
 
+    ColumnMask BollingerBands::above_upper_mask(const std::span<const double> prices) const {
+        return mask_greater(prices, upper_, static_cast<size_t>(std::max(period_ - 1, 0)));
+    }
+
+    ColumnMask BollingerBands::below_lower_mask(const std::span<const double> prices) const {
+        return mask_less(prices, lower_, static_cast<size_t>(std::max(period_ - 1, 0)));
+    }
+
     std::string BollingerBands::to_string() const {
         std::ostringstream oss;
         oss << "Bollinger Bands(" << period_ << ", " << std_devs_ << "): "
@@ -137,7 +162,8 @@ namespace pnf {
         return oss.str();
     }
 
-    RSI::RSI(const int period) : period_(period) {}
+    RSI::RSI(const int period, std::pmr::memory_resource* resource)
+        : period_(period), values_(resource ? resource : std::pmr::get_default_resource()) {}
 
     void RSI::set_period(const int period) {
         period_ = period;
@@ -151,43 +177,37 @@ namespace pnf {
 
     void RSI::calculate(const Chart& chart) {
         values_.clear();
-        const size_t count = chart.column_count();
-        if (count < 2) return;
-
-        std::vector<double> gains, losses;
-        for (size_t i = 1; i < count; i++) {
-            const Column* curr = chart.column(i);
-            const Column* prev = chart.column(i - 1);
-            const double curr_avg = (curr->highest_price() + curr->lowest_price()) / 2.0;
-            const double prev_avg = (prev->highest_price() + prev->lowest_price()) / 2.0;
-            double change = curr_avg - prev_avg;
-            gains.push_back(change > 0 ? change : 0);
-            losses.push_back(change < 0 ? -change : 0);
+        const auto& midpoints = chart.column_midpoints();
+        while (values_.size() < midpoints.size() && midpoints.size() >= 2) append(midpoints);
+    }
+
+    void RSI::truncate(const size_t count) {
+        if (count < values_.size()) values_.resize(count);
+    }
+
+    void RSI::append(const std::span<const double> midpoints) {
+        const size_t i = values_.size();
+        if (i >= midpoints.size() || midpoints.size() < 2) return;
+        if (i == 0 || static_cast<int>(i) < period_) {
+            values_.push_back(50.0);
+            return;
         }
 
-        values_.push_back(50.0);
-        for (size_t i = 1; i < count; i++) {
-            if (static_cast<int>(i) < period_) {
-                values_.push_back(50.0);
-                continue;
-            }
+        double avg_gain = 0, avg_loss = 0;
+        for (int j = 0; j < period_; j++) {
+            const size_t idx = i - 1 - j;
+            const double change = midpoints[idx + 1] - midpoints[idx];
+            avg_gain += change > 0 ? change : 0;
+            avg_loss += change < 0 ? -change : 0;
+        }
+        avg_gain /= period_;
+        avg_loss /= period_;
 
-            double avg_gain = 0, avg_loss = 0;
-            for (int j = 0; j < period_; j++) {
-                if (const size_t idx = i - 1 - j; idx < gains.size()) {
-                    avg_gain += gains[idx];
-                    avg_loss += losses[idx];
-                }
-            }
-            avg_gain /= period_;
-            avg_loss /= period_;
-
-            if (avg_loss == 0) {
-                values_.push_back(100.0);
-            } else {
-                const double rs = avg_gain / avg_loss;
-                values_.push_back(100.0 - (100.0 / (1.0 + rs)));
-            }
+        if (avg_loss == 0) {
+            values_.push_back(100.0);
+        } else {
+            const double rs = avg_gain / avg_loss;
+            values_.push_back(100.0 - (100.0 / (1.0 + rs)));
         }
     }
 
@@ -215,12 +235,40 @@ namespace pnf {
         return has_value(column) && values_[column] < threshold;
     }
 
+    ColumnMask RSI::overbought_mask() const {
+        return overbought_mask(overbought_);
+    }
+
+    ColumnMask RSI::oversold_mask() const {
+        return oversold_mask(oversold_);
+    }
+
+    ColumnMask RSI::overbought_mask(const double threshold) const {
+        return mask_greater(values_, threshold, static_cast<size_t>(std::max(period_, 0)));
+    }
+
+    ColumnMask RSI::oversold_mask(const double threshold) const {
+        return mask_less(values_, threshold, static_cast<size_t>(std::max(period_, 0)));
+    }
+
+    ColumnMask RSI::cross_above_mask(const double threshold) const {
+        // The first real value follows placeholder 50s, so crossings start one column later.
+        return mask_cross_above(values_, threshold, static_cast<size_t>(std::max(period_, 0)) + 1);
+    }
+
+    ColumnMask RSI::cross_below_mask(const double threshold) const {
+        return mask_cross_below(values_, threshold, static_cast<size_t>(std::max(period_, 0)) + 1);
+    }
+
     std::string RSI::to_string() const {
         std::ostringstream oss;
         oss << "RSI(" << period_ << "): " << values_.size() << " values";
         return oss.str();
     }
 
+    OnBalanceVolume::OnBalanceVolume(std::pmr::memory_resource* resource)
+        : values_(resource ? resource : std::pmr::get_default_resource()) {}
+
     void OnBalanceVolume::calculate(const Chart& chart, const std::vector<OHLC>& ohlc_data) {
         values_.clear();
         if (ohlc_data.empty()) return;
@@ -251,17 +299,33 @@ namespace pnf {
     }
 
     void BullishPercent::calculate(const Chart& chart) {
+        settled_ = 0;
+        settled_x_ = 0;
+        update(chart, 0);
+    }
+
+    void BullishPercent::update(const Chart& chart, const size_t first) {
         const size_t count = chart.column_count();
         if (count == 0) {
             value_ = 50.0;
+            settled_ = 0;
+            settled_x_ = 0;
             return;
         }
 
-        size_t bullish = 0;
-        for (size_t i = 0; i < count; i++) {
-            if (const Column* col = chart.column(i); col && col->type() == ColumnType::X)
-                bullish++;
+        const auto is_x = [&chart](const size_t i) {
+            const Column* col = chart.column(i);
+            return col && col->type() == ColumnType::X;
+        };
+        // Columns before first are unchanged, so their count can be kept.
+        if (settled_ > first || settled_ >= count) {
+            settled_ = 0;
+            settled_x_ = 0;
+        }
+        for (; settled_ + 1 < count; settled_++) {
+            if (is_x(settled_)) settled_x_++;
         }
+        const size_t bullish = settled_x_ + (is_x(count - 1) ? 1 : 0);
         value_ = (static_cast<double>(bullish) / static_cast<double>(count)) * 100.0;
     }
 
@@ -276,18 +340,15 @@ namespace pnf {
         return oss.str();
     }
 
+    SignalDetector::SignalDetector(std::pmr::memory_resource* resource)
+        : signals_(resource ? resource : std::pmr::get_default_resource()) {}
+
     bool SignalDetector::is_buy_signal(const Chart& chart, const int column) {
         if (column < 2) return false;
         const Column* curr = chart.column(column);
         if (curr->type() != ColumnType::X) return false;
 
-        int prev_x = -1;
-        for (int i = column - 1; i >= 0; i--) {
-            if (chart.column(i)->type() == ColumnType::X) {
-                prev_x = i;
-                break;
-            }
-        }
+        const int prev_x = chart.previous_same_type(column);
         if (prev_x < 0) return false;
         return curr->highest_price() > chart.column(prev_x)->highest_price();
     }
@@ -297,35 +358,38 @@ namespace pnf {
         const Column* curr = chart.column(column);
         if (curr->type() != ColumnType::O) return false;
 
-        int prev_o = -1;
-        for (int i = column - 1; i >= 0; i--) {
-            if (chart.column(i)->type() == ColumnType::O) {
-                prev_o = i;
-                break;
-            }
-        }
+        const int prev_o = chart.previous_same_type(column);
         if (prev_o < 0) return false;
         return curr->lowest_price() < chart.column(prev_o)->lowest_price();
     }
 
+    SignalType SignalDetector::signal_at(const Chart& chart, const int column) {
+        if (is_buy_signal(chart, column)) return SignalType::Buy;
+        if (is_sell_signal(chart, column)) return SignalType::Sell;
+        return SignalType::None;
+    }
+
     void SignalDetector::detect(const Chart& chart) {
         signals_.clear();
-        current_ = SignalType::None;
+        detect_from(chart, 0);
+    }
+
+    void SignalDetector::detect_from(const Chart& chart, const size_t first) {
+        std::erase_if(signals_, [first](const Signal& s) { return s.column_index >= static_cast<int>(first); });
 
         const size_t count = chart.column_count();
-        for (size_t i = 0; i < count; i++) {
+        for (size_t i = first; i < count; i++) {
             if (is_buy_signal(chart, static_cast<int>(i))) {
                 const Column* col = chart.column(i);
                 signals_.push_back({SignalType::Buy, static_cast<int>(i),
                                    col->highest_price(), std::chrono::system_clock::now()});
-                current_ = SignalType::Buy;
             } else if (is_sell_signal(chart, static_cast<int>(i))) {
                 const Column* col = chart.column(i);
                 signals_.push_back({SignalType::Sell, static_cast<int>(i),
                                    col->lowest_price(), std::chrono::system_clock::now()});
-                current_ = SignalType::Sell;
             }
         }
+        current_ = signals_.empty() ? SignalType::None : signals_.back().type;
     }
 
     Signal SignalDetector::last_signal() const {
@@ -335,19 +399,13 @@ namespace pnf {
     }
 
     std::vector<Signal> SignalDetector::buy_signals() const {
-        std::vector<Signal> result;
-        for (const auto& s : signals_) {
-            if (s.type == SignalType::Buy) result.push_back(s);
-        }
-        return result;
+        auto view = buy_signals_view();
+        return {view.begin(), view.end()};
     }
 
     std::vector<Signal> SignalDetector::sell_signals() const {
-        std::vector<Signal> result;
-        for (const auto& s : signals_) {
-            if (s.type == SignalType::Sell) result.push_back(s);
-        }
-        return result;
+        auto view = sell_signals_view();
+        return {view.begin(), view.end()};
     }
 
     int SignalDetector::buy_count() const {
@@ -368,15 +426,15 @@ namespace pnf {
         return oss.str();
     }
 
+    PatternRecognizer::PatternRecognizer(std::pmr::memory_resource* resource)
+        : patterns_(resource ? resource : std::pmr::get_default_resource()), column_offsets_(patterns_.get_allocator()) {}
+
     bool PatternRecognizer::detect_double_top_breakout(const Chart& chart, const int col) {
         if (col < 2) return false;
         const Column* curr = chart.column(col);
         if (curr->type() != ColumnType::X) return false;
 
-        int prev_x = -1;
-        for (int i = col - 1; i >= 0; i--) {
-            if (chart.column(i)->type() == ColumnType::X) { prev_x = i; break; }
-        }
+        const int prev_x = chart.previous_same_type(col);
         if (prev_x < 0) return false;
 
         const double curr_high = curr->highest_price();
@@ -392,10 +450,7 @@ namespace pnf {
         const Column* curr = chart.column(col);
         if (curr->type() != ColumnType::O) return false;
 
-        int prev_o = -1;
-        for (int i = col - 1; i >= 0; i--) {
-            if (chart.column(i)->type() == ColumnType::O) { prev_o = i; break; }
-        }
+        const int prev_o = chart.previous_same_type(col);
         if (prev_o < 0) return false;
 
         const double curr_low = curr->lowest_price();
@@ -410,10 +465,7 @@ namespace pnf {
         if (col < 4) return false;
         if (const Column* curr = chart.column(col); curr->type() != ColumnType::X) return false;
 
-        std::vector<int> x_indices;
-        for (int i = col; i >= 0 && x_indices.size() < 3; i--) {
-            if (chart.column(i)->type() == ColumnType::X) x_indices.push_back(i);
-        }
+        const std::vector<int> x_indices = same_type_chain(chart, col, 3);
         if (x_indices.size() < 3) return false;
 
         const double h0 = chart.column(x_indices[0])->highest_price();
@@ -431,10 +483,7 @@ namespace pnf {
         if (col < 4) return false;
         if (const Column* curr = chart.column(col); curr->type() != ColumnType::O) return false;
 
-        std::vector<int> o_indices;
-        for (int i = col; i >= 0 && o_indices.size() < 3; i--) {
-            if (chart.column(i)->type() == ColumnType::O) o_indices.push_back(i);
-        }
+        const std::vector<int> o_indices = same_type_chain(chart, col, 3);
         if (o_indices.size() < 3) return false;
 
         const double l0 = chart.column(o_indices[0])->lowest_price();
@@ -451,10 +500,7 @@ namespace pnf {
         if (col < 6) return false;
         if (chart.column(col)->type() != ColumnType::X) return false;
 
-        std::vector<int> x_indices;
-        for (int i = col; i >= 0 && x_indices.size() < 4; i--) {
-            if (chart.column(i)->type() == ColumnType::X) x_indices.push_back(i);
-        }
+        const std::vector<int> x_indices = same_type_chain(chart, col, 4);
         if (x_indices.size() < 4) return false;
 
         const double h0 = chart.column(x_indices[0])->highest_price();
@@ -472,10 +518,7 @@ namespace pnf {
         if (col < 6) return false;
         if (chart.column(col)->type() != ColumnType::O) return false;
 
-        std::vector<int> o_indices;
-        for (int i = col; i >= 0 && o_indices.size() < 4; i--) {
-            if (chart.column(i)->type() == ColumnType::O) o_indices.push_back(i);
-        }
+        const std::vector<int> o_indices = same_type_chain(chart, col, 4);
         if (o_indices.size() < 4) return false;
 
         const double l0 = chart.column(o_indices[0])->lowest_price();
@@ -493,10 +536,7 @@ namespace pnf {
         if (col < 4) return false;
         if (chart.column(col)->type() != ColumnType::X) return false;
 
-        std::vector<int> x_indices;
-        for (int i = col; i >= 0 && x_indices.size() < 3; i--) {
-            if (chart.column(i)->type() == ColumnType::X) x_indices.push_back(i);
-        }
+        const std::vector<int> x_indices = same_type_chain(chart, col, 3);
         if (x_indices.size() < 3) return false;
 
         const double h0 = chart.column(x_indices[0])->highest_price();
@@ -513,10 +553,7 @@ namespace pnf {
         if (col < 4) return false;
         if (chart.column(col)->type() != ColumnType::O) return false;
 
-        std::vector<int> o_indices;
-        for (int i = col; i >= 0 && o_indices.size() < 3; i--) {
-            if (chart.column(i)->type() == ColumnType::O) o_indices.push_back(i);
-        }
+        const std::vector<int> o_indices = same_type_chain(chart, col, 3);
         if (o_indices.size() < 3) return false;
 
         const double l0 = chart.column(o_indices[0])->lowest_price();
@@ -529,28 +566,38 @@ namespace pnf {
         return false;
     }
 
-    bool PatternRecognizer::detect_bullish_catapult(const int col) {
-        if (patterns_.size() < 2) return false;
-        if (const Pattern& last = patterns_[patterns_.size() - 1]; last.type == PatternType::DoubleTopBreakout && last.end_column == col) {
-            if (const Pattern& second_last = patterns_[patterns_.size() - 2]; second_last.type == PatternType::TripleTopBreakout) {
-                patterns_.push_back({PatternType::BullishCatapult,
-                                   second_last.start_column, col, last.price});
+    bool PatternRecognizer::detect_catapult(const int col, const PatternType breakout, const PatternType setup,
+                                            const PatternType catapult) {
+        // The column's own patterns come last; the ascending triple top always
+        // fires alongside the second breakout, so look past them.
+        size_t first = patterns_.size();
+        const Pattern* trigger = nullptr;
+        while (first > 0 && patterns_[first - 1].end_column == col) {
+            if (patterns_[first - 1].type == breakout) trigger = &patterns_[first - 1];
+            first--;
+        }
+        if (!trigger || first == 0) return false;
+        const double price = trigger->price;
+
+        // The setup must be among the patterns of the latest earlier column that had any.
+        const int previous = patterns_[first - 1].end_column;
+        for (size_t i = first; i > 0 && patterns_[i - 1].end_column == previous; i--) {
+            if (patterns_[i - 1].type == setup) {
+                patterns_.push_back({catapult, patterns_[i - 1].start_column, col, price});
                 return true;
             }
         }
         return false;
     }
 
+    bool PatternRecognizer::detect_bullish_catapult(const int col) {
+        return detect_catapult(col, PatternType::DoubleTopBreakout, PatternType::TripleTopBreakout,
+                               PatternType::BullishCatapult);
+    }
+
     bool PatternRecognizer::detect_bearish_catapult(const int col) {
-        if (patterns_.size() < 2) return false;
-        if (const Pattern& last = patterns_[patterns_.size() - 1]; last.type == PatternType::DoubleBottomBreakdown && last.end_column == col) {
-            if (const Pattern& second_last = patterns_[patterns_.size() - 2]; second_last.type == PatternType::TripleBottomBreakdown) {
-                patterns_.push_back({PatternType::BearishCatapult,
-                                   second_last.start_column, col, last.price});
-                return true;
-            }
-        }
-        return false;
+        return detect_catapult(col, PatternType::DoubleBottomBreakdown, PatternType::TripleBottomBreakdown,
+                               PatternType::BearishCatapult);
     }
 
     bool PatternRecognizer::detect_bullish_signal_reversed(const Chart& chart, const int col) {
@@ -569,10 +616,7 @@ namespace pnf {
         }
 
         if (rising) {
-            int prev_o = -1;
-            for (int i = col - 1; i >= 0; i--) {
-                if (chart.column(i)->type() == ColumnType::O) { prev_o = i; break; }
-            }
+            const int prev_o = chart.previous_same_type(col);
             if (prev_o >= 0 && curr->lowest_price() < chart.column(prev_o)->lowest_price()) {
                 patterns_.push_back({PatternType::BullishSignalReversed, col - 5, col,
                                    curr->lowest_price()});
@@ -598,10 +642,7 @@ namespace pnf {
         }
 
         if (falling) {
-            int prev_x = -1;
-            for (int i = col - 1; i >= 0; i--) {
-                if (chart.column(i)->type() == ColumnType::X) { prev_x = i; break; }
-            }
+            const int prev_x = chart.previous_same_type(col);
             if (prev_x >= 0 && curr->highest_price() > chart.column(prev_x)->highest_price()) {
                 patterns_.push_back({PatternType::BearishSignalReversed, col - 5, col,
                                    curr->highest_price()});
@@ -625,10 +666,7 @@ namespace pnf {
         }
 
         if (rising_bottoms && falling_tops) {
-            int prev_x = -1;
-            for (int i = col - 1; i >= 0; i--) {
-                if (chart.column(i)->type() == ColumnType::X) { prev_x = i; break; }
-            }
+            const int prev_x = chart.previous_same_type(col);
             if (prev_x >= 0 && curr->highest_price() > chart.column(prev_x)->highest_price()) {
                 patterns_.push_back({PatternType::BullishTriangle, col - 5, col,
                                    curr->highest_price()});
@@ -652,10 +690,7 @@ namespace pnf {
         }
 
         if (rising_bottoms && falling_tops) {
-            int prev_o = -1;
-            for (int i = col - 1; i >= 0; i--) {
-                if (chart.column(i)->type() == ColumnType::O) { prev_o = i; break; }
-            }
+            const int prev_o = chart.previous_same_type(col);
             if (prev_o >= 0 && curr->lowest_price() < chart.column(prev_o)->lowest_price()) {
                 patterns_.push_back({PatternType::BearishTriangle, col - 5, col,
                                    curr->lowest_price()});
@@ -685,17 +720,12 @@ namespace pnf {
         if (prev_x->type() != ColumnType::X || prev_x->box_count() < 2) return false;
 
         double prev_high = 0;
-        for (int i = col - 2; i >= 0; i--) {
-            if (chart.column(i)->type() == ColumnType::X) {
-                prev_high = chart.column(i)->highest_price();
-                break;
-            }
-        }
+        if (const int i = chart.previous_same_type(col - 1); i >= 0) prev_high = chart.column(i)->highest_price();
 
         if (prev_high > 0) {
             const double rise = prev_x->highest_price() - prev_high;
-            const double box_size = std::abs(prev_x->get_box_at(prev_x->box_count()-1)->price() -
-                                       prev_x->get_box_at(prev_x->box_count()-2)->price());
+            const double box_size = std::abs(prev_x->box_at(prev_x->box_count()-1).price() -
+                                       prev_x->box_at(prev_x->box_count()-2).price());
             if (const double retracement = prev_x->highest_price() - curr->lowest_price(); rise >= 3 * box_size && retracement >= rise * 0.5) {
                 patterns_.push_back({PatternType::HighPole, col - 1, col,
                                    prev_x->highest_price()});
@@ -714,17 +744,12 @@ namespace pnf {
         if (prev_o->type() != ColumnType::O || prev_o->box_count() < 2) return false;
 
         double prev_low = 0;
-        for (int i = col - 2; i >= 0; i--) {
-            if (chart.column(i)->type() == ColumnType::O) {
-                prev_low = chart.column(i)->lowest_price();
-                break;
-            }
-        }
+        if (const int i = chart.previous_same_type(col - 1); i >= 0) prev_low = chart.column(i)->lowest_price();
 
         if (prev_low > 0) {
             const double fall = prev_low - prev_o->lowest_price();
-            const double box_size = std::abs(prev_o->get_box_at(prev_o->box_count()-2)->price() -
-                                       prev_o->get_box_at(prev_o->box_count()-1)->price());
+            const double box_size = std::abs(prev_o->box_at(prev_o->box_count()-2).price() -
+                                       prev_o->box_at(prev_o->box_count()-1).price());
             if (const double retracement = curr->highest_price() - prev_o->lowest_price(); fall >= 3 * box_size && retracement >= fall * 0.5) {
                 patterns_.push_back({PatternType::LowPole, col - 1, col,
                                    prev_o->lowest_price()});
@@ -741,10 +766,7 @@ namespace pnf {
         const Column* prev = chart.column(col - 1);
         if (prev->type() != ColumnType::X || prev->box_count() != 1) return false;
 
-        std::vector<int> x_indices;
-        for (int i = col - 2; i >= 0 && x_indices.size() < 3; i--) {
-            if (chart.column(i)->type() == ColumnType::X) x_indices.push_back(i);
-        }
+        const std::vector<int> x_indices = same_type_chain(chart, chart.previous_same_type(col - 1), 3);
 
         if (x_indices.size() >= 2) {
             const double h0 = chart.column(x_indices[0])->highest_price();
@@ -764,10 +786,7 @@ namespace pnf {
         const Column* prev = chart.column(col - 1);
         if (prev->type() != ColumnType::O || prev->box_count() != 1) return false;
 
-        std::vector<int> o_indices;
-        for (int i = col - 2; i >= 0 && o_indices.size() < 3; i--) {
-            if (chart.column(i)->type() == ColumnType::O) o_indices.push_back(i);
-        }
+        const std::vector<int> o_indices = same_type_chain(chart, chart.previous_same_type(col - 1), 3);
 
         if (o_indices.size() >= 2) {
             const double l0 = chart.column(o_indices[0])->lowest_price();
@@ -784,20 +803,17 @@ namespace pnf {
         if (col < 4) return false;
         if (chart.column(col)->type() != ColumnType::X) return false;
 
-        std::vector<int> x_indices;
-        for (int i = col; i >= 0; i--) {
-            if (chart.column(i)->type() == ColumnType::X) x_indices.push_back(i);
-        }
-        if (x_indices.size() < 3) return false;
-
-        const double curr_high = chart.column(x_indices[0])->highest_price();
+        const double curr_high = chart.column(col)->highest_price();
         int match_count = 0;
-        for (size_t i = 1; i < x_indices.size() && match_count < 2; i++) {
-            if (const double high = chart.column(x_indices[i])->highest_price(); std::abs(high - curr_high) < 0.0001) match_count++;
+        int seen = 1;
+        int third = -1;
+        for (int i = chart.previous_same_type(col); i >= 0 && match_count < 2; i = chart.previous_same_type(i)) {
+            if (++seen == 3) third = i;
+            if (const double high = chart.column(i)->highest_price(); std::abs(high - curr_high) < 0.0001) match_count++;
         }
 
         if (match_count >= 2) {
-            patterns_.push_back({PatternType::SpreadTripleTop, x_indices[2], col, curr_high});
+            patterns_.push_back({PatternType::SpreadTripleTop, third, col, curr_high});
             return true;
         }
         return false;
@@ -807,76 +823,79 @@ namespace pnf {
         if (col < 4) return false;
         if (chart.column(col)->type() != ColumnType::O) return false;
 
-        std::vector<int> o_indices;
-        for (int i = col; i >= 0; i--) {
-            if (chart.column(i)->type() == ColumnType::O) o_indices.push_back(i);
-        }
-        if (o_indices.size() < 3) return false;
-
-        const double curr_low = chart.column(o_indices[0])->lowest_price();
+        const double curr_low = chart.column(col)->lowest_price();
         int match_count = 0;
-        for (size_t i = 1; i < o_indices.size() && match_count < 2; i++) {
-            if (const double low = chart.column(o_indices[i])->lowest_price(); std::abs(low - curr_low) < 0.0001) match_count++;
+        int seen = 1;
+        int third = -1;
+        for (int i = chart.previous_same_type(col); i >= 0 && match_count < 2; i = chart.previous_same_type(i)) {
+            if (++seen == 3) third = i;
+            if (const double low = chart.column(i)->lowest_price(); std::abs(low - curr_low) < 0.0001) match_count++;
         }
 
         if (match_count >= 2) {
-            patterns_.push_back({PatternType::SpreadTripleBottom, o_indices[2], col, curr_low});
+            patterns_.push_back({PatternType::SpreadTripleBottom, third, col, curr_low});
             return true;
         }
         return false;
     }
 
+    int PatternRecognizer::detect_column(const Chart& chart, const int col) {
+        const size_t before = patterns_.size();
+        detect_double_top_breakout(chart, col);
+        detect_double_bottom_breakdown(chart, col);
+        detect_triple_top_breakout(chart, col);
+        detect_triple_bottom_breakdown(chart, col);
+        detect_quadruple_top_breakout(chart, col);
+        detect_quadruple_bottom_breakdown(chart, col);
+        detect_ascending_triple_top(chart, col);
+        detect_descending_triple_bottom(chart, col);
+        detect_bullish_catapult(col);
+        detect_bearish_catapult(col);
+        detect_bullish_signal_reversed(chart, col);
+        detect_bearish_signal_reversed(chart, col);
+        detect_bullish_triangle(chart, col);
+        detect_bearish_triangle(chart, col);
+        detect_long_tail_down(chart, col);
+        detect_high_pole(chart, col);
+        detect_low_pole(chart, col);
+        detect_bull_trap(chart, col);
+        detect_bear_trap(chart, col);
+        detect_spread_triple_top(chart, col);
+        detect_spread_triple_bottom(chart, col);
+        return static_cast<int>(patterns_.size() - before);
+    }
+
     void PatternRecognizer::detect(const Chart& chart) {
-        patterns_.clear();
+        clear();
+        detect_from(chart, 0);
+    }
+
+    void PatternRecognizer::detect_from(const Chart& chart, const size_t first) {
+        // Roll back to the state before first was visited; catapults read earlier patterns.
+        if (first < column_offsets_.size()) {
+            patterns_.erase(patterns_.begin() + static_cast<std::ptrdiff_t>(column_offsets_[first]), patterns_.end());
+            column_offsets_.resize(first);
+        }
         const size_t count = chart.column_count();
-        for (size_t i = 0; i < count; i++) {
-            const int col = static_cast<int>(i);
-            detect_double_top_breakout(chart, col);
-            detect_double_bottom_breakdown(chart, col);
-            detect_triple_top_breakout(chart, col);
-            detect_triple_bottom_breakdown(chart, col);
-            detect_quadruple_top_breakout(chart, col);
-            detect_quadruple_bottom_breakdown(chart, col);
-            detect_ascending_triple_top(chart, col);
-            detect_descending_triple_bottom(chart, col);
-            detect_bullish_catapult(col);
-            detect_bearish_catapult(col);
-            detect_bullish_signal_reversed(chart, col);
-            detect_bearish_signal_reversed(chart, col);
-            detect_bullish_triangle(chart, col);
-            detect_bearish_triangle(chart, col);
-            detect_long_tail_down(chart, col);
-            detect_high_pole(chart, col);
-            detect_low_pole(chart, col);
-            detect_bull_trap(chart, col);
-            detect_bear_trap(chart, col);
-            detect_spread_triple_top(chart, col);
-            detect_spread_triple_bottom(chart, col);
+        for (size_t i = column_offsets_.size(); i < count; i++) {
+            column_offsets_.push_back(patterns_.size());
+            detect_column(chart, static_cast<int>(i));
         }
     }
 
     std::vector<Pattern> PatternRecognizer::bullish_patterns() const {
-        std::vector<Pattern> result;
-        for (const auto& p : patterns_) {
-            if (is_bullish_pattern(p.type)) result.push_back(p);
-        }
-        return result;
+        auto view = bullish_patterns_view();
+        return {view.begin(), view.end()};
     }
 
     std::vector<Pattern> PatternRecognizer::bearish_patterns() const {
-        std::vector<Pattern> result;
-        for (const auto& p : patterns_) {
-            if (is_bearish_pattern(p.type)) result.push_back(p);
-        }
-        return result;
+        auto view = bearish_patterns_view();
+        return {view.begin(), view.end()};
     }
 
     std::vector<Pattern> PatternRecognizer::patterns_of_type(PatternType type) const {
-        std::vector<Pattern> result;
-        for (const auto& p : patterns_) {
-            if (p.type == type) result.push_back(p);
-        }
-        return result;
+        auto view = patterns_of_type_view(type);
+        return {view.begin(), view.end()};
     }
 
     int PatternRecognizer::bullish_count() const {
@@ -909,17 +928,22 @@ namespace pnf {
         return oss.str();
     }
 
-    SupportResistance::SupportResistance(const double threshold) : threshold_(threshold) {}
+    SupportResistance::SupportResistance(const double threshold, std::pmr::memory_resource* resource)
+        : levels_(resource ? resource : std::pmr::get_default_resource()), threshold_(threshold) {}
 
     void SupportResistance::set_threshold(const double threshold) {
         threshold_ = threshold;
     }
 
     void SupportResistance::identify(const Chart& chart) {
+        identify_since(chart, 0);
+    }
+
+    void SupportResistance::identify_since(const Chart& chart, const size_t first) {
         levels_.clear();
         const size_t count = chart.column_count();
 
-        for (size_t i = 0; i < count; i++) {
+        for (size_t i = first; i < count; i++) {
             if (const Column* col = chart.column(i); col->type() == ColumnType::O) {
                 const double low = col->lowest_price();
                 bool found = false;
@@ -972,43 +996,28 @@ namespace pnf {
     }
 
     std::vector<SupportResistanceLevel> SupportResistance::support_levels() const {
-        std::vector<SupportResistanceLevel> result;
-        for (const auto& l : levels_) {
-            if (l.is_support) result.push_back(l);
-        }
-        return result;
+        auto view = support_levels_view();
+        return {view.begin(), view.end()};
     }
 
     std::vector<SupportResistanceLevel> SupportResistance::resistance_levels() const {
-        std::vector<SupportResistanceLevel> result;
-        for (const auto& l : levels_) {
-            if (!l.is_support) result.push_back(l);
-        }
-        return result;
+        auto view = resistance_levels_view();
+        return {view.begin(), view.end()};
     }
 
     std::vector<SupportResistanceLevel> SupportResistance::significant_levels(const int min_touches) const {
-        std::vector<SupportResistanceLevel> result;
-        for (const auto& l : levels_) {
-            if (l.touch_count >= min_touches) result.push_back(l);
-        }
-        return result;
+        auto view = significant_levels_view(min_touches);
+        return {view.begin(), view.end()};
     }
 
     std::vector<double> SupportResistance::support_prices() const {
-        std::vector<double> result;
-        for (const auto& l : levels_) {
-            if (l.is_support) result.push_back(l.price);
-        }
-        return result;
+        auto view = support_prices_view();
+        return {view.begin(), view.end()};
     }
 
     std::vector<double> SupportResistance::resistance_prices() const {
-        std::vector<double> result;
-        for (const auto& l : levels_) {
-            if (!l.is_support) result.push_back(l.price);
-        }
-        return result;
+        auto view = resistance_prices_view();
+        return {view.begin(), view.end()};
     }
 
     bool SupportResistance::is_near_support(double price, double tolerance) const {
@@ -1025,6 +1034,14 @@ namespace pnf {
                                    });
     }
 
+    ColumnMask SupportResistance::near_support_mask(const std::span<const double> prices, const double tolerance) const {
+        return mask_near_any(prices, support_prices(), tolerance);
+    }
+
+    ColumnMask SupportResistance::near_resistance_mask(const std::span<const double> prices, const double tolerance) const {
+        return mask_near_any(prices, resistance_prices(), tolerance);
+    }
+
     std::string SupportResistance::to_string() const {
         std::ostringstream oss;
         oss << "Support/Resistance: " << levels_.size() << " levels\n";
@@ -1039,6 +1056,9 @@ namespace pnf {
         return oss.str();
     }
 
+    PriceObjectiveCalculator::PriceObjectiveCalculator(std::pmr::memory_resource* resource)
+        : objectives_(resource ? resource : std::pmr::get_default_resource()) {}
+
     void PriceObjectiveCalculator::calculate_vertical_count(const Chart& chart, const int column) {
         if (column < 2) return;
         const Column* curr = chart.column(column);
@@ -1046,8 +1066,8 @@ namespace pnf {
         if (box_count < 2) return;
 
         const double box_size = (curr->type() == ColumnType::X) ?
-            std::abs(curr->get_box_at(box_count-1)->price() - curr->get_box_at(box_count-2)->price()) :
-            std::abs(curr->get_box_at(box_count-2)->price() - curr->get_box_at(box_count-1)->price());
+            std::abs(curr->box_at(box_count-1).price() - curr->box_at(box_count-2).price()) :
+            std::abs(curr->box_at(box_count-2).price() - curr->box_at(box_count-1).price());
 
         if (curr->type() == ColumnType::X) {
             const double target = curr->highest_price() + (static_cast<double>(box_count) * box_size);
@@ -1072,35 +1092,23 @@ namespace pnf {
     }
 
     std::vector<PriceObjective> PriceObjectiveCalculator::bullish_objectives() const {
-        std::vector<PriceObjective> result;
-        for (const auto& obj : objectives_) {
-            if (obj.is_bullish) result.push_back(obj);
-        }
-        return result;
+        auto view = bullish_objectives_view();
+        return {view.begin(), view.end()};
     }
 
     std::vector<PriceObjective> PriceObjectiveCalculator::bearish_objectives() const {
-        std::vector<PriceObjective> result;
-        for (const auto& obj : objectives_) {
-            if (!obj.is_bullish) result.push_back(obj);
-        }
-        return result;
+        auto view = bearish_objectives_view();
+        return {view.begin(), view.end()};
     }
 
     std::vector<double> PriceObjectiveCalculator::bullish_targets() const {
-        std::vector<double> result;
-        for (const auto& obj : objectives_) {
-            if (obj.is_bullish) result.push_back(obj.target_price);
-        }
-        return result;
+        auto view = bullish_targets_view();
+        return {view.begin(), view.end()};
     }
 
     std::vector<double> PriceObjectiveCalculator::bearish_targets() const {
-        std::vector<double> result;
-        for (const auto& obj : objectives_) {
-            if (!obj.is_bullish) result.push_back(obj.target_price);
-        }
-        return result;
+        auto view = bearish_targets_view();
+        return {view.begin(), view.end()};
     }
 
     std::string PriceObjectiveCalculator::to_string() const {
@@ -1113,8 +1121,9 @@ namespace pnf {
         return oss.str();
     }
 
-    CongestionDetector::CongestionDetector(const int min_columns, const double price_range_threshold)
-        : min_columns_(min_columns), threshold_(price_range_threshold) {}
+    CongestionDetector::CongestionDetector(const int min_columns, const double price_range_threshold,
+                                           std::pmr::memory_resource* resource)
+        : zones_(resource ? resource : std::pmr::get_default_resource()), min_columns_(min_columns), threshold_(price_range_threshold) {}
 
     void CongestionDetector::set_min_columns(const int min) {
         min_columns_ = min;
@@ -1125,11 +1134,15 @@ namespace pnf {
     }
 
     void CongestionDetector::detect(const Chart& chart) {
+        detect_since(chart, 0);
+    }
+
+    void CongestionDetector::detect_since(const Chart& chart, const size_t first) {
         zones_.clear();
         const size_t count = chart.column_count();
-        if (count < static_cast<size_t>(min_columns_)) return;
+        if (first >= count || count - first < static_cast<size_t>(min_columns_)) return;
 
-        size_t start = 0;
+        size_t start = first;
         while (start < count) {
             double high = chart.column(start)->highest_price();
             double low = chart.column(start)->lowest_price();
@@ -1188,25 +1201,26 @@ namespace pnf {
         initialize();
     }
 
-    Indicators::Indicators(const IndicatorConfig& config) : config_(config) {
+    Indicators::Indicators(const IndicatorConfig& config, std::pmr::memory_resource* resource)
+        : config_(config), resource_(resource ? resource : std::pmr::get_default_resource()) {
         initialize();
     }
 
     void Indicators::initialize() {
-        sma_short_ = std::make_unique<MovingAverage>(config_.sma_short_period);
-        sma_medium_ = std::make_unique<MovingAverage>(config_.sma_medium_period);
-        sma_long_ = std::make_unique<MovingAverage>(config_.sma_long_period);
-        bollinger_ = std::make_unique<BollingerBands>(config_.bollinger_period, config_.bollinger_std_devs);
-        rsi_ = std::make_unique<RSI>(config_.rsi_period);
+        sma_short_ = std::make_unique<MovingAverage>(config_.sma_short_period, resource_);
+        sma_medium_ = std::make_unique<MovingAverage>(config_.sma_medium_period, resource_);
+        sma_long_ = std::make_unique<MovingAverage>(config_.sma_long_period, resource_);
+        bollinger_ = std::make_unique<BollingerBands>(config_.bollinger_period, config_.bollinger_std_devs, resource_);
+        rsi_ = std::make_unique<RSI>(config_.rsi_period, resource_);
         rsi_->set_thresholds(config_.rsi_overbought, config_.rsi_oversold);
-        obv_ = std::make_unique<OnBalanceVolume>();
+        obv_ = std::make_unique<OnBalanceVolume>(resource_);
         bullish_percent_ = std::make_unique<BullishPercent>();
         bullish_percent_->set_thresholds(config_.bullish_alert_threshold, config_.bearish_alert_threshold);
-        signals_ = std::make_unique<SignalDetector>();
-        patterns_ = std::make_unique<PatternRecognizer>();
-        support_resistance_ = std::make_unique<SupportResistance>(config_.support_resistance_threshold);
-        objectives_ = std::make_unique<PriceObjectiveCalculator>();
-        congestion_ = std::make_unique<CongestionDetector>(config_.congestion_min_columns, config_.congestion_price_range);
+        signals_ = std::make_unique<SignalDetector>(resource_);
+        patterns_ = std::make_unique<PatternRecognizer>(resource_);
+        support_resistance_ = std::make_unique<SupportResistance>(config_.support_resistance_threshold, resource_);
+        objectives_ = std::make_unique<PriceObjectiveCalculator>(resource_);
+        congestion_ = std::make_unique<CongestionDetector>(config_.congestion_min_columns, config_.congestion_price_range, resource_);
     }
 
     void Indicators::configure(const IndicatorConfig& config) {
@@ -1222,23 +1236,82 @@ namespace pnf {
         support_resistance_->set_threshold(config.support_resistance_threshold);
         congestion_->set_min_columns(config.congestion_min_columns);
         congestion_->set_threshold(config.congestion_price_range);
+        synced_chart_ = nullptr;
     }
 
     void Indicators::calculate(const Chart& chart) const
     {
         if (chart.column_count() == 0) return;
+        run(chart, 0);
+    }
+
+    void Indicators::calculate(const Chart& chart, ThreadPool& pool) const
+    {
+        if (chart.column_count() == 0) return;
+        run(chart, 0, &pool);
+    }
+
+    void Indicators::update(const Chart& chart) const
+    {
+        if (chart.column_count() == 0) return;
+        const bool resync = synced_chart_ != &chart || synced_rebuilds_ != chart.rebuild_count() ||
+                            chart.column_count() < synced_columns_;
+        // Only the last synced column can have grown since then.
+        run(chart, resync || synced_columns_ == 0 ? 0 : synced_columns_ - 1);
+    }
+
+    void Indicators::run(const Chart& chart, size_t first, ThreadPool* pool) const
+    {
+        const auto& midpoints = chart.column_midpoints();
+        first = std::min({first, sma_short_->values().size(), sma_medium_->values().size(),
+                          sma_long_->values().size(), bollinger_->middle_band().size(), rsi_->values().size()});
+        sma_short_->truncate(first);
+        sma_medium_->truncate(first);
+        sma_long_->truncate(first);
+        bollinger_->truncate(first);
+        rsi_->truncate(first);
+
+        if (pool && pool->size() > 1) {
+            // Each component only reads the chart and writes its own state, so
+            // the tasks can run in any order and still give the serial result.
+            const auto fill = [&midpoints, first](auto& series) {
+                for (size_t i = first; i < midpoints.size(); i++) series.append(midpoints);
+            };
+            const std::function<void()> tasks[] = {
+                [&] { fill(*sma_short_); },
+                [&] { fill(*sma_medium_); },
+                [&] { fill(*sma_long_); },
+                [&] { fill(*bollinger_); },
+                [&] { fill(*rsi_); },
+                [&] { bullish_percent_->update(chart, first); },
+                [&] { signals_->detect_from(chart, first); },
+                [&] { patterns_->detect_from(chart, first); },
+                [&] { support_resistance_->identify(chart); },
+                [&] { objectives_->calculate_all(chart); },
+                [&] { congestion_->detect(chart); },
+            };
+            pool->parallel_for(std::size(tasks), [&tasks](const size_t k) { tasks[k](); });
+        } else {
+            // One sweep feeds every series from the same midpoint window.
+            for (size_t i = first; i < midpoints.size(); i++) {
+                sma_short_->append(midpoints);
+                sma_medium_->append(midpoints);
+                sma_long_->append(midpoints);
+                bollinger_->append(midpoints);
+                rsi_->append(midpoints);
+            }
 
-        sma_short_->calculate(chart);
-        sma_medium_->calculate(chart);
-        sma_long_->calculate(chart);
-        bollinger_->calculate(chart);
-        rsi_->calculate(chart);
-        bullish_percent_->calculate(chart);
-        signals_->detect(chart);
-        patterns_->detect(chart);
-        support_resistance_->identify(chart);
-        objectives_->calculate_all(chart);
-        congestion_->detect(chart);
+            bullish_percent_->update(chart, first);
+            signals_->detect_from(chart, first);
+            patterns_->detect_from(chart, first);
+            support_resistance_->identify(chart);
+            objectives_->calculate_all(chart);
+            congestion_->detect(chart);
+        }
+
+        synced_chart_ = &chart;
+        synced_columns_ = chart.column_count();
+        synced_rebuilds_ = chart.rebuild_count();
     }
 
     void Indicators::calculate_with_volume(const Chart& chart, const std::vector<OHLC>& ohlc_data) const
@@ -1266,6 +1339,24 @@ namespace pnf {
         return data;
     }
 
+    IndicatorDataView Indicators::export_view() const {
+        IndicatorDataView view;
+        view.sma_short = sma_short_->values();
+        view.sma_medium = sma_medium_->values();
+        view.sma_long = sma_long_->values();
+        view.bollinger_middle = bollinger_->middle_band();
+        view.bollinger_upper = bollinger_->upper_band();
+        view.bollinger_lower = bollinger_->lower_band();
+        view.rsi = rsi_->values();
+        view.obv = obv_->values();
+        view.bullish_percent = bullish_percent_->value();
+        view.signals = signals_->signals();
+        view.patterns = patterns_->patterns();
+        view.levels = support_resistance_->levels();
+        view.price_objectives = objectives_->objectives();
+        return view;
+    }
+
     ChartData Indicators::export_chart_data(const Chart& chart) {
         ChartData data;
         data.box_size = chart.current_box_size();
@@ -1281,9 +1372,7 @@ namespace pnf {
             cd.high = col->highest_price();
             cd.low = col->lowest_price();
             cd.box_count = static_cast<int>(col->box_count());
-            if (col->box_count() > 0) {
-                if (const Box* first_box = col->get_box_at(0)) cd.marker = first_box->marker();
-            }
+            if (col->box_count() > 0) cd.marker = col->box_at(0).marker();
             data.columns.push_back(cd);
         }
         return data;
@@ -1300,9 +1389,9 @@ namespace pnf {
         oss << "\nLATEST PATTERN: "
             << (latest.type != PatternType::None ? pattern_type_to_string(latest.type) : "None") << "\n";
 
-        oss << "\nBULLISH PATTERNS: " << patterns_->bullish_patterns().size() << "\n";
-        oss << "BEARISH PATTERNS: " << patterns_->bearish_patterns().size() << "\n";
-        oss << "\nSIGNIFICANT S/R LEVELS: " << support_resistance_->significant_levels(3).size() << "\n";
+        oss << "\nBULLISH PATTERNS: " << patterns_->bullish_count() << "\n";
+        oss << "BEARISH PATTERNS: " << patterns_->bearish_count() << "\n";
+        oss << "\nSIGNIFICANT S/R LEVELS: " << std::ranges::distance(support_resistance_->significant_levels_view(3)) << "\n";
 
         if (const PriceObjective obj = objectives_->latest(); obj.base_column >= 0) {
             oss << "\nLATEST PRICE TARGET: " << obj.target_price
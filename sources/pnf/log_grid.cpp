@@ -0,0 +1,64 @@
+/// \file log_grid.cpp
+/// \brief Logarithmic box grid implementation.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#include "pnf/log_grid.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace pnf {
+    LogBoxGrid::LogBoxGrid(const double percent)
+        : percent_(percent > 0.0 ? percent : 1.0), ratio_(1.0 + percent_ / 100.0), log_ratio_(std::log(ratio_)) {}
+
+    double LogBoxGrid::level(const int index) const {
+        if (index >= first_ && index < first_ + static_cast<int>(levels_.size()))
+            return levels_[index - first_];
+        return std::pow(ratio_, index);
+    }
+
+    double LogBoxGrid::at(const int index) {
+        if (levels_.empty()) {
+            first_ = index;
+            levels_.push_back(std::pow(ratio_, index));
+            return levels_.front();
+        }
+
+        // Grow by at least the current size so repeated extension stays amortised O(1).
+        const int last = first_ + static_cast<int>(levels_.size()) - 1;
+        const int chunk = std::max(16, static_cast<int>(levels_.size()));
+        if (index > last) {
+            const int target = std::max(index, last + chunk);
+            levels_.reserve(levels_.size() + (target - last));
+            for (int k = last + 1; k <= target; k++) levels_.push_back(std::pow(ratio_, k));
+        } else if (index < first_) {
+            const int target = std::min(index, first_ - chunk);
+            std::vector<double> below;
+            below.reserve(first_ - target + levels_.size());
+            for (int k = target; k < first_; k++) below.push_back(std::pow(ratio_, k));
+            below.insert(below.end(), levels_.begin(), levels_.end());
+            levels_ = std::move(below);
+            first_ = target;
+        }
+        return levels_[index - first_];
+    }
+
+    int LogBoxGrid::floor_index(const double price) const {
+        if (!levels_.empty() && price >= levels_.front() && price <= levels_.back()) {
+            const auto it = std::upper_bound(levels_.begin(), levels_.end(), price);
+            return first_ + static_cast<int>(it - levels_.begin()) - 1;
+        }
+
+        auto k = static_cast<int>(std::floor(std::log(price) / log_ratio_));
+        while (level(k + 1) <= price) k++;
+        while (level(k) > price) k--;
+        return k;
+    }
+
+    int LogBoxGrid::ceil_index(const double price) const {
+        const int k = floor_index(price);
+        return level(k) < price ? k + 1 : k;
+    }
+} // namespace pnf
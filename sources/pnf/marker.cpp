@@ -0,0 +1,76 @@
+/// \file marker.cpp
+/// \brief Interned box marker implementation.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#include "pnf/marker.hpp"
+#include <array>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace pnf {
+    namespace {
+        const std::array<std::string, MarkerTable::month_count + 1> month_names = {
+            "", "1", "2", "3", "4", "5", "6", "7", "8", "9", "A", "B", "C"
+        };
+
+        MarkerId month_from_code(const std::string_view marker) {
+            if (marker.size() != 1) return MarkerTable::none;
+            const char c = marker.front();
+            if (c >= '1' && c <= '9') return static_cast<MarkerId>(c - '0');
+            if (c >= 'A' && c <= 'C') return static_cast<MarkerId>(c - 'A' + 10);
+            return MarkerTable::none;
+        }
+
+        struct UserMarkers {
+            std::shared_mutex mutex;
+            std::deque<std::string> names;                          // ID month_count + 1 + index; stable references
+            std::unordered_map<std::string_view, MarkerId> ids;     // views into names
+        };
+
+        UserMarkers& user_markers() {
+            static UserMarkers markers;
+            return markers;
+        }
+    }
+
+    MarkerId MarkerTable::intern(const std::string_view marker) {
+        if (marker.empty()) return none;
+        if (const MarkerId id = month_from_code(marker); id != none) return id;
+
+        UserMarkers& table = user_markers();
+        {
+            std::shared_lock lock(table.mutex);
+            if (const auto it = table.ids.find(marker); it != table.ids.end()) return it->second;
+        }
+
+        std::unique_lock lock(table.mutex);
+        if (const auto it = table.ids.find(marker); it != table.ids.end()) return it->second;
+        const size_t next = month_count + 1 + table.names.size();
+        if (next > std::numeric_limits<MarkerId>::max()) return none;
+        const std::string& stored = table.names.emplace_back(marker);
+        const auto id = static_cast<MarkerId>(next);
+        table.ids.emplace(stored, id);
+        return id;
+    }
+
+    const std::string& MarkerTable::name(const MarkerId id) {
+        if (id <= month_count) return month_names[id];
+
+        UserMarkers& table = user_markers();
+        std::shared_lock lock(table.mutex);
+        const size_t index = id - month_count - 1;
+        return index < table.names.size() ? table.names[index] : month_names[none];
+    }
+
+    size_t MarkerTable::size() {
+        UserMarkers& table = user_markers();
+        std::shared_lock lock(table.mutex);
+        return month_count + table.names.size();
+    }
+} // namespace pnf
@@ -0,0 +1,400 @@
+/// \file mask.cpp
+/// \brief Column bitset and comparison kernel implementation.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#include "pnf/mask.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define PNF_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+namespace pnf {
+    namespace {
+        enum class Cmp { Greater, Less, GreaterEqual, LessEqual };
+
+        // Each kernel writes bits [0, n) into out, which is zeroed by the caller.
+        // A null bounds pointer compares against the scalar threshold instead.
+        using CompareKernel = void (*)(const double* values, const double* bounds, double threshold,
+                                       size_t n, Cmp cmp, std::uint64_t* out);
+        // ORs |values[i] - level| / level < tolerance into out.
+        using NearKernel = void (*)(const double* values, size_t n, double level, double tolerance,
+                                    std::uint64_t* out);
+        // Returns the minimum (or maximum) of n >= 1 values.
+        using ReduceKernel = double (*)(const double* values, size_t n, bool maximum);
+
+        bool compare(const double a, const double b, const Cmp cmp) {
+            switch (cmp) {
+                case Cmp::Greater: return a > b;
+                case Cmp::Less: return a < b;
+                case Cmp::GreaterEqual: return a >= b;
+                case Cmp::LessEqual: return a <= b;
+            }
+            return false;
+        }
+
+        void compare_scalar(const double* values, const double* bounds, const double threshold,
+                            const size_t n, const Cmp cmp, std::uint64_t* out) {
+            for (size_t i = 0; i < n; i++) {
+                const double bound = bounds ? bounds[i] : threshold;
+                if (compare(values[i], bound, cmp)) out[i / 64] |= std::uint64_t{1} << (i % 64);
+            }
+        }
+
+        void near_scalar(const double* values, const size_t n, const double level, const double tolerance,
+                         std::uint64_t* out) {
+            for (size_t i = 0; i < n; i++) {
+                if (std::abs(values[i] - level) / level < tolerance) out[i / 64] |= std::uint64_t{1} << (i % 64);
+            }
+        }
+
+        double reduce_scalar(const double* values, const size_t n, const bool maximum) {
+            double result = values[0];
+            for (size_t i = 1; i < n; i++) {
+                result = maximum ? std::max(result, values[i]) : std::min(result, values[i]);
+            }
+            return result;
+        }
+
+#ifdef PNF_X86_KERNELS
+        __attribute__((target("avx2")))
+        double reduce_avx2(const double* values, const size_t n, const bool maximum) {
+            if (n < 8) return reduce_scalar(values, n, maximum);
+            // Two accumulators hide the latency of the min/max chain.
+            __m256d a = _mm256_loadu_pd(values);
+            __m256d b = _mm256_loadu_pd(values + 4);
+            size_t i = 8;
+            for (; i + 8 <= n; i += 8) {
+                const __m256d x = _mm256_loadu_pd(values + i);
+                const __m256d y = _mm256_loadu_pd(values + i + 4);
+                a = maximum ? _mm256_max_pd(a, x) : _mm256_min_pd(a, x);
+                b = maximum ? _mm256_max_pd(b, y) : _mm256_min_pd(b, y);
+            }
+            alignas(32) double lanes[4];
+            _mm256_store_pd(lanes, maximum ? _mm256_max_pd(a, b) : _mm256_min_pd(a, b));
+            double result = reduce_scalar(lanes, 4, maximum);
+            if (i < n) {
+                const double tail = reduce_scalar(values + i, n - i, maximum);
+                result = maximum ? std::max(result, tail) : std::min(result, tail);
+            }
+            return result;
+        }
+
+        __attribute__((target("avx512f")))
+        double reduce_avx512(const double* values, const size_t n, const bool maximum) {
+            if (n < 8) return reduce_scalar(values, n, maximum);
+            __m512d acc = _mm512_loadu_pd(values);
+            size_t i = 8;
+            for (; i + 8 <= n; i += 8) {
+                const __m512d x = _mm512_loadu_pd(values + i);
+                acc = maximum ? _mm512_max_pd(acc, x) : _mm512_min_pd(acc, x);
+            }
+            if (i < n) {
+                const auto tail = static_cast<__mmask8>((1u << (n - i)) - 1u);
+                // Masked-off lanes keep the accumulator, so they never win.
+                acc = maximum ? _mm512_mask_max_pd(acc, tail, acc, _mm512_maskz_loadu_pd(tail, values + i))
+                              : _mm512_mask_min_pd(acc, tail, acc, _mm512_maskz_loadu_pd(tail, values + i));
+            }
+            return maximum ? _mm512_reduce_max_pd(acc) : _mm512_reduce_min_pd(acc);
+        }
+
+        template <int Predicate>
+        __attribute__((target("avx2")))
+        void compare_avx2_impl(const double* values, const double* bounds, const double threshold,
+                               const size_t n, std::uint64_t* out) {
+            const __m256d splat = _mm256_set1_pd(threshold);
+            size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                const __m256d v = _mm256_loadu_pd(values + i);
+                const __m256d b = bounds ? _mm256_loadu_pd(bounds + i) : splat;
+                const auto bits = static_cast<std::uint64_t>(_mm256_movemask_pd(_mm256_cmp_pd(v, b, Predicate)));
+                out[i / 64] |= bits << (i % 64);
+            }
+            for (; i < n; i++) {
+                const double bound = bounds ? bounds[i] : threshold;
+                const __m128d r = _mm_cmp_sd(_mm_set_sd(values[i]), _mm_set_sd(bound), Predicate);
+                if (_mm_movemask_pd(r) & 1) out[i / 64] |= std::uint64_t{1} << (i % 64);
+            }
+        }
+
+        __attribute__((target("avx2")))
+        void compare_avx2(const double* values, const double* bounds, const double threshold,
+                          const size_t n, const Cmp cmp, std::uint64_t* out) {
+            switch (cmp) {
+                case Cmp::Greater: compare_avx2_impl<_CMP_GT_OQ>(values, bounds, threshold, n, out); break;
+                case Cmp::Less: compare_avx2_impl<_CMP_LT_OQ>(values, bounds, threshold, n, out); break;
+                case Cmp::GreaterEqual: compare_avx2_impl<_CMP_GE_OQ>(values, bounds, threshold, n, out); break;
+                case Cmp::LessEqual: compare_avx2_impl<_CMP_LE_OQ>(values, bounds, threshold, n, out); break;
+            }
+        }
+
+        __attribute__((target("avx2")))
+        void near_avx2(const double* values, const size_t n, const double level, const double tolerance,
+                       std::uint64_t* out) {
+            const __m256d lv = _mm256_set1_pd(level);
+            const __m256d tol = _mm256_set1_pd(tolerance);
+            const __m256d sign = _mm256_set1_pd(-0.0);
+            size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                const __m256d diff = _mm256_andnot_pd(sign, _mm256_sub_pd(_mm256_loadu_pd(values + i), lv));
+                const __m256d rel = _mm256_div_pd(diff, lv);
+                const auto bits = static_cast<std::uint64_t>(_mm256_movemask_pd(_mm256_cmp_pd(rel, tol, _CMP_LT_OQ)));
+                out[i / 64] |= bits << (i % 64);
+            }
+            for (; i < n; i++) {
+                if (std::abs(values[i] - level) / level < tolerance) out[i / 64] |= std::uint64_t{1} << (i % 64);
+            }
+        }
+
+        template <int Predicate>
+        __attribute__((target("avx512f")))
+        void compare_avx512_impl(const double* values, const double* bounds, const double threshold,
+                                 const size_t n, std::uint64_t* out) {
+            const __m512d splat = _mm512_set1_pd(threshold);
+            size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                const __m512d v = _mm512_loadu_pd(values + i);
+                const __m512d b = bounds ? _mm512_loadu_pd(bounds + i) : splat;
+                const auto bits = static_cast<std::uint64_t>(_mm512_cmp_pd_mask(v, b, Predicate));
+                out[i / 64] |= bits << (i % 64);
+            }
+            if (i < n) {
+                const auto tail = static_cast<__mmask8>((1u << (n - i)) - 1u);
+                const __m512d v = _mm512_maskz_loadu_pd(tail, values + i);
+                const __m512d b = bounds ? _mm512_maskz_loadu_pd(tail, bounds + i) : splat;
+                const auto bits = static_cast<std::uint64_t>(_mm512_mask_cmp_pd_mask(tail, v, b, Predicate));
+                out[i / 64] |= bits << (i % 64);
+            }
+        }
+
+        __attribute__((target("avx512f")))
+        void compare_avx512(const double* values, const double* bounds, const double threshold,
+                            const size_t n, const Cmp cmp, std::uint64_t* out) {
+            switch (cmp) {
+                case Cmp::Greater: compare_avx512_impl<_CMP_GT_OQ>(values, bounds, threshold, n, out); break;
+                case Cmp::Less: compare_avx512_impl<_CMP_LT_OQ>(values, bounds, threshold, n, out); break;
+                case Cmp::GreaterEqual: compare_avx512_impl<_CMP_GE_OQ>(values, bounds, threshold, n, out); break;
+                case Cmp::LessEqual: compare_avx512_impl<_CMP_LE_OQ>(values, bounds, threshold, n, out); break;
+            }
+        }
+
+        __attribute__((target("avx512f")))
+        void near_avx512(const double* values, const size_t n, const double level, const double tolerance,
+                         std::uint64_t* out) {
+            const __m512d lv = _mm512_set1_pd(level);
+            const __m512d tol = _mm512_set1_pd(tolerance);
+            size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                const __m512d diff = _mm512_abs_pd(_mm512_sub_pd(_mm512_loadu_pd(values + i), lv));
+                const auto bits = static_cast<std::uint64_t>(
+                    _mm512_cmp_pd_mask(_mm512_div_pd(diff, lv), tol, _CMP_LT_OQ));
+                out[i / 64] |= bits << (i % 64);
+            }
+            for (; i < n; i++) {
+                if (std::abs(values[i] - level) / level < tolerance) out[i / 64] |= std::uint64_t{1} << (i % 64);
+            }
+        }
+#endif
+
+        SimdLevel detect_simd_level() {
+#ifdef PNF_X86_KERNELS
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) return SimdLevel::AVX512;
+            if (__builtin_cpu_supports("avx2")) return SimdLevel::AVX2;
+#endif
+            return SimdLevel::Scalar;
+        }
+
+        std::atomic<SimdLevel>& active_level() {
+            static std::atomic<SimdLevel> level{supported_simd_level()};
+            return level;
+        }
+
+        CompareKernel compare_kernel() {
+#ifdef PNF_X86_KERNELS
+            switch (simd_level()) {
+                case SimdLevel::AVX512: return compare_avx512;
+                case SimdLevel::AVX2: return compare_avx2;
+                case SimdLevel::Scalar: break;
+            }
+#endif
+            return compare_scalar;
+        }
+
+        NearKernel near_kernel() {
+#ifdef PNF_X86_KERNELS
+            switch (simd_level()) {
+                case SimdLevel::AVX512: return near_avx512;
+                case SimdLevel::AVX2: return near_avx2;
+                case SimdLevel::Scalar: break;
+            }
+#endif
+            return near_scalar;
+        }
+
+        ReduceKernel reduce_kernel() {
+#ifdef PNF_X86_KERNELS
+            switch (simd_level()) {
+                case SimdLevel::AVX512: return reduce_avx512;
+                case SimdLevel::AVX2: return reduce_avx2;
+                case SimdLevel::Scalar: break;
+            }
+#endif
+            return reduce_scalar;
+        }
+
+        ColumnMask run_compare(const std::span<const double> values, const double* bounds, const double threshold,
+                               const size_t size, const size_t first, const Cmp cmp) {
+            ColumnMask mask(size);
+            if (first < size)
+                compare_kernel()(values.data() + first, bounds ? bounds + first : nullptr, threshold,
+                                 size - first, cmp, mask.words().data() + first / 64);
+            // The kernels write relative to values + first, so realign to
+            // column indices when first is not on a word boundary.
+            if (const size_t shift = first % 64; shift != 0 && first < size) {
+                auto& words = mask.words();
+                for (size_t w = words.size(); w-- > first / 64;) {
+                    const std::uint64_t lower = w > first / 64 ? words[w - 1] >> (64 - shift) : 0;
+                    words[w] = (words[w] << shift) | lower;
+                }
+            }
+            return mask;
+        }
+
+        ColumnMask cross(const std::span<const double> values, const double threshold, const size_t first,
+                         const Cmp now, const Cmp before) {
+            const size_t start = std::max<size_t>(first, 1);
+            ColumnMask mask = run_compare(values, nullptr, threshold, values.size(), start, now);
+            const ColumnMask prior = run_compare(values, nullptr, threshold, values.size(), start - 1, before);
+            // Bit i of the result needs bit i - 1 of prior.
+            std::uint64_t carry = 0;
+            auto& words = mask.words();
+            for (size_t w = 0; w < words.size(); w++) {
+                const std::uint64_t p = prior.words()[w];
+                words[w] &= (p << 1) | carry;
+                carry = p >> 63;
+            }
+            return mask;
+        }
+    }
+
+    SimdLevel supported_simd_level() {
+        static const SimdLevel level = detect_simd_level();
+        return level;
+    }
+
+    SimdLevel simd_level() {
+        return active_level().load(std::memory_order_relaxed);
+    }
+
+    SimdLevel set_simd_level(const SimdLevel level) {
+        const SimdLevel selected = std::min(level, supported_simd_level());
+        active_level().store(selected, std::memory_order_relaxed);
+        return selected;
+    }
+
+    ColumnMask::ColumnMask(const size_t size) : size_(size), words_((size + 63) / 64, 0) {}
+
+    bool ColumnMask::test(const size_t index) const {
+        return index < size_ && (words_[index / 64] >> (index % 64)) & 1;
+    }
+
+    void ColumnMask::set(const size_t index, const bool value) {
+        if (index >= size_) return;
+        const std::uint64_t bit = std::uint64_t{1} << (index % 64);
+        if (value) words_[index / 64] |= bit;
+        else words_[index / 64] &= ~bit;
+    }
+
+    size_t ColumnMask::count() const {
+        size_t total = 0;
+        for (const std::uint64_t w : words_) total += static_cast<size_t>(std::popcount(w));
+        return total;
+    }
+
+    bool ColumnMask::any() const {
+        return std::ranges::any_of(words_, [](const std::uint64_t w) { return w != 0; });
+    }
+
+    std::vector<size_t> ColumnMask::indices() const {
+        std::vector<size_t> result;
+        result.reserve(count());
+        for (size_t w = 0; w < words_.size(); w++) {
+            for (std::uint64_t bits = words_[w]; bits != 0; bits &= bits - 1) {
+                result.push_back(w * 64 + static_cast<size_t>(std::countr_zero(bits)));
+            }
+        }
+        return result;
+    }
+
+    void ColumnMask::clear_before(const size_t first) {
+        const size_t limit = std::min(first, size_);
+        for (size_t w = 0; w < limit / 64; w++) words_[w] = 0;
+        if (limit % 64 != 0) words_[limit / 64] &= ~std::uint64_t{0} << (limit % 64);
+    }
+
+    ColumnMask& ColumnMask::operator&=(const ColumnMask& other) {
+        for (size_t w = 0; w < words_.size(); w++) {
+            words_[w] &= w < other.words_.size() ? other.words_[w] : 0;
+        }
+        return *this;
+    }
+
+    ColumnMask& ColumnMask::operator|=(const ColumnMask& other) {
+        const size_t n = std::min(words_.size(), other.words_.size());
+        for (size_t w = 0; w < n; w++) words_[w] |= other.words_[w];
+        if (size_ % 64 != 0 && !words_.empty()) words_.back() &= (std::uint64_t{1} << (size_ % 64)) - 1;
+        return *this;
+    }
+
+    ColumnMask mask_greater(const std::span<const double> values, const std::span<const double> bounds,
+                            const size_t first) {
+        return run_compare(values, bounds.data(), 0.0, std::min(values.size(), bounds.size()), first, Cmp::Greater);
+    }
+
+    ColumnMask mask_less(const std::span<const double> values, const std::span<const double> bounds,
+                         const size_t first) {
+        return run_compare(values, bounds.data(), 0.0, std::min(values.size(), bounds.size()), first, Cmp::Less);
+    }
+
+    ColumnMask mask_greater(const std::span<const double> values, const double threshold, const size_t first) {
+        return run_compare(values, nullptr, threshold, values.size(), first, Cmp::Greater);
+    }
+
+    ColumnMask mask_less(const std::span<const double> values, const double threshold, const size_t first) {
+        return run_compare(values, nullptr, threshold, values.size(), first, Cmp::Less);
+    }
+
+    ColumnMask mask_cross_above(const std::span<const double> values, const double threshold, const size_t first) {
+        return cross(values, threshold, first, Cmp::Greater, Cmp::LessEqual);
+    }
+
+    ColumnMask mask_cross_below(const std::span<const double> values, const double threshold, const size_t first) {
+        return cross(values, threshold, first, Cmp::Less, Cmp::GreaterEqual);
+    }
+
+    ColumnMask mask_near_any(const std::span<const double> values, const std::span<const double> levels,
+                             const double tolerance) {
+        ColumnMask mask(values.size());
+        const NearKernel kernel = near_kernel();
+        for (const double level : levels) {
+            kernel(values.data(), values.size(), level, tolerance, mask.words().data());
+        }
+        return mask;
+    }
+
+    double series_min(const std::span<const double> values) {
+        return values.empty() ? 0.0 : reduce_kernel()(values.data(), values.size(), false);
+    }
+
+    double series_max(const std::span<const double> values) {
+        return values.empty() ? 0.0 : reduce_kernel()(values.data(), values.size(), true);
+    }
+}
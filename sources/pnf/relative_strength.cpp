@@ -0,0 +1,91 @@
+/// \file relative_strength.cpp
+/// \brief Relative strength chart implementation.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#include "pnf/relative_strength.hpp"
+#include <algorithm>
+
+namespace pnf {
+    RelativeStrengthChart::RelativeStrengthChart(const RelativeStrengthConfig& config)
+        : config_(config), chart_(std::make_unique<Chart>(config.chart)) {}
+
+    bool RelativeStrengthChart::update_symbol(const double price, const Timestamp time) {
+        if (price <= 0.0) return false;
+        symbol_price_ = price;
+        has_symbol_ = true;
+        return emit(time);
+    }
+
+    bool RelativeStrengthChart::update_benchmark(const double price, const Timestamp time) {
+        if (price <= 0.0) return false;
+        benchmark_price_ = price;
+        has_benchmark_ = true;
+        return emit(time);
+    }
+
+    bool RelativeStrengthChart::update(const double symbol_price, const double benchmark_price, const Timestamp time) {
+        if (symbol_price > 0.0) {
+            symbol_price_ = symbol_price;
+            has_symbol_ = true;
+        }
+        if (benchmark_price > 0.0) {
+            benchmark_price_ = benchmark_price;
+            has_benchmark_ = true;
+        }
+        return emit(time);
+    }
+
+    bool RelativeStrengthChart::emit(const Timestamp time) {
+        if (!has_symbol_ || !has_benchmark_) return false;
+        ratio_ = symbol_price_ / benchmark_price_ * config_.scale;
+        if (ratio_count_ > 0) last_time_ = std::max(last_time_, time);
+        else last_time_ = time;
+        ratio_count_++;
+        return chart_->add_data(ratio_, last_time_);
+    }
+
+    void RelativeStrengthChart::clear() {
+        chart_ = std::make_unique<Chart>(config_.chart);
+        symbol_price_ = 0.0;
+        benchmark_price_ = 0.0;
+        has_symbol_ = false;
+        has_benchmark_ = false;
+        ratio_ = 0.0;
+        ratio_count_ = 0;
+        last_time_ = {};
+    }
+
+    RelativeStrengthChart RelativeStrengthChart::build(const std::vector<OHLC>& symbol,
+                                                       const std::vector<OHLC>& benchmark,
+                                                       const RelativeStrengthConfig& config) {
+        RelativeStrengthChart rs(config);
+        size_t i = 0, j = 0;
+        while (i < symbol.size() || j < benchmark.size()) {
+            if (j >= benchmark.size() || (i < symbol.size() && symbol[i].time < benchmark[j].time)) {
+                rs.update_symbol(symbol[i].close, symbol[i].time);
+                i++;
+            } else if (i >= symbol.size() || benchmark[j].time < symbol[i].time) {
+                rs.update_benchmark(benchmark[j].close, benchmark[j].time);
+                j++;
+            } else {
+                rs.update(symbol[i].close, benchmark[j].close, symbol[i].time);
+                i++;
+                j++;
+            }
+        }
+        return rs;
+    }
+
+    std::vector<RelativeStrengthChart> RelativeStrengthChart::build_universe(
+        const std::vector<std::vector<OHLC>>& symbols, const std::vector<OHLC>& benchmark,
+        ThreadPool& pool, const RelativeStrengthConfig& config) {
+        std::vector<RelativeStrengthChart> result(symbols.size());
+        pool.parallel_for(symbols.size(), [&](const size_t k) {
+            result[k] = build(symbols[k], benchmark, config);
+        });
+        return result;
+    }
+} // namespace pnf
@@ -0,0 +1,252 @@
+/// \file scanner.cpp
+/// \brief Scanner implementation.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#include "pnf/scanner.hpp"
+#include <algorithm>
+
+namespace pnf {
+    namespace {
+        double last_price(const Column* col) {
+            return col->type() == ColumnType::O ? col->lowest_price() : col->highest_price();
+        }
+
+        /// Same arithmetic as RSI::calculate for the last column, without building the series.
+        double trailing_rsi(const Chart& chart, const int period) {
+            const auto& midpoints = chart.column_midpoints();
+            const size_t count = midpoints.size();
+            if (count < 2) return 50.0;
+            const size_t i = count - 1;
+            if (static_cast<int>(i) < period) return 50.0;
+
+            double avg_gain = 0, avg_loss = 0;
+            for (int j = 0; j < period; j++) {
+                const size_t idx = i - 1 - j;
+                const double change = midpoints[idx + 1] - midpoints[idx];
+                avg_gain += change > 0 ? change : 0;
+                avg_loss += change < 0 ? -change : 0;
+            }
+            avg_gain /= period;
+            avg_loss /= period;
+
+            if (avg_loss == 0) return 100.0;
+            const double rs = avg_gain / avg_loss;
+            return 100.0 - (100.0 / (1.0 + rs));
+        }
+
+        /// Boxes by which the last column extends past the previous column of the same type.
+        double breakout_strength(const Chart& chart) {
+            const int last = static_cast<int>(chart.column_count()) - 1;
+            const Column* col = chart.column(last);
+            const double box = chart.current_box_size();
+            const int i = chart.previous_same_type(last);
+            if (i < 0 || box <= 0.0) return static_cast<double>(col->box_count());
+            const Column* prev = chart.column(i);
+            if (col->type() == ColumnType::O)
+                return (prev->lowest_price() - col->lowest_price()) / box;
+            return (col->highest_price() - prev->highest_price()) / box;
+        }
+    }
+
+    CompiledScanQuery::CompiledScanQuery(const ScanQuery& query) : query_(query) {
+        static_assert(static_cast<unsigned>(PatternType::SpreadTripleBottom) < 32, "pattern mask is 32 bits");
+        for (const auto type : query_.patterns) {
+            const auto bit = static_cast<unsigned>(type);
+            if (type != PatternType::None && bit <= static_cast<unsigned>(PatternType::SpreadTripleBottom))
+                pattern_mask_ |= 1u << bit;
+        }
+        if (query_.lookback < 1) query_.lookback = 1;
+        if (query_.context_columns < 0) query_.context_columns = 0;
+
+        if (query_.min_columns > 0) steps_.push_back(Step::MinColumns);
+        if (query_.bias != ScanBias::Any) steps_.push_back(Step::Bias);
+        if (query_.above_bullish_support) steps_.push_back(Step::AboveSupport);
+        if (query_.below_bearish_resistance) steps_.push_back(Step::BelowResistance);
+        if (query_.signal != SignalType::None) steps_.push_back(Step::Signal);
+        if (query_.rsi_min > 0.0 || query_.rsi_max < 100.0) steps_.push_back(Step::Rsi);
+        if (query_.congestion != ScanCongestion::Any) steps_.push_back(Step::Congestion);
+        if (query_.near_support > 0.0) steps_.push_back(Step::NearSupport);
+        if (query_.near_resistance > 0.0) steps_.push_back(Step::NearResistance);
+        if (pattern_mask_ != 0) steps_.push_back(Step::Pattern);
+    }
+
+    bool CompiledScanQuery::wants_pattern(const PatternType type) const {
+        const auto bit = static_cast<unsigned>(type);
+        return bit < 32 && ((pattern_mask_ >> bit) & 1u);
+    }
+
+    bool CompiledScanQuery::evaluate(const Chart& chart, const Indicators* indicators, ScanMatch& match) const {
+        if (chart.column_count() == 0) return false;
+
+        for (const Step step : steps_) {
+            if (!run_step(step, chart, indicators, match)) return false;
+        }
+
+        const Column* last = chart.last_column();
+        match.column = static_cast<int>(chart.column_count()) - 1;
+        match.price = last_price(last);
+        match.score = breakout_strength(chart);
+        return true;
+    }
+
+    bool CompiledScanQuery::run_step(const Step step, const Chart& chart, const Indicators* indicators,
+                                     ScanMatch& match) const {
+        const int last = static_cast<int>(chart.column_count()) - 1;
+        switch (step) {
+        case Step::MinColumns:
+            return last + 1 >= query_.min_columns;
+        case Step::Bias:
+            return query_.bias == ScanBias::Bullish ? chart.has_bullish_bias() : chart.has_bearish_bias();
+        case Step::AboveSupport:
+            return chart.is_above_bullish_support(last_price(chart.column(last)));
+        case Step::BelowResistance:
+            return chart.is_below_bearish_resistance(last_price(chart.column(last)));
+        case Step::Signal:
+            return match_signal(chart, indicators, match);
+        case Step::Rsi: {
+            double rsi;
+            if (indicators && indicators->rsi()->values().size() == chart.column_count())
+                rsi = indicators->rsi()->values().back();
+            else
+                rsi = trailing_rsi(chart, query_.rsi_period);
+            return rsi >= query_.rsi_min && rsi <= query_.rsi_max;
+        }
+        case Step::Congestion: {
+            bool inside;
+            if (indicators) {
+                inside = indicators->congestion()->is_in_congestion(last);
+            } else {
+                CongestionDetector detector;
+                detector.detect_since(chart, context_start(chart));
+                inside = detector.is_in_congestion(last);
+            }
+            return inside == (query_.congestion == ScanCongestion::Inside);
+        }
+        case Step::NearSupport:
+        case Step::NearResistance: {
+            const double price = last_price(chart.column(last));
+            const bool support = step == Step::NearSupport;
+            const double tolerance = support ? query_.near_support : query_.near_resistance;
+            if (indicators) {
+                const SupportResistance* sr = indicators->support_resistance();
+                return support ? sr->is_near_support(price, tolerance) : sr->is_near_resistance(price, tolerance);
+            }
+            SupportResistance sr;
+            sr.identify_since(chart, context_start(chart));
+            return support ? sr.is_near_support(price, tolerance) : sr.is_near_resistance(price, tolerance);
+        }
+        case Step::Pattern:
+            return match_pattern(chart, indicators, match);
+        }
+        return false;
+    }
+
+    size_t CompiledScanQuery::context_start(const Chart& chart) const {
+        const size_t count = chart.column_count();
+        const auto context = static_cast<size_t>(query_.context_columns);
+        return context == 0 || context >= count ? 0 : count - context;
+    }
+
+    bool CompiledScanQuery::match_signal(const Chart& chart, const Indicators* indicators, ScanMatch& match) const {
+        const int last = static_cast<int>(chart.column_count()) - 1;
+        const int first = std::max(0, last - query_.lookback + 1);
+
+        if (indicators) {
+            const auto& signals = indicators->signals()->signals();
+            for (auto it = signals.rbegin(); it != signals.rend() && it->column_index >= first; ++it) {
+                if (it->type == query_.signal) {
+                    match.signal = it->type;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        for (int col = last; col >= first; col--) {
+            if (SignalDetector::signal_at(chart, col) == query_.signal) {
+                match.signal = query_.signal;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool CompiledScanQuery::match_pattern(const Chart& chart, const Indicators* indicators, ScanMatch& match) const {
+        const int last = static_cast<int>(chart.column_count()) - 1;
+        const int first = std::max(0, last - query_.lookback + 1);
+
+        const std::pmr::vector<Pattern>* patterns;
+        PatternRecognizer local;
+        if (indicators) {
+            patterns = &indicators->patterns()->patterns();
+        } else {
+            // Catapults need the setup pattern from an earlier column, so start at the context window.
+            const int start = std::min(first, static_cast<int>(context_start(chart)));
+            for (int col = start; col <= last; col++) {
+                local.detect_column(chart, col);
+            }
+            patterns = &local.patterns();
+        }
+
+        for (auto it = patterns->rbegin(); it != patterns->rend() && it->end_column >= first; ++it) {
+            if (wants_pattern(it->type)) {
+                match.pattern = it->type;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    Scanner::Scanner(ThreadPool* pool) : pool_(pool) {}
+
+    Scanner::Scanner(const size_t threads)
+        : owned_pool_(threads == 1 ? nullptr : std::make_unique<ThreadPool>(threads)), pool_(owned_pool_.get()) {}
+
+    size_t Scanner::add(const std::string& symbol, const Chart& chart, const Indicators* indicators) {
+        entries_.push_back({symbol, &chart, indicators});
+        return entries_.size() - 1;
+    }
+
+    std::vector<ScanMatch> Scanner::scan(const ScanQuery& query) const {
+        return scan(CompiledScanQuery(query));
+    }
+
+    std::vector<ScanMatch> Scanner::scan(const CompiledScanQuery& query) const {
+        const size_t count = entries_.size();
+        std::vector<ScanMatch> slots(count);
+        std::vector<char> matched(count, 0);
+
+        const auto body = [&](const size_t i) {
+            const Entry& e = entries_[i];
+            ScanMatch m;
+            if (query.evaluate(*e.chart, e.indicators, m)) {
+                m.index = i;
+                slots[i] = std::move(m);
+                matched[i] = 1;
+            }
+        };
+
+        if (pool_) {
+            pool_->parallel_for(count, body);
+        } else {
+            for (size_t i = 0; i < count; i++) body(i);
+        }
+
+        std::vector<ScanMatch> result;
+        for (size_t i = 0; i < count; i++) {
+            if (!matched[i]) continue;
+            slots[i].symbol = entries_[i].symbol;
+            result.push_back(std::move(slots[i]));
+        }
+
+        std::ranges::stable_sort(result, [](const ScanMatch& a, const ScanMatch& b) {
+            return a.score > b.score;
+        });
+        if (query.query().limit > 0 && result.size() > query.query().limit)
+            result.resize(query.query().limit);
+        return result;
+    }
+} // namespace pnf
@@ -0,0 +1,120 @@
+/// \file sweep.cpp
+/// \brief Parameter sweep implementation.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#include "pnf/sweep.hpp"
+#include "pnf/indicators.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace pnf {
+    std::vector<ChartConfig> SweepGrid::configs() const {
+        std::vector<ChartConfig> result;
+        result.reserve(size());
+        for (const auto method : methods) {
+            for (const auto box_method : box_size_methods) {
+                for (const double box : box_sizes) {
+                    for (const int reversal : reversals) {
+                        ChartConfig cfg;
+                        cfg.method = method;
+                        cfg.box_size_method = box_method;
+                        cfg.box_size = box;
+                        cfg.reversal = reversal;
+                        result.push_back(cfg);
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
+    size_t SweepGrid::size() const {
+        return methods.size() * box_size_methods.size() * box_sizes.size() * reversals.size();
+    }
+
+    ParameterSweep::ParameterSweep(const SweepOptions& options)
+        : options_(options), owned_pool_(std::make_unique<ThreadPool>(options.threads)), pool_(owned_pool_.get()) {}
+
+    ParameterSweep::ParameterSweep(ThreadPool& pool, const SweepOptions& options)
+        : options_(options), pool_(&pool) {}
+
+    std::vector<SweepResult> ParameterSweep::run(const std::vector<OHLC>& bars,
+                                                 const std::vector<ChartConfig>& configs) const {
+        std::vector<SweepResult> results(configs.size());
+        const SweepOptions options = options_;
+        pool_->parallel_for(configs.size(), [&](const size_t i) {
+            results[i] = evaluate(bars, configs[i], options);
+        });
+        return results;
+    }
+
+    std::vector<SweepResult> ParameterSweep::run(const std::vector<OHLC>& bars, const SweepGrid& grid) const {
+        return run(bars, grid.configs());
+    }
+
+    SweepResult ParameterSweep::evaluate(const std::vector<OHLC>& bars, const ChartConfig& config,
+                                         const SweepOptions& options) {
+        Chart chart(config);
+        for (const auto& bar : bars) {
+            chart.add_ohlc(bar);
+        }
+
+        SweepResult result;
+        result.config = config;
+        result.column_count = static_cast<int>(chart.column_count());
+        result.x_column_count = static_cast<int>(chart.x_column_count());
+        result.o_column_count = static_cast<int>(chart.o_column_count());
+        result.box_size = chart.current_box_size();
+
+        if (options.signals) {
+            SignalDetector detector;
+            detector.detect(chart);
+            result.buy_signals = detector.buy_count();
+            result.sell_signals = detector.sell_count();
+        }
+
+        if (options.patterns) {
+            PatternRecognizer recognizer;
+            recognizer.detect(chart);
+            result.pattern_count = recognizer.pattern_count();
+            result.bullish_patterns = recognizer.bullish_count();
+            result.bearish_patterns = recognizer.bearish_count();
+        }
+
+        if (options.objectives) {
+            PriceObjectiveCalculator calculator;
+            calculator.calculate_all(chart);
+            const auto& objectives = calculator.objectives();
+
+            // Suffix extremes let each objective be scored against all later columns in O(1).
+            const size_t count = chart.column_count();
+            std::vector<double> max_after(count + 1, std::numeric_limits<double>::lowest());
+            std::vector<double> min_after(count + 1, std::numeric_limits<double>::max());
+            for (size_t i = count; i-- > 0;) {
+                const Column* col = chart.column(i);
+                max_after[i] = std::max(max_after[i + 1], col->highest_price());
+                min_after[i] = std::min(min_after[i + 1], col->lowest_price());
+            }
+
+            int hits = 0;
+            for (const auto& obj : objectives) {
+                const auto next = static_cast<size_t>(obj.base_column) + 1;
+                if (next >= count) continue;
+                if (obj.is_bullish ? max_after[next] >= obj.target_price : min_after[next] <= obj.target_price) {
+                    hits++;
+                }
+            }
+
+            result.objective_count = static_cast<int>(objectives.size());
+            result.objectives_hit = hits;
+            result.objective_hit_rate = objectives.empty()
+                ? 0.0
+                : static_cast<double>(hits) / static_cast<double>(objectives.size());
+        }
+
+        return result;
+    }
+} // namespace pnf
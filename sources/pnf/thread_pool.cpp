@@ -0,0 +1,182 @@
+/// \file thread_pool.cpp
+/// \brief Work-stealing thread pool implementation.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#include "pnf/thread_pool.hpp"
+#include <algorithm>
+
+namespace pnf {
+    namespace {
+        thread_local const ThreadPool* tl_owner = nullptr;
+        thread_local size_t tl_index = 0;
+    }
+
+    ThreadPool::ThreadPool(size_t threads) {
+        if (threads == 0) {
+            threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+        }
+        queues_.reserve(threads);
+        for (size_t i = 0; i < threads; i++) {
+            queues_.push_back(std::make_unique<WorkQueue>());
+        }
+        threads_.reserve(threads);
+        for (size_t i = 0; i < threads; i++) {
+            threads_.emplace_back([this, i] { worker_loop(i); });
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard lock(wake_mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& t : threads_) {
+            if (t.joinable()) t.join();
+        }
+    }
+
+    void ThreadPool::push(std::function<void()> task) {
+        const size_t index = (tl_owner == this)
+            ? tl_index
+            : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+        {
+            std::lock_guard lock(queues_[index]->mutex);
+            queues_[index]->tasks.push_back(std::move(task));
+        }
+        queued_.fetch_add(1);
+        {
+            std::lock_guard lock(wake_mutex_);
+        }
+        wake_.notify_one();
+    }
+
+    bool ThreadPool::pop_local(const size_t index, std::function<void()>& task) {
+        WorkQueue& queue = *queues_[index];
+        std::lock_guard lock(queue.mutex);
+        if (queue.tasks.empty()) return false;
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        queued_.fetch_sub(1);
+        return true;
+    }
+
+    bool ThreadPool::steal(const size_t thief, std::function<void()>& task) {
+        const size_t count = queues_.size();
+        for (size_t k = 1; k <= count; k++) {
+            WorkQueue& queue = *queues_[(thief + k) % count];
+            std::lock_guard lock(queue.mutex);
+            if (queue.tasks.empty()) continue;
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            queued_.fetch_sub(1);
+            return true;
+        }
+        return false;
+    }
+
+    bool ThreadPool::run_pending_task() {
+        std::function<void()> task;
+        const bool own = (tl_owner == this);
+        if ((own && pop_local(tl_index, task)) || steal(own ? tl_index : 0, task)) {
+            task();
+            return true;
+        }
+        return false;
+    }
+
+    void ThreadPool::worker_loop(const size_t index) {
+        tl_owner = this;
+        tl_index = index;
+
+        while (true) {
+            std::function<void()> task;
+            if (pop_local(index, task) || steal(index, task)) {
+                task();
+                continue;
+            }
+
+            std::unique_lock lock(wake_mutex_);
+            wake_.wait(lock, [this] { return stop_ || queued_.load() > 0; });
+            if (stop_ && queued_.load() == 0) return;
+        }
+    }
+
+    void ThreadPool::submit(std::function<void()> task) {
+        in_flight_.fetch_add(1);
+        push([this, task = std::move(task)] {
+            try {
+                task();
+            } catch (...) {
+                std::lock_guard lock(wake_mutex_);
+                if (!error_) error_ = std::current_exception();
+            }
+            std::lock_guard lock(wake_mutex_);
+            if (in_flight_.fetch_sub(1) == 1) idle_.notify_all();
+        });
+    }
+
+    void ThreadPool::wait() {
+        while (in_flight_.load() > 0) {
+            if (run_pending_task()) continue;
+            std::unique_lock lock(wake_mutex_);
+            idle_.wait(lock, [this] { return in_flight_.load() == 0; });
+        }
+
+        std::exception_ptr error;
+        {
+            std::lock_guard lock(wake_mutex_);
+            std::swap(error, error_);
+        }
+        if (error) std::rethrow_exception(error);
+    }
+
+    void ThreadPool::parallel_for(const size_t count, const std::function<void(size_t)>& body) {
+        if (count == 0) return;
+        if (count == 1 || queues_.size() == 1) {
+            for (size_t i = 0; i < count; i++) body(i);
+            return;
+        }
+
+        struct State {
+            std::mutex mutex;
+            std::condition_variable done;
+            size_t remaining = 0;
+            std::exception_ptr error;
+        } state;
+
+        const size_t chunks = std::min(count, queues_.size() * 4);
+        const size_t chunk_size = (count + chunks - 1) / chunks;
+        state.remaining = (count + chunk_size - 1) / chunk_size;
+
+        for (size_t begin = 0; begin < count; begin += chunk_size) {
+            const size_t end = std::min(count, begin + chunk_size);
+            push([&state, &body, begin, end] {
+                std::exception_ptr error;
+                try {
+                    for (size_t i = begin; i < end; i++) body(i);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+                std::lock_guard lock(state.mutex);
+                if (error && !state.error) state.error = error;
+                if (--state.remaining == 0) state.done.notify_all();
+            });
+        }
+
+        while (true) {
+            {
+                std::lock_guard lock(state.mutex);
+                if (state.remaining == 0) break;
+            }
+            if (run_pending_task()) continue;
+            std::unique_lock lock(state.mutex);
+            state.done.wait(lock, [&state] { return state.remaining == 0; });
+        }
+
+        if (state.error) std::rethrow_exception(state.error);
+    }
+} // namespace pnf
@@ -0,0 +1,97 @@
+/// \file timeframe.cpp
+/// \brief Multi-timeframe chart implementation.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#include "pnf/timeframe.hpp"
+#include <algorithm>
+
+namespace pnf {
+    namespace {
+        int64_t bucket_of(const Timestamp time, const std::chrono::seconds period) {
+            const auto secs = std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
+            const auto len = period.count();
+            // Floor division so pre-epoch times land in the right bucket.
+            return secs >= 0 ? secs / len : -((-secs + len - 1) / len);
+        }
+    }
+
+    MultiTimeframeChart::MultiTimeframeChart(const std::vector<TimeframeSpec>& specs) {
+        frames_.reserve(specs.size());
+        for (const auto& spec : specs) {
+            Frame frame;
+            frame.spec = spec;
+            if (frame.spec.period.count() <= 0) frame.spec.period = std::chrono::seconds(1);
+            frame.chart = std::make_unique<Chart>(spec.chart);
+            frames_.push_back(std::move(frame));
+        }
+    }
+
+    void MultiTimeframeChart::close_bar(Frame& frame) {
+        frame.chart->add_ohlc(frame.forming);
+        frame.completed++;
+        frame.has_forming = false;
+    }
+
+    void MultiTimeframeChart::fold(Frame& frame, const OHLC& bar) {
+        const int64_t bucket = bucket_of(bar.time, frame.spec.period);
+        if (frame.has_forming && bucket != frame.bucket) {
+            close_bar(frame);
+        }
+
+        if (!frame.has_forming) {
+            frame.bucket = bucket;
+            frame.forming = bar;
+            frame.forming.time = Timestamp(std::chrono::duration_cast<Timestamp::duration>(
+                std::chrono::seconds(bucket * frame.spec.period.count())));
+            frame.has_forming = true;
+            return;
+        }
+
+        OHLC& f = frame.forming;
+        f.high = std::max(f.high, bar.high);
+        f.low = std::min(f.low, bar.low);
+        f.close = bar.close;
+        f.volume += bar.volume;
+    }
+
+    void MultiTimeframeChart::add_tick(const double price, const double volume, const Timestamp time) {
+        add_bar({time, price, price, price, price, volume});
+    }
+
+    void MultiTimeframeChart::add_bar(const OHLC& bar) {
+        std::lock_guard lock(mutex_);
+        for (auto& frame : frames_) {
+            fold(frame, bar);
+        }
+        last_time_ = bar.time;
+    }
+
+    void MultiTimeframeChart::flush() {
+        std::lock_guard lock(mutex_);
+        for (auto& frame : frames_) {
+            if (frame.has_forming) close_bar(frame);
+        }
+    }
+
+    void MultiTimeframeChart::snapshot(
+        const std::function<void(const std::vector<TimeframeView>&, Timestamp)>& fn) const {
+        std::lock_guard lock(mutex_);
+        std::vector<TimeframeView> views;
+        views.reserve(frames_.size());
+        for (const auto& frame : frames_) {
+            views.push_back({&frame.spec, frame.chart.get(),
+                             frame.has_forming ? &frame.forming : nullptr, frame.completed});
+        }
+        fn(views, last_time_);
+    }
+
+    size_t MultiTimeframeChart::find(const std::string& name) const {
+        for (size_t i = 0; i < frames_.size(); i++) {
+            if (frames_[i].spec.name == name) return i;
+        }
+        return frames_.size();
+    }
+} // namespace pnf
@@ -8,6 +8,8 @@
 #include "pnf/trendline.hpp"
 #include <sstream>
 #include <algorithm>
+#include <iterator>
+#include <unordered_map>
 
 namespace pnf
 {
@@ -29,7 +31,7 @@ namespace pnf
     double TrendLine::price_at_column(const int column) const {
         if (column < start_.column_index) return 0;
         const int diff = column - start_.column_index;
-        if (type_ == TrendLineType::BullishSupport)
+        if (is_rising())
             return start_.price + (diff * box_size_);
         return start_.price - (diff * box_size_);
     }
@@ -37,11 +39,34 @@ namespace pnf
     bool TrendLine::is_broken(const int column, const double price) const {
         if (!active_ || column <= start_.column_index) return false;
         const double line_price = price_at_column(column);
-        if (type_ == TrendLineType::BullishSupport)
+        if (holds_above())
             return price < line_price - box_size_;
         return price > line_price + box_size_;
     }
 
+    TrendLineFamily TrendLine::family() const {
+        switch (type_) {
+            case TrendLineType::BullishInternal:
+            case TrendLineType::BearishInternal:
+                return TrendLineFamily::Internal;
+            case TrendLineType::BullishChannel:
+            case TrendLineType::BearishChannel:
+                return TrendLineFamily::Channel;
+            default:
+                return TrendLineFamily::Primary;
+        }
+    }
+
+    bool TrendLine::is_rising() const {
+        return type_ == TrendLineType::BullishSupport || type_ == TrendLineType::BullishInternal ||
+               type_ == TrendLineType::BullishChannel;
+    }
+
+    bool TrendLine::holds_above() const {
+        return type_ == TrendLineType::BullishSupport || type_ == TrendLineType::BullishInternal ||
+               type_ == TrendLineType::BearishChannel;
+    }
+
     bool TrendLine::test(const int column, const double price) {
         if (!active_ || column <= start_.column_index) return false;
         if (const double line_price = price_at_column(column); std::abs(price - line_price) < box_size_ * 0.5) {
@@ -54,152 +79,379 @@ namespace pnf
 
     std::string TrendLine::to_string() const {
         std::ostringstream oss;
-        const char* type_str = (type_ == TrendLineType::BullishSupport) ?
-                               "Bullish Support" : "Bearish Resistance";
+        const char* type_str = "Bearish Resistance";
+        switch (type_) {
+            case TrendLineType::BullishSupport: type_str = "Bullish Support"; break;
+            case TrendLineType::BullishInternal: type_str = "Bullish Internal"; break;
+            case TrendLineType::BearishInternal: type_str = "Bearish Internal"; break;
+            case TrendLineType::BullishChannel: type_str = "Bullish Channel"; break;
+            case TrendLineType::BearishChannel: type_str = "Bearish Channel"; break;
+            default: break;
+        }
         oss << type_str << " Line: Start(Col:" << start_.column_index
             << ", Price:" << start_.price << ") Active:" << (active_ ? "Yes" : "No")
             << " Touched:" << touch_count_ << " times";
         return oss.str();
     }
 
-    TrendLineManager::TrendLineManager(const double box_size)
-        : active_(nullptr), box_size_(box_size) {}
+    TrendLineManager::TrendLineManager(const double box_size, std::pmr::memory_resource* resource)
+        : lines_(resource ? resource : std::pmr::get_default_resource()), active_(nullptr), box_size_(box_size),
+          pivot_lows_(lines_.get_allocator()), pivot_highs_(lines_.get_allocator()),
+          history_{std::pmr::vector<TrendLineSpan>(lines_.get_allocator()),
+                   std::pmr::vector<TrendLineSpan>(lines_.get_allocator()),
+                   std::pmr::vector<TrendLineSpan>(lines_.get_allocator())},
+          events_(lines_.get_allocator()) {}
+
+    TrendLineManager::TrendLineManager(const TrendLineManager& other)
+        : TrendLineManager(other, other.lines_.get_allocator().resource()) {}
+
+    TrendLineManager::TrendLineManager(const TrendLineManager& other, std::pmr::memory_resource* resource)
+        : TrendLineManager(other.box_size_, resource) {
+        pivot_lows_.assign(other.pivot_lows_.begin(), other.pivot_lows_.end());
+        pivot_highs_.assign(other.pivot_highs_.begin(), other.pivot_highs_.end());
+        indexed_ = other.indexed_;
+        internal_pivot_ = other.internal_pivot_;
+        hull_indexed_ = other.hull_indexed_;
+        hull_column_ = other.hull_column_;
+        hull_offset_ = other.hull_offset_;
+
+        std::unordered_map<const TrendLine*, TrendLine*> copies;
+        lines_.reserve(other.lines_.size());
+        for (const auto& line : other.lines_) {
+            lines_.push_back(make_line(*line));
+            copies.emplace(line.get(), lines_.back().get());
+        }
+        const auto copy_of = [&copies](const TrendLine* line) { return line ? copies.at(line) : nullptr; };
+        active_ = copy_of(other.active_);
+        internal_ = copy_of(other.internal_);
+        channel_ = copy_of(other.channel_);
+        parent_ = copy_of(other.parent_);
+        for (size_t f = 0; f < history_.size(); f++) {
+            history_[f].reserve(other.history_[f].size());
+            for (const auto& span : other.history_[f]) history_[f].push_back({span.from_column, copy_of(span.line)});
+        }
+        events_.reserve(other.events_.size());
+        for (const auto& event : other.events_) events_.push_back({event.type, event.column, copy_of(event.line)});
+    }
+
+    namespace {
+        // Live lines are the most recent ones, so search from the back.
+        int line_index(const std::pmr::vector<TrendLinePtr>& lines, const TrendLine* line) {
+            if (!line) return -1;
+            for (size_t i = lines.size(); i-- > 0;) {
+                if (lines[i].get() == line) return static_cast<int>(i);
+            }
+            return -1;
+        }
+    }
+
+    TrendLineCheckpoint TrendLineManager::checkpoint() const {
+        TrendLineCheckpoint cp;
+        cp.lines = lines_.size();
+        cp.events = events_.size();
+        for (size_t f = 0; f < history_.size(); f++) cp.history[f] = history_[f].size();
+        cp.pivot_lows = pivot_lows_.size();
+        cp.pivot_highs = pivot_highs_.size();
+        cp.indexed = indexed_;
+        cp.active = line_index(lines_, active_);
+        cp.internal = line_index(lines_, internal_);
+        cp.channel = line_index(lines_, channel_);
+        cp.parent = line_index(lines_, parent_);
+        for (const int index : {cp.active, cp.internal, cp.channel}) {
+            if (index >= 0 && std::ranges::none_of(cp.live, [index](const auto& l) { return l.first == index; }))
+                cp.live.emplace_back(index, *lines_[index]);
+        }
+        cp.box_size = box_size_;
+        cp.internal_pivot = internal_pivot_;
+        cp.hull_indexed = hull_indexed_;
+        cp.hull_column = hull_column_;
+        cp.hull_offset = hull_offset_;
+        return cp;
+    }
+
+    void TrendLineManager::restore(const TrendLineCheckpoint& checkpoint) {
+        lines_.resize(std::min(lines_.size(), checkpoint.lines));
+        events_.resize(std::min(events_.size(), checkpoint.events));
+        for (size_t f = 0; f < history_.size(); f++)
+            history_[f].resize(std::min(history_[f].size(), checkpoint.history[f]));
+        pivot_lows_.resize(std::min(pivot_lows_.size(), checkpoint.pivot_lows));
+        pivot_highs_.resize(std::min(pivot_highs_.size(), checkpoint.pivot_highs));
+        indexed_ = checkpoint.indexed;
+        for (const auto& [index, line] : checkpoint.live) {
+            if (index < static_cast<int>(lines_.size())) *lines_[index] = line;
+        }
+        const auto line_at_index = [this](const int index) {
+            return index >= 0 && index < static_cast<int>(lines_.size()) ? lines_[index].get() : nullptr;
+        };
+        active_ = line_at_index(checkpoint.active);
+        internal_ = line_at_index(checkpoint.internal);
+        channel_ = line_at_index(checkpoint.channel);
+        parent_ = line_at_index(checkpoint.parent);
+        box_size_ = checkpoint.box_size;
+        internal_pivot_ = checkpoint.internal_pivot;
+        hull_indexed_ = checkpoint.hull_indexed;
+        hull_column_ = checkpoint.hull_column;
+        hull_offset_ = checkpoint.hull_offset;
+    }
+
+    double TrendLineManager::line_box_size(const Column* anchor) const {
+        return anchor->box_size() > 0.0 ? anchor->box_size() : box_size_;
+    }
 
     void TrendLineManager::clear() {
         lines_.clear();
         active_ = nullptr;
+        pivot_lows_.clear();
+        pivot_highs_.clear();
+        indexed_ = 0;
+        for (auto& spans : history_) spans.clear();
+        events_.clear();
+        internal_ = nullptr;
+        channel_ = nullptr;
+        parent_ = nullptr;
+        internal_pivot_ = -1;
+        hull_indexed_ = 0;
+        hull_column_ = -1;
+        hull_offset_ = 0.0;
+    }
+
+    TrendLine* TrendLineManager::activate(TrendLinePtr line, const int column) {
+        lines_.push_back(std::move(line));
+        TrendLine* stored = lines_.back().get();
+        history_[static_cast<size_t>(stored->family())].push_back({column, stored});
+        events_.push_back({TrendLineEventType::Drawn, column, stored});
+        return stored;
+    }
+
+    void TrendLineManager::break_line(TrendLine* line, const int column) {
+        line->mark_broken(column);
+        events_.push_back({TrendLineEventType::Broken, column, line});
+    }
+
+    bool TrendLineManager::test_line(TrendLine* line, const int column, const double price) {
+        if (line->is_broken(column, price)) {
+            break_line(line, column);
+            return true;
+        }
+        if (line->test(column, price)) events_.push_back({TrendLineEventType::Touched, column, line});
+        return false;
+    }
+
+    const TrendLine* TrendLineManager::line_at(const int column, const TrendLineFamily family) const {
+        // Each family activates at most one line per column, so spans are sorted by from_column.
+        const auto& spans = history_[static_cast<size_t>(family)];
+        const auto it = std::upper_bound(spans.begin(), spans.end(), column,
+            [](const int c, const TrendLineSpan& span) { return c < span.from_column; });
+        if (it == spans.begin()) return nullptr;
+        const TrendLine* line = std::prev(it)->line;
+        if (const int broken = line->break_column(); broken >= 0 && column >= broken) return nullptr;
+        return line;
+    }
+
+    bool TrendLineManager::bullish_bias_at(const int column) const {
+        const TrendLine* line = line_at(column);
+        return line && line->type() == TrendLineType::BullishSupport;
+    }
+
+    bool TrendLineManager::bearish_bias_at(const int column) const {
+        const TrendLine* line = line_at(column);
+        return line && line->type() == TrendLineType::BearishResistance;
     }
 
     bool TrendLineManager::is_significant_low(const Column* col,
-        const std::vector<std::unique_ptr<Column>>& all, int index) {
+        const ColumnList& all, int index) {
         if (col->type() != ColumnType::O || index < 1) return false;
 
         const double current_low = col->lowest_price();
-        const Column* prev = all[index - 1].get();
+        const Column* prev = &all[index - 1];
         if (prev->type() != ColumnType::X) return false;
         if (current_low >= prev->highest_price()) return false;
 
         const int lookback = std::min(3, index);
         for (int i = 1; i <= lookback; i++) {
-            if (index - i >= 0 && all[index - i]->lowest_price() < current_low)
+            if (index - i >= 0 && all[index - i].lowest_price() < current_low)
                 return false;
         }
         return true;
     }
 
     bool TrendLineManager::is_significant_high(const Column* col,
-        const std::vector<std::unique_ptr<Column>>& all, int index) {
+        const ColumnList& all, int index) {
         if (col->type() != ColumnType::X || index < 1) return false;
 
         const double current_high = col->highest_price();
-        const Column* prev = all[index - 1].get();
+        const Column* prev = &all[index - 1];
         if (prev->type() != ColumnType::O) return false;
         if (current_high <= prev->lowest_price()) return false;
 
         const int lookback = std::min(3, index);
         for (int i = 1; i <= lookback; i++) {
-            if (index - i >= 0 && all[index - i]->highest_price() > current_high)
+            if (index - i >= 0 && all[index - i].highest_price() > current_high)
                 return false;
         }
         return true;
     }
 
-    int TrendLineManager::find_significant_low(
-        const std::vector<std::unique_ptr<Column>>& columns, int from) {
-        for (int i = from; i >= 0; i--) {
-            if (is_significant_low(columns[i].get(), columns, i))
-                return i;
+    namespace {
+        int latest_pivot(const std::pmr::vector<int>& pivots, const int from) {
+            if (!pivots.empty() && pivots.back() <= from) return pivots.back();
+            const auto it = std::upper_bound(pivots.begin(), pivots.end(), from);
+            return it == pivots.begin() ? -1 : *(it - 1);
         }
-        return -1;
     }
 
-    int TrendLineManager::find_significant_high(
-        const std::vector<std::unique_ptr<Column>>& columns, int from) {
-        for (int i = from; i >= 0; i--) {
-            if (is_significant_high(columns[i].get(), columns, i))
-                return i;
+    void TrendLineManager::index_pivots(
+        const ColumnList& columns, int through) {
+        if (static_cast<int>(columns.size()) < indexed_) {
+            pivot_lows_.clear();
+            pivot_highs_.clear();
+            indexed_ = 0;
         }
-        return -1;
+        through = std::min(through, static_cast<int>(columns.size()) - 1);
+        for (; indexed_ <= through; indexed_++) {
+            const Column* col = &columns[indexed_];
+            if (is_significant_low(col, columns, indexed_)) pivot_lows_.push_back(indexed_);
+            if (is_significant_high(col, columns, indexed_)) pivot_highs_.push_back(indexed_);
+        }
+    }
+
+    int TrendLineManager::find_significant_low(
+        const ColumnList& columns, const int from) {
+        if (from < 0) return -1;
+        index_pivots(columns, from);
+        return latest_pivot(pivot_lows_, from);
+    }
+
+    int TrendLineManager::find_significant_high(
+        const ColumnList& columns, const int from) {
+        if (from < 0) return -1;
+        index_pivots(columns, from);
+        return latest_pivot(pivot_highs_, from);
     }
 
     void TrendLineManager::process_new_column(
-        const std::vector<std::unique_ptr<Column>>& columns, int col_index) {
+        const ColumnList& columns, int col_index) {
         if (col_index < 1 || col_index >= static_cast<int>(columns.size())) return;
 
-        const Column* current = columns[col_index].get();
-
-        if (const Column* prev = columns[col_index - 1].get(); current->type() == ColumnType::X && prev->type() == ColumnType::O) {
-            if (active_ && active_->type() == TrendLineType::BearishResistance) {
-                if (const double high = current->highest_price(); active_->is_broken(col_index, high)) {
-                    active_->set_active(false);
-                    if (int low_col = find_significant_low(columns, col_index - 1); low_col >= 0) {
-                        const Column* low_column = columns[low_col].get();
-                        auto line = std::make_unique<TrendLine>(
-                            TrendLineType::BullishSupport, low_col,
-                            low_column->lowest_price(), 0, box_size_);
-                        lines_.push_back(std::move(line));
-                        active_ = lines_.back().get();
-                    }
-                }
-            } else if (!active_) {
-                if (int low_col = find_significant_low(columns, col_index - 1); low_col >= 0) {
-                    const Column* low_column = columns[low_col].get();
-                    auto line = std::make_unique<TrendLine>(
-                        TrendLineType::BullishSupport, low_col,
-                        low_column->lowest_price(), 0, box_size_);
-                    lines_.push_back(std::move(line));
-                    active_ = lines_.back().get();
-                }
+        const Column* current = &columns[col_index];
+        const Column* prev = &columns[col_index - 1];
+        const bool rising = current->type() == ColumnType::X && prev->type() == ColumnType::O;
+        const bool falling = current->type() == ColumnType::O && prev->type() == ColumnType::X;
+        if (!rising && !falling) return;
+
+        // A live line is only replaced once this column breaks it; a line already
+        // broken (e.g. by check_break) or a missing one is replaced right away.
+        if (active_ && active_->is_active()) {
+            const bool broken = rising
+                ? active_->type() == TrendLineType::BearishResistance &&
+                  active_->is_broken(col_index, current->highest_price())
+                : active_->type() == TrendLineType::BullishSupport &&
+                  active_->is_broken(col_index, current->lowest_price());
+            if (!broken) return;
+            break_line(active_, col_index);
+        }
+
+        if (rising) {
+            if (int low_col = find_significant_low(columns, col_index - 1); low_col >= 0) {
+                const Column* low_column = &columns[low_col];
+                auto line = make_line(
+                    TrendLineType::BullishSupport, low_col,
+                    low_column->lowest_price(), 0, line_box_size(low_column));
+                active_ = activate(std::move(line), col_index);
             }
-        } else if (current->type() == ColumnType::O && prev->type() == ColumnType::X) {
-            if (active_ && active_->type() == TrendLineType::BullishSupport) {
-                if (const double low = current->lowest_price(); active_->is_broken(col_index, low)) {
-                    active_->set_active(false);
-                    if (int high_col = find_significant_high(columns, col_index - 1); high_col >= 0) {
-                        const Column* high_column = columns[high_col].get();
-                        auto line = std::make_unique<TrendLine>(
-                            TrendLineType::BearishResistance, high_col,
-                            high_column->highest_price(), 0, box_size_);
-                        lines_.push_back(std::move(line));
-                        active_ = lines_.back().get();
-                    }
-                }
-            } else if (!active_) {
-                if (int high_col = find_significant_high(columns, col_index - 1); high_col >= 0) {
-                    const Column* high_column = columns[high_col].get();
-                    auto line = std::make_unique<TrendLine>(
-                        TrendLineType::BearishResistance, high_col,
-                        high_column->highest_price(), 0, box_size_);
-                    lines_.push_back(std::move(line));
-                    active_ = lines_.back().get();
-                }
+        } else {
+            if (int high_col = find_significant_high(columns, col_index - 1); high_col >= 0) {
+                const Column* high_column = &columns[high_col];
+                auto line = make_line(
+                    TrendLineType::BearishResistance, high_col,
+                    high_column->highest_price(), 0, line_box_size(high_column));
+                active_ = activate(std::move(line), col_index);
             }
         }
     }
 
     void TrendLineManager::check_break(
-        const std::vector<std::unique_ptr<Column>>& columns, int col_index) const {
+        const ColumnList& columns, int col_index) {
         if (!active_ || !active_->is_active()) return;
         if (col_index < 0 || col_index >= static_cast<int>(columns.size())) return;
 
-        const Column* current = columns[col_index].get();
-        if (active_->type() == TrendLineType::BullishSupport) {
-            if (const double low = current->lowest_price(); active_->is_broken(col_index, low))
-                active_->set_active(false);
-            else
-                active_->test(col_index, low);
-        } else {
-            if (const double high = current->highest_price(); active_->is_broken(col_index, high))
-                active_->set_active(false);
-            else
-                active_->test(col_index, high);
+        const Column* current = &columns[col_index];
+        test_line(active_, col_index, active_->holds_above() ? current->lowest_price() : current->highest_price());
+    }
+
+    void TrendLineManager::update_secondary(
+        const ColumnList& columns, const int col_index) {
+        if (col_index < 0 || col_index >= static_cast<int>(columns.size())) return;
+
+        const TrendLine* primary = active_ && active_->is_active() ? active_ : nullptr;
+        if (primary != parent_) {
+            // Secondary lines belong to one primary line; retire them with it.
+            if (internal_ && internal_->is_active()) internal_->mark_broken(col_index);
+            if (channel_ && channel_->is_active()) channel_->mark_broken(col_index);
+            internal_ = nullptr;
+            channel_ = nullptr;
+            parent_ = primary;
+            internal_pivot_ = -1;
+            hull_column_ = -1;
+            hull_indexed_ = primary ? primary->start_point().column_index + 1 : 0;
+        }
+        if (!primary) return;
+
+        const int anchor = primary->start_point().column_index;
+        const double slope = primary->box_size();
+        const bool rising = primary->is_rising();
+        const Column* current = &columns[col_index];
+
+        // With a fixed 45-degree slope the channel side of the hull is the column
+        // whose extreme, shifted back along the slope, is furthest from the line.
+        for (; hull_indexed_ < col_index; hull_indexed_++) {
+            const Column* col = &columns[hull_indexed_];
+            const double distance = slope * (hull_indexed_ - anchor);
+            const double offset = rising ? col->highest_price() - distance : col->lowest_price() + distance;
+            if (hull_column_ < 0 || (rising ? offset > hull_offset_ : offset < hull_offset_)) {
+                hull_column_ = hull_indexed_;
+                hull_offset_ = offset;
+            }
+        }
+
+        if (!channel_ && hull_column_ >= 0) {
+            const Column* extreme = &columns[hull_column_];
+            channel_ = activate(make_line(
+                rising ? TrendLineType::BullishChannel : TrendLineType::BearishChannel, hull_column_,
+                rising ? extreme->highest_price() : extreme->lowest_price(), 0, slope), col_index);
+        }
+        if (channel_ && test_line(channel_, col_index,
+                channel_->holds_above() ? current->lowest_price() : current->highest_price()))
+            channel_ = nullptr;
+
+        // Internal lines run through the latest pivot that sits inside the trend,
+        // more than a box away from the primary line; a newer such pivot replaces them.
+        const std::pmr::vector<int>& pivots = rising ? pivot_lows_ : pivot_highs_;
+        if (!pivots.empty() && pivots.back() > std::max(anchor, internal_pivot_)) {
+            const int pivot = pivots.back();
+            internal_pivot_ = pivot;
+            const Column* col = &columns[pivot];
+            const double price = rising ? col->lowest_price() : col->highest_price();
+            const double line_price = primary->price_at_column(pivot);
+            if (rising ? price > line_price + slope : price < line_price - slope) {
+                if (internal_) internal_->mark_broken(col_index);
+                internal_ = activate(make_line(
+                    rising ? TrendLineType::BullishInternal : TrendLineType::BearishInternal,
+                    pivot, price, 0, slope), col_index);
+            }
         }
+        if (internal_ && test_line(internal_, col_index,
+                internal_->holds_above() ? current->lowest_price() : current->highest_price()))
+            internal_ = nullptr;
     }
 
     void TrendLineManager::update(
-        const std::vector<std::unique_ptr<Column>>& columns, const int new_column_index) {
+        const ColumnList& columns, const int new_column_index) {
+        // Every column before the new one is final; keep the pivot stacks current.
+        index_pivots(columns, new_column_index - 1);
         check_break(columns, new_column_index);
         process_new_column(columns, new_column_index);
+        update_secondary(columns, new_column_index);
     }
 
     bool TrendLineManager::is_above_bullish_support(const int column, const double price) const {
@@ -274,14 +274,8 @@ namespace pnf
             const double box_size = chart_->current_box_size();
 
             // Price range
-            double min_price = std::numeric_limits<double>::max();
-            double max_price = std::numeric_limits<double>::lowest();
-
-            for (size_t i = 0; i < chart_->column_count(); i++) {
-                const Column* col = chart_->column(i);
-                min_price = std::min(min_price, col->lowest_price());
-                max_price = std::max(max_price, col->highest_price());
-            }
+            const double min_price = chart_->lowest_price();
+            const double max_price = chart_->highest_price();
 
             const int rows = static_cast<int>((max_price - min_price) / box_size) + 1;
             const int cols = static_cast<int>(chart_->column_count());
@@ -388,8 +382,7 @@ namespace pnf
             const uint32_t color = (col->type() == ColumnType::X) ? config_.x_color : config_.o_color;
 
             for (size_t b = 0; b < col->box_count(); b++) {
-                const Box* box = col->get_box_at(b);
-                const double price = box->price();
+                const double price = col->box_at(b).price();
                 const int row = static_cast<int>((max_price - price) / box_size);
                 const int y_center = start_y + static_cast<int>(row * cell_h + cell_h / 2);
 
@@ -410,7 +403,7 @@ namespace pnf
             const int chart_width = config_.window_width - config_.margin_left - config_.margin_right;
 
             // Support levels (green dashed lines)
-            for (const auto& level : sr->support_levels()) {
+            for (const auto& level : sr->support_levels_view()) {
                 const int row = static_cast<int>((max_price - level.price) / box_size);
 
                 if (const int y = start_y + static_cast<int>(row * cell_h); y >= config_.margin_top && y <= config_.window_height - config_.margin_bottom) {
@@ -422,7 +415,7 @@ namespace pnf
             }
 
             // Resistance levels (red dashed lines)
-            for (const auto& level : sr->resistance_levels()) {
+            for (const auto& level : sr->resistance_levels_view()) {
                 const int row = static_cast<int>((max_price - level.price) / box_size);
 
                 if (const int y = start_y + static_cast<int>(row * cell_h); y >= config_.margin_top && y <= config_.window_height - config_.margin_bottom) {
@@ -547,10 +540,7 @@ namespace pnf
                     data.column_index = static_cast<int>((event.x - start_x) / scaled_cell_w);
 
                     const double box_size = chart_->current_box_size();
-                    double max_price = std::numeric_limits<double>::lowest();
-                    for (size_t i = 0; i < chart_->column_count(); i++) {
-                        max_price = std::max(max_price, chart_->column(i)->highest_price());
-                    }
+                    const double max_price = chart_->highest_price();
                     const int row = static_cast<int>((event.y - start_y) / scaled_cell_h);
                     data.price = max_price - row * box_size;
                 }
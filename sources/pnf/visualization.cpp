@@ -9,9 +9,16 @@
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
+#include <span>
 
 namespace pnf
 {
+    namespace {
+        long long epoch_ms(const Timestamp time) {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+        }
+    }
+
     AsciiRenderer::AsciiRenderer(const RenderConfig& config) : config_(config) {}
 
     std::string AsciiRenderer::render_column_header(const size_t start, const size_t count) const {
@@ -50,22 +57,20 @@ namespace pnf
         std::ostringstream oss;
         const double box_size = chart.current_box_size();
 
-        double min_price = std::numeric_limits<double>::max();
-        double max_price = std::numeric_limits<double>::lowest();
-
         size_t start_col = 0;
         const size_t end_col = chart.column_count();
         if (config_.max_columns > 0 && chart.column_count() > static_cast<size_t>(config_.max_columns)) {
             start_col = chart.column_count() - config_.max_columns;
         }
 
-        for (size_t i = start_col; i < end_col; i++) {
-            const Column* col = chart.column(i);
-            min_price = std::min(min_price, col->lowest_price());
-            max_price = std::max(max_price, col->highest_price());
-        }
+        const double min_price = series_min(std::span(chart.column_lows()).subspan(start_col));
+        const double max_price = series_max(std::span(chart.column_highs()).subspan(start_col));
 
-        const int rows = static_cast<int>((max_price - min_price) / box_size) + 1;
+        // Logarithmic charts sit on a shared level table, so rows are level indices.
+        const LogBoxGrid* levels = chart.log_grid();
+        const int top_level = levels ? levels->floor_index(max_price) : 0;
+        const int rows = levels ? top_level - levels->floor_index(min_price) + 1
+                                : static_cast<int>((max_price - min_price) / box_size) + 1;
         const size_t cols = end_col - start_col;
 
         std::vector<std::vector<char>> grid(rows, std::vector<char>(cols, config_.empty_char));
@@ -75,8 +80,10 @@ namespace pnf
             const char ch = (col->type() == ColumnType::X) ? config_.x_char : config_.o_char;
 
             for (size_t b = 0; b < col->box_count(); b++) {
-                const Box* box = col->get_box_at(b);
-                if (const int row = static_cast<int>((max_price - box->price()) / box_size); row >= 0 && row < rows) {
+                const double price = col->box_at(b).price();
+                const int row = levels ? top_level - levels->floor_index(price)
+                                       : static_cast<int>((max_price - price) / box_size);
+                if (row >= 0 && row < rows) {
                     grid[row][c - start_col] = ch;
                 }
             }
@@ -88,7 +95,7 @@ namespace pnf
 
         for (int r = 0; r < rows; r++) {
             if (config_.show_price_axis) {
-                const double price = max_price - r * box_size;
+                const double price = levels ? levels->level(top_level - r) : max_price - r * box_size;
                 oss << std::fixed << std::setprecision(config_.price_decimals)
                     << std::setw(9) << price << " ";
             }
@@ -106,9 +113,7 @@ namespace pnf
             for (size_t c = start_col; c < end_col; c++) {
                 const Column* col = chart.column(c);
                 std::string marker;
-                if (col->box_count() > 0) {
-                    if (const Box* first_box = col->get_box_at(0)) marker = first_box->marker();
-                }
+                if (col->box_count() > 0) marker = col->box_at(0).marker();
                 if (!marker.empty()) {
                     oss << std::setw(config_.cell_width) << marker;
                 } else {
@@ -188,8 +193,7 @@ namespace pnf
         const int x_center = config_.margin_left + col_index * config_.box_width + config_.box_width / 2;
 
         for (size_t b = 0; b < col->box_count(); b++) {
-            const Box* box = col->get_box_at(b);
-            const double price = box->price();
+            const double price = col->box_at(b).price();
             const int row = static_cast<int>((price - min_price) / box_size);
             const int y_center = config_.margin_top + (static_cast<int>((col->highest_price() - min_price) / box_size) - row) * config_.box_height + config_.box_height / 2;
 
@@ -211,20 +215,25 @@ namespace pnf
 
         oss << "<g stroke=\"" << config_.trend_line_color << "\" stroke-width=\"2\" stroke-dasharray=\"5,3\">\n";
 
-        for (const auto& lines = tm->all_trend_lines(); const auto & i : lines) {
-            const TrendLine* line = i.get();
-            if (!line || !line->is_active()) continue;
+        const int last_column = static_cast<int>(chart.column_count()) - 1;
+        for (const auto family : {TrendLineFamily::Primary, TrendLineFamily::Internal, TrendLineFamily::Channel}) {
+            for (const auto& span : tm->history(family)) {
+                const TrendLine* line = span.line;
+                if (!line) continue;
 
-            const TrendLinePoint& start = line->start_point();
-            const TrendLinePoint& end = line->end_point();
+                // Draw each line across the columns it governed, ending at its break.
+                const TrendLinePoint& start = line->start_point();
+                const int end_column = line->break_column() >= 0 ? line->break_column() : last_column;
+                const double end_price = line->price_at_column(end_column);
 
-            const int x1 = config_.margin_left + start.column_index * config_.box_width + config_.box_width / 2;
-            const int y1 = config_.margin_top + static_cast<int>((chart.column(0)->highest_price() - start.price) / box_size) * config_.box_height + config_.box_height / 2;
-            const int x2 = config_.margin_left + end.column_index * config_.box_width + config_.box_width / 2;
-            const int y2 = config_.margin_top + static_cast<int>((chart.column(0)->highest_price() - end.price) / box_size) * config_.box_height + config_.box_height / 2;
+                const int x1 = config_.margin_left + start.column_index * config_.box_width + config_.box_width / 2;
+                const int y1 = config_.margin_top + static_cast<int>((chart.column(0)->highest_price() - start.price) / box_size) * config_.box_height + config_.box_height / 2;
+                const int x2 = config_.margin_left + end_column * config_.box_width + config_.box_width / 2;
+                const int y2 = config_.margin_top + static_cast<int>((chart.column(0)->highest_price() - end_price) / box_size) * config_.box_height + config_.box_height / 2;
 
-            oss << "  <line x1=\"" << x1 << "\" y1=\"" << y1
-                << "\" x2=\"" << x2 << "\" y2=\"" << y2 << "\"/>\n";
+                oss << "  <line x1=\"" << x1 << "\" y1=\"" << y1
+                    << "\" x2=\"" << x2 << "\" y2=\"" << y2 << "\"/>\n";
+            }
         }
 
         oss << "</g>\n";
@@ -242,14 +251,14 @@ namespace pnf
 
         oss << "<g stroke-width=\"1\" stroke-dasharray=\"3,3\">\n";
 
-        for (const auto& level : sr->support_levels()) {
+        for (const auto& level : sr->support_levels_view()) {
             const int y = config_.margin_top + static_cast<int>((sr->levels().front().price - level.price) / box_size) * config_.box_height;
             oss << "  <line x1=\"" << config_.margin_left << "\" y1=\"" << y
                 << "\" x2=\"" << (config_.margin_left + chart_width) << "\" y2=\"" << y
                 << "\" stroke=\"" << config_.support_color << "\"/>\n";
         }
 
-        for (const auto& level : sr->resistance_levels()) {
+        for (const auto& level : sr->resistance_levels_view()) {
             const int y = config_.margin_top + static_cast<int>((sr->levels().front().price - level.price) / box_size) * config_.box_height;
             oss << "  <line x1=\"" << config_.margin_left << "\" y1=\"" << y
                 << "\" x2=\"" << (config_.margin_left + chart_width) << "\" y2=\"" << y
@@ -268,16 +277,10 @@ namespace pnf
     std::string SvgRenderer::render(const Chart& chart) const {
         if (chart.column_count() == 0) return "";
 
-        double min_price = std::numeric_limits<double>::max();
-        double max_price = std::numeric_limits<double>::lowest();
+        const double min_price = chart.lowest_price();
+        const double max_price = chart.highest_price();
         const double box_size = chart.current_box_size();
 
-        for (size_t i = 0; i < chart.column_count(); i++) {
-            const Column* col = chart.column(i);
-            min_price = std::min(min_price, col->lowest_price());
-            max_price = std::max(max_price, col->highest_price());
-        }
-
         const int rows = static_cast<int>((max_price - min_price) / box_size) + 1;
         const int cols = static_cast<int>(chart.column_count());
 
@@ -304,16 +307,10 @@ namespace pnf
     std::string SvgRenderer::render_with_indicators(const Chart& chart, const Indicators& indicators) const {
         if (chart.column_count() == 0) return "";
 
-        double min_price = std::numeric_limits<double>::max();
-        double max_price = std::numeric_limits<double>::lowest();
+        const double min_price = chart.lowest_price();
+        const double max_price = chart.highest_price();
         const double box_size = chart.current_box_size();
 
-        for (size_t i = 0; i < chart.column_count(); i++) {
-            const Column* col = chart.column(i);
-            min_price = std::min(min_price, col->lowest_price());
-            max_price = std::max(max_price, col->highest_price());
-        }
-
         const int rows = static_cast<int>((max_price - min_price) / box_size) + 1;
         const int cols = static_cast<int>(chart.column_count());
 
@@ -379,6 +376,9 @@ namespace pnf
             oss << indent(3) << "\"type\":" << sp << "\"" << (col->type() == ColumnType::X ? "X" : "O") << "\"," << nl;
             oss << indent(3) << "\"high\":" << sp << col->highest_price() << "," << nl;
             oss << indent(3) << "\"low\":" << sp << col->lowest_price() << "," << nl;
+            oss << indent(3) << "\"bar_count\":" << sp << col->bar_count() << "," << nl;
+            oss << indent(3) << "\"first_time\":" << sp << epoch_ms(col->first_time()) << "," << nl;
+            oss << indent(3) << "\"last_time\":" << sp << epoch_ms(col->last_time()) << "," << nl;
             oss << indent(3) << "\"box_count\":" << sp << col->box_count();
 
             if (config_.include_boxes) {
@@ -386,7 +386,7 @@ namespace pnf
                 oss << indent(3) << "\"boxes\":" << sp << "[";
                 for (size_t b = 0; b < col->box_count(); b++) {
                     if (b > 0) oss << "," << sp;
-                    oss << col->get_box_at(b)->price();
+                    oss << col->box_at(b).price();
                 }
                 oss << "]" << nl;
             } else {
@@ -528,9 +528,7 @@ namespace pnf
         for (size_t i = 0; i < chart.column_count(); i++) {
             const Column* col = chart.column(i);
             std::string marker;
-            if (col->box_count() > 0) {
-                if (const Box* first_box = col->get_box_at(0)) marker = first_box->marker();
-            }
+            if (col->box_count() > 0) marker = col->box_at(0).marker();
             oss << i << ","
                 << (col->type() == ColumnType::X ? "X" : "O") << ","
                 << col->highest_price() << ","
@@ -553,7 +551,7 @@ namespace pnf
 
             for (size_t b = 0; b < col->box_count(); b++) {
                 oss << c << "," << b << "," << type << ","
-                    << col->get_box_at(b)->price() << "\n";
+                    << col->box_at(b).price() << "\n";
             }
         }
 
@@ -0,0 +1,188 @@
+/// \file test_backtest.cpp
+/// \brief Test backtester implementation.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include "pnf/pnf.hpp"
+#include <cmath>
+
+using namespace pnf;
+
+class BacktestTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        config.chart.box_size_method = BoxSizeMethod::Fixed;
+        config.chart.box_size = 1.0;
+        config.chart.reversal = 3;
+        config.require_trend_bias = false;
+        config.use_objective_targets = false;
+    }
+
+    std::vector<OHLC> make_bars(const std::vector<double>& closes) const {
+        std::vector<OHLC> bars;
+        Timestamp t = start;
+        for (const double c : closes) {
+            bars.push_back({t, c, c, c, c, 0.0});
+            t += std::chrono::hours(1);
+        }
+        return bars;
+    }
+
+    BacktestConfig config;
+    Timestamp start = std::chrono::system_clock::now();
+};
+
+TEST_F(BacktestTest, NoBarsNoTrades) {
+    Backtester bt(config);
+    const auto result = bt.run({});
+    EXPECT_TRUE(result.trades.empty());
+    EXPECT_TRUE(result.equity.empty());
+}
+
+TEST_F(BacktestTest, BuySignalThenOppositeSignal) {
+    // X to 105, O to 101, X to 107 (double top buy), O to 95 (double bottom sell).
+    const auto bars = make_bars({100, 105, 101, 107, 103, 95, 95});
+    Backtester bt(config);
+    const auto result = bt.run(bars);
+
+    ASSERT_EQ(result.trades.size(), 1u);
+    const Trade& t = result.trades[0];
+    EXPECT_TRUE(t.is_long);
+    EXPECT_EQ(t.trigger, TradeTrigger::Signal);
+    EXPECT_EQ(t.entry_bar, 3u);
+    EXPECT_DOUBLE_EQ(t.entry_price, 107.0);
+    EXPECT_EQ(t.exit_reason, TradeExitReason::OppositeSignal);
+    EXPECT_EQ(t.exit_bar, 5u);
+    EXPECT_DOUBLE_EQ(t.exit_price, 95.0);
+    EXPECT_DOUBLE_EQ(t.pnl, -12.0);
+    EXPECT_DOUBLE_EQ(result.net_profit, -12.0);
+    EXPECT_EQ(result.losing_trades, 1);
+    ASSERT_EQ(result.equity.size(), bars.size());
+    EXPECT_DOUBLE_EQ(result.equity.back(), -12.0);
+    EXPECT_DOUBLE_EQ(result.max_drawdown, 12.0);
+}
+
+TEST_F(BacktestTest, SlippageAndCommission) {
+    config.slippage = 0.5;
+    config.commission = 1.0;
+    const auto bars = make_bars({100, 105, 101, 107, 103, 95});
+    Backtester bt(config);
+    const auto result = bt.run(bars);
+
+    ASSERT_EQ(result.trades.size(), 1u);
+    EXPECT_DOUBLE_EQ(result.trades[0].entry_price, 107.5);
+    EXPECT_DOUBLE_EQ(result.trades[0].exit_price, 94.5);
+    EXPECT_DOUBLE_EQ(result.trades[0].pnl, -13.0 - 2.0);
+}
+
+TEST_F(BacktestTest, ShortEntryWhenAllowed) {
+    config.allow_short = true;
+    const auto bars = make_bars({100, 105, 101, 107, 103, 95, 90});
+    Backtester bt(config);
+    const auto result = bt.run(bars);
+
+    ASSERT_EQ(result.trades.size(), 2u);
+    EXPECT_FALSE(result.trades[1].is_long);
+    EXPECT_EQ(result.trades[1].exit_reason, TradeExitReason::EndOfData);
+    EXPECT_DOUBLE_EQ(result.trades[1].pnl, 5.0);
+}
+
+TEST_F(BacktestTest, ObjectiveTargetExit) {
+    config.use_objective_targets = true;
+    config.exit_on_opposite_signal = false;
+    const auto bars = make_bars({100, 105, 101, 107, 130, 131});
+    Backtester bt(config);
+    const auto result = bt.run(bars);
+
+    ASSERT_FALSE(result.trades.empty());
+    const Trade& t = result.trades[0];
+    EXPECT_GT(t.target_price, t.entry_price);
+    EXPECT_EQ(t.exit_reason, TradeExitReason::Target);
+    EXPECT_EQ(t.exit_bar, 4u);
+    EXPECT_DOUBLE_EQ(t.exit_price, 130.0);
+}
+
+TEST_F(BacktestTest, StopExit) {
+    config.stop_boxes = 2;
+    config.exit_on_opposite_signal = false;
+    const auto bars = make_bars({100, 105, 101, 107, 104});
+    Backtester bt(config);
+    const auto result = bt.run(bars);
+
+    ASSERT_EQ(result.trades.size(), 1u);
+    EXPECT_EQ(result.trades[0].exit_reason, TradeExitReason::Stop);
+    EXPECT_DOUBLE_EQ(result.trades[0].stop_price, 105.0);
+    EXPECT_DOUBLE_EQ(result.trades[0].exit_price, 104.0);
+}
+
+TEST_F(BacktestTest, StreamingMatchesRun) {
+    std::vector<double> closes;
+    for (int i = 0; i < 500; i++) closes.push_back(100.0 + 15.0 * std::sin(i * 0.05) + 3.0 * std::sin(i * 0.9));
+    const auto bars = make_bars(closes);
+
+    Backtester batch(config);
+    const auto expected = batch.run(bars);
+
+    Backtester stream(config);
+    for (const auto& bar : bars) stream.on_bar(bar);
+    stream.finish();
+
+    EXPECT_EQ(stream.result().trades.size(), expected.trades.size());
+    EXPECT_DOUBLE_EQ(stream.result().net_profit, expected.net_profit);
+    EXPECT_EQ(stream.chart().column_count(), batch.chart().column_count());
+}
+
+TEST_F(BacktestTest, RunManyMatchesSequential) {
+    std::vector<std::vector<OHLC>> instruments;
+    for (int k = 0; k < 6; k++) {
+        std::vector<double> closes;
+        for (int i = 0; i < 300; i++) closes.push_back(100.0 + (10.0 + k) * std::sin(i * (0.03 + 0.01 * k)));
+        instruments.push_back(make_bars(closes));
+    }
+
+    ThreadPool pool(3);
+    const auto results = Backtester::run_many(instruments, config, pool);
+    ASSERT_EQ(results.size(), instruments.size());
+    for (size_t k = 0; k < instruments.size(); k++) {
+        Backtester bt(config);
+        const auto expected = bt.run(instruments[k]);
+        EXPECT_EQ(results[k].trades.size(), expected.trades.size());
+        EXPECT_DOUBLE_EQ(results[k].net_profit, expected.net_profit);
+    }
+}
+
+TEST_F(BacktestTest, PatternEntries) {
+    config.trade_signals = false;
+    config.trade_patterns = true;
+    const auto bars = make_bars({100, 105, 101, 107, 103, 95});
+    Backtester bt(config);
+    const auto result = bt.run(bars);
+
+    ASSERT_FALSE(result.trades.empty());
+    EXPECT_EQ(result.trades[0].trigger, TradeTrigger::Pattern);
+    EXPECT_TRUE(result.trades[0].is_long);
+}
+
+TEST_F(BacktestTest, CatapultEntry) {
+    config.trade_signals = false;
+    config.trade_patterns = true;
+    config.stop_boxes = 1;
+    // Triple top breakout at 106, stopped out on the pullback, then a double
+    // top breakout at 108 completes a bullish catapult.
+    const auto bars = make_bars({100, 105, 101, 105, 101, 106, 102, 108});
+    Backtester bt(config);
+    const auto result = bt.run(bars);
+
+    PatternRecognizer recognizer;
+    recognizer.detect(bt.chart());
+    EXPECT_TRUE(recognizer.has_pattern(PatternType::BullishCatapult));
+
+    ASSERT_EQ(result.trades.size(), 2u);
+    EXPECT_EQ(result.trades[0].exit_reason, TradeExitReason::Stop);
+    EXPECT_EQ(result.trades[1].trigger, TradeTrigger::Pattern);
+    EXPECT_EQ(result.trades[1].pattern, PatternType::BullishCatapult);
+    EXPECT_DOUBLE_EQ(result.trades[1].entry_price, 108.0);
+}
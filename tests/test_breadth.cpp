@@ -0,0 +1,104 @@
+/// \file test_breadth.cpp
+/// \brief Test market breadth implementation.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include "pnf/pnf.hpp"
+
+using namespace pnf;
+
+class BreadthTest : public ::testing::Test {
+protected:
+    UniverseBullishPercent bpi;
+    Timestamp now = std::chrono::system_clock::now();
+};
+
+TEST_F(BreadthTest, EmptyUniverse) {
+    EXPECT_EQ(bpi.symbol_count(), 0u);
+    EXPECT_DOUBLE_EQ(bpi.value(), 50.0);
+    EXPECT_TRUE(bpi.sectors().empty());
+}
+
+TEST_F(BreadthTest, CountsSignals) {
+    bpi.add_symbol("AAA", "Tech");
+    bpi.add_symbol("BBB", "Tech");
+    bpi.add_symbol("CCC", "Energy");
+    bpi.add_symbol("DDD", "Energy");
+
+    EXPECT_TRUE(bpi.update("AAA", SignalType::Buy));
+    EXPECT_TRUE(bpi.update("BBB", SignalType::Buy));
+    EXPECT_TRUE(bpi.update("CCC", SignalType::Sell));
+    EXPECT_TRUE(bpi.update("DDD", SignalType::Buy));
+    EXPECT_FALSE(bpi.update("DDD", SignalType::Buy));
+
+    EXPECT_EQ(bpi.buy_count(), 3);
+    EXPECT_EQ(bpi.sell_count(), 1);
+    EXPECT_DOUBLE_EQ(bpi.value(), 75.0);
+    EXPECT_DOUBLE_EQ(bpi.sector_value("Tech"), 100.0);
+    EXPECT_DOUBLE_EQ(bpi.sector_value("Energy"), 50.0);
+    EXPECT_TRUE(bpi.is_bullish_alert());
+
+    EXPECT_TRUE(bpi.update("AAA", SignalType::Sell));
+    EXPECT_DOUBLE_EQ(bpi.value(), 50.0);
+    EXPECT_DOUBLE_EQ(bpi.sector_value("Tech"), 50.0);
+}
+
+TEST_F(BreadthTest, SectorMoveAndRemove) {
+    bpi.add_symbol("AAA", "Tech");
+    bpi.update("AAA", SignalType::Buy);
+    bpi.add_symbol("AAA", "Energy");
+
+    const auto sectors = bpi.sectors();
+    ASSERT_EQ(sectors.size(), 1u);
+    EXPECT_EQ(sectors[0].sector, "Energy");
+    EXPECT_EQ(sectors[0].buy_signals, 1);
+
+    EXPECT_TRUE(bpi.remove_symbol("AAA"));
+    EXPECT_FALSE(bpi.remove_symbol("AAA"));
+    EXPECT_EQ(bpi.buy_count(), 0);
+    EXPECT_TRUE(bpi.sectors().empty());
+}
+
+TEST_F(BreadthTest, UnknownSymbolIsRegistered) {
+    bpi.update("ZZZ", SignalType::Sell);
+    EXPECT_TRUE(bpi.has_symbol("ZZZ"));
+    EXPECT_EQ(bpi.signal("ZZZ"), SignalType::Sell);
+    EXPECT_DOUBLE_EQ(bpi.value(), 0.0);
+    EXPECT_TRUE(bpi.is_bearish_alert());
+}
+
+TEST_F(BreadthTest, LatestSignalMatchesDetector) {
+    ChartConfig cfg;
+    cfg.box_size_method = BoxSizeMethod::Fixed;
+    cfg.box_size = 1.0;
+    Chart chart(cfg);
+    for (const double p : {100.0, 105.0, 101.0, 107.0, 103.0, 104.0}) chart.add_data(p, now);
+
+    SignalDetector detector;
+    detector.detect(chart);
+    EXPECT_EQ(UniverseBullishPercent::latest_signal(chart), detector.current_signal());
+    EXPECT_EQ(UniverseBullishPercent::latest_signal(chart), SignalType::Buy);
+
+    bpi.update("AAA", chart);
+    EXPECT_EQ(bpi.signal("AAA"), SignalType::Buy);
+    bpi.update("BBB", detector);
+    EXPECT_EQ(bpi.buy_count(), 2);
+}
+
+TEST_F(BreadthTest, PublishBuildsChart) {
+    for (int i = 0; i < 10; i++) bpi.add_symbol("S" + std::to_string(i));
+    for (int i = 0; i < 10; i++) bpi.update("S" + std::to_string(i), SignalType::Sell);
+    bpi.publish(now);
+    for (int i = 0; i < 8; i++) bpi.update("S" + std::to_string(i), SignalType::Buy);
+    bpi.publish(now);
+
+    EXPECT_GE(bpi.chart().column_count(), 1u);
+    EXPECT_DOUBLE_EQ(bpi.chart().last_column()->highest_price(), 80.0);
+
+    bpi.clear();
+    EXPECT_EQ(bpi.symbol_count(), 0u);
+    EXPECT_EQ(bpi.chart().column_count(), 0u);
+}
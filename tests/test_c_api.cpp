@@ -39,6 +39,22 @@ TEST_F(CApiTest, CreateWithConfig) {
     pnf_chart_destroy(custom_chart);
 }
 
+TEST_F(CApiTest, CreateWithAtrBoxSize) {
+    PnfChartConfig config = pnf_chart_config_default();
+    config.method = PNF_METHOD_HIGH_LOW;
+    config.box_size_method = PNF_BOX_SIZE_ATR;
+    config.box_size = 1.0;
+
+    PnfChart* atr_chart = pnf_chart_create_atr(&config, 2, 0);
+    ASSERT_NE(atr_chart, nullptr);
+    EXPECT_FALSE(pnf_chart_add_data(atr_chart, 101.0, 99.0, 100.0, 0));
+    EXPECT_TRUE(pnf_chart_add_data(atr_chart, 102.0, 100.0, 101.0, 1000));
+    EXPECT_DOUBLE_EQ(pnf_chart_atr(atr_chart), 2.0);
+    EXPECT_DOUBLE_EQ(pnf_chart_box_size(atr_chart), 2.0);
+
+    pnf_chart_destroy(atr_chart);
+}
+
 TEST_F(CApiTest, AddDataAndGetColumnCount) {
     EXPECT_EQ(pnf_chart_column_count(chart), 0);
 
@@ -52,6 +68,21 @@ TEST_F(CApiTest, AddDataAndGetColumnCount) {
     EXPECT_TRUE(result);
 }
 
+TEST_F(CApiTest, ColumnTiming) {
+    pnf_chart_add_data(chart, 100.0, 99.0, 99.5, 1000);
+    pnf_chart_add_data(chart, 105.0, 100.0, 104.5, 2000);
+    pnf_chart_add_data(chart, 106.0, 105.0, 105.5, 3000);
+
+    ASSERT_GT(pnf_chart_column_count(chart), 0u);
+    EXPECT_EQ(pnf_chart_column_first_time(chart, 0), 1000);
+    EXPECT_EQ(pnf_chart_column_at_time(chart, 500), -1);
+    EXPECT_EQ(pnf_chart_column_at_time(chart, 3000), static_cast<int>(pnf_chart_column_count(chart)) - 1);
+    size_t bars = 0;
+    for (size_t i = 0; i < pnf_chart_column_count(chart); i++) bars += pnf_chart_column_bar_count(chart, i);
+    EXPECT_EQ(bars, 3u);
+    EXPECT_EQ(pnf_chart_column_last_time(nullptr, 0), 0);
+}
+
 TEST_F(CApiTest, GetColumnInfo) {
     pnf_chart_add_data(chart, 100.0, 99.0, 99.5, 0);
     pnf_chart_add_data(chart, 105.0, 100.0, 104.5, 1000);
@@ -347,6 +378,58 @@ TEST_F(CApiTest, CongestionDetection) {
     pnf_indicators_destroy(indicators);
 }
 
+TEST_F(CApiTest, Scanner) {
+    PnfChartConfig config = pnf_chart_config_default();
+    config.box_size_method = PNF_BOX_SIZE_FIXED;
+    config.box_size = 1.0;
+
+    PnfChart* up = pnf_chart_create(&config);
+    PnfChart* down = pnf_chart_create(&config);
+    const double up_prices[] = {100.0, 105.0, 101.0, 107.0};
+    const double down_prices[] = {100.0, 95.0, 99.0, 93.0};
+    for (int i = 0; i < 4; i++) {
+        pnf_chart_add_price(up, up_prices[i], i * 1000);
+        pnf_chart_add_price(down, down_prices[i], i * 1000);
+    }
+
+    PnfScanner* scanner = pnf_scanner_create(2);
+    ASSERT_NE(scanner, nullptr);
+    EXPECT_EQ(pnf_scanner_add(scanner, "UP", up, nullptr), 0u);
+    EXPECT_EQ(pnf_scanner_add(scanner, "DOWN", down, nullptr), 1u);
+    EXPECT_EQ(pnf_scanner_size(scanner), 2u);
+
+    const PnfPatternType wanted[] = {PNF_PATTERN_DOUBLE_TOP_BREAKOUT};
+    PnfScanQuery query = pnf_scan_query_default();
+    query.patterns = wanted;
+    query.pattern_count = 1;
+
+    const PnfScanMatchArray matches = pnf_scanner_scan(scanner, &query);
+    ASSERT_EQ(matches.length, 1u);
+    EXPECT_EQ(matches.data[0].index, 0u);
+    EXPECT_EQ(matches.data[0].pattern, PNF_PATTERN_DOUBLE_TOP_BREAKOUT);
+    pnf_free_scan_match_array(matches);
+
+    const PnfPatternType invalid[] = {static_cast<PnfPatternType>(30)};
+    query.patterns = invalid;
+    const PnfScanMatchArray rejected = pnf_scanner_scan(scanner, &query);
+    EXPECT_EQ(rejected.length, 0u);
+    EXPECT_EQ(pnf_scanner_add(scanner, "NONE", nullptr, nullptr), PNF_SCANNER_INVALID_INDEX);
+
+    const char* symbol = pnf_scanner_symbol(scanner, 1);
+    EXPECT_STREQ(symbol, "DOWN");
+    pnf_free_string(symbol);
+
+    pnf_scanner_clear(scanner);
+    EXPECT_EQ(pnf_scanner_size(scanner), 0u);
+    const PnfScanMatchArray empty = pnf_scanner_scan(scanner, nullptr);
+    EXPECT_EQ(empty.length, 0u);
+    EXPECT_EQ(empty.data, nullptr);
+
+    pnf_scanner_destroy(scanner);
+    pnf_chart_destroy(up);
+    pnf_chart_destroy(down);
+}
+
 TEST_F(CApiTest, NullSafety) {
     EXPECT_EQ(pnf_chart_column_count(nullptr), 0UL);
     EXPECT_FALSE(pnf_chart_add_data(nullptr, 100.0, 99.0, 99.5, 0));
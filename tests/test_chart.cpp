@@ -7,9 +7,74 @@
 
 #include <gtest/gtest.h>
 #include "pnf/pnf.hpp"
+#include <algorithm>
+#include <cmath>
+#include <memory_resource>
 
 using namespace pnf;
 
+namespace {
+    class CountingResource : public std::pmr::memory_resource {
+    public:
+        size_t allocated = 0;
+        size_t outstanding = 0;
+
+    private:
+        void* do_allocate(const size_t bytes, const size_t align) override {
+            allocated += bytes;
+            outstanding += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, align);
+        }
+
+        void do_deallocate(void* p, const size_t bytes, const size_t align) override {
+            outstanding -= bytes;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+        }
+
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+    void expect_same_chart(const Chart& a, const Chart& b) {
+        ASSERT_EQ(a.column_count(), b.column_count());
+        for (size_t i = 0; i < a.column_count(); i++) {
+            const Column* ca = a.column(i);
+            const Column* cb = b.column(i);
+            EXPECT_EQ(ca->type(), cb->type()) << "column " << i;
+            EXPECT_EQ(ca->box_count(), cb->box_count()) << "column " << i;
+            EXPECT_DOUBLE_EQ(ca->highest_price(), cb->highest_price()) << "column " << i;
+            EXPECT_DOUBLE_EQ(ca->lowest_price(), cb->lowest_price()) << "column " << i;
+            EXPECT_EQ(ca->bar_count(), cb->bar_count()) << "column " << i;
+            EXPECT_EQ(a.previous_same_type(i), b.previous_same_type(i)) << "column " << i;
+        }
+        EXPECT_TRUE(std::ranges::equal(a.column_highs(), b.column_highs()));
+        EXPECT_TRUE(std::ranges::equal(a.column_lows(), b.column_lows()));
+        EXPECT_TRUE(std::ranges::equal(a.column_midpoints(), b.column_midpoints()));
+        EXPECT_TRUE(std::ranges::equal(a.x_column_indices(), b.x_column_indices()));
+        EXPECT_TRUE(std::ranges::equal(a.o_column_indices(), b.o_column_indices()));
+        EXPECT_TRUE(std::ranges::equal(a.mixed_column_indices(), b.mixed_column_indices()));
+        EXPECT_TRUE(std::ranges::equal(a.price_ladder(), b.price_ladder()));
+        EXPECT_TRUE(std::ranges::equal(a.column_start_times(), b.column_start_times()));
+        EXPECT_DOUBLE_EQ(a.current_box_size(), b.current_box_size());
+
+        const TrendLineManager* ta = a.trend_line_manager();
+        const TrendLineManager* tb = b.trend_line_manager();
+        ASSERT_EQ(ta->all_trend_lines().size(), tb->all_trend_lines().size());
+        EXPECT_EQ(ta->events().size(), tb->events().size());
+        for (size_t i = 0; i < ta->all_trend_lines().size(); i++) {
+            const TrendLine& la = *ta->all_trend_lines()[i];
+            const TrendLine& lb = *tb->all_trend_lines()[i];
+            EXPECT_EQ(la.type(), lb.type());
+            EXPECT_EQ(la.is_active(), lb.is_active());
+            EXPECT_EQ(la.touch_count(), lb.touch_count());
+            EXPECT_EQ(la.break_column(), lb.break_column());
+        }
+        EXPECT_EQ(a.has_bullish_bias(), b.has_bullish_bias());
+        EXPECT_EQ(a.has_bearish_bias(), b.has_bearish_bias());
+    }
+}
+
 class ChartTest : public ::testing::Test {
 protected:
     Chart chart;
@@ -116,4 +181,488 @@ TEST_F(ChartTest, ToString) {
     std::string str = chart.to_string();
     EXPECT_FALSE(str.empty());
     EXPECT_NE(str.find("Point & Figure"), std::string::npos);
-}
\ No newline at end of file
+}
+TEST_F(ChartTest, AtrBoxSizeWaitsForSeed) {
+    ChartConfig cfg;
+    cfg.method = ConstructionMethod::HighLow;
+    cfg.box_size_method = BoxSizeMethod::ATR;
+    cfg.box_size = 1.0;
+    cfg.atr_period = 3;
+    Chart c(cfg);
+
+    EXPECT_FALSE(c.add_data(101.0, 99.0, 100.0, now));
+    EXPECT_FALSE(c.add_data(102.0, 100.0, 101.0, now));
+    EXPECT_EQ(c.column_count(), 0u);
+    EXPECT_DOUBLE_EQ(c.atr(), 0.0);
+
+    EXPECT_TRUE(c.add_data(103.0, 101.0, 102.0, now));
+    EXPECT_DOUBLE_EQ(c.atr(), 2.0);
+    EXPECT_DOUBLE_EQ(c.current_box_size(), 2.0);
+    EXPECT_GT(c.column_count(), 0u);
+
+    // Wilder smoothing: (2 * 2 + 5) / 3
+    c.add_data(107.0, 102.0, 106.0, now);
+    EXPECT_DOUBLE_EQ(c.atr(), 3.0);
+    EXPECT_DOUBLE_EQ(c.current_box_size(), 2.0);
+}
+
+TEST_F(ChartTest, AtrSeedMatchesFixedChart) {
+    ChartConfig cfg;
+    cfg.box_size_method = BoxSizeMethod::ATR;
+    cfg.box_size = 0.5;
+    cfg.atr_period = 10;
+    Chart atr_chart(cfg);
+
+    std::vector<OHLC> bars;
+    for (int i = 0; i < 300; i++) {
+        const double c = 100.0 + 10.0 * std::sin(i * 0.08) + (i % 7) * 0.3;
+        bars.push_back({now + std::chrono::hours(i), c, c + 1.0, c - 1.0, c, 0.0});
+        atr_chart.add_ohlc(bars.back());
+    }
+
+    ChartConfig fixed_cfg;
+    fixed_cfg.box_size_method = BoxSizeMethod::Fixed;
+    fixed_cfg.box_size = atr_chart.current_box_size();
+    Chart fixed(fixed_cfg);
+    for (const auto& bar : bars) fixed.add_ohlc(bar);
+
+    ASSERT_EQ(atr_chart.column_count(), fixed.column_count());
+    for (size_t i = 0; i < fixed.column_count(); i++) {
+        EXPECT_EQ(atr_chart.column(i)->type(), fixed.column(i)->type());
+        EXPECT_DOUBLE_EQ(atr_chart.column(i)->highest_price(), fixed.column(i)->highest_price());
+        EXPECT_DOUBLE_EQ(atr_chart.column(i)->lowest_price(), fixed.column(i)->lowest_price());
+    }
+
+    atr_chart.clear();
+    EXPECT_EQ(atr_chart.column_count(), 0u);
+    EXPECT_DOUBLE_EQ(atr_chart.atr(), 0.0);
+}
+
+TEST_F(ChartTest, AtrRefreshRedrawsSincePreviousRefresh) {
+    ChartConfig cfg;
+    cfg.box_size_method = BoxSizeMethod::ATR;
+    cfg.box_size = 0.5;
+    cfg.atr_period = 10;
+    cfg.atr_refresh = 25;
+    Chart c(cfg);
+
+    struct Extent {
+        double high, low, box;
+    };
+    size_t base_columns = 0;
+    int redraws = 0;
+    for (int i = 0; i < 600; i++) {
+        std::vector<Extent> before;
+        for (size_t j = 0; j < c.column_count(); j++) {
+            before.push_back({c.column(j)->highest_price(), c.column(j)->lowest_price(), c.column(j)->box_size()});
+        }
+        const std::uint64_t rebuilds = c.rebuild_count();
+        const double c0 = 100.0 + 10.0 * std::sin(i * 0.05) * (1.0 + i / 150.0);
+        c.add_data(c0 + 1.0, c0 - 1.0, c0, now + std::chrono::hours(i));
+
+        const bool tick = i >= cfg.atr_period - 1 && (i - cfg.atr_period + 1) % cfg.atr_refresh == 0;
+        if (i >= cfg.atr_period && c.rebuild_count() > rebuilds) {
+            ASSERT_TRUE(tick) << "bar " << i;
+            redraws++;
+            for (size_t j = 0; j + 1 < base_columns; j++) {
+                EXPECT_DOUBLE_EQ(c.column(j)->highest_price(), before[j].high) << "bar " << i << " column " << j;
+                EXPECT_DOUBLE_EQ(c.column(j)->lowest_price(), before[j].low) << "bar " << i << " column " << j;
+                EXPECT_DOUBLE_EQ(c.column(j)->box_size(), before[j].box) << "bar " << i << " column " << j;
+            }
+            for (size_t j = base_columns; j < c.column_count(); j++) {
+                EXPECT_DOUBLE_EQ(c.column(j)->box_size(), c.current_box_size()) << "bar " << i << " column " << j;
+            }
+        }
+        if (tick) base_columns = c.column_count();
+    }
+    EXPECT_GT(redraws, 0);
+}
+
+TEST_F(ChartTest, TraditionalBoxSizeLookup) {
+    EXPECT_DOUBLE_EQ(Chart::traditional_box_size(0.1), 0.0625);
+    EXPECT_DOUBLE_EQ(Chart::traditional_box_size(0.25), 0.125);
+    EXPECT_DOUBLE_EQ(Chart::traditional_box_size(19.99), 0.5);
+    EXPECT_DOUBLE_EQ(Chart::traditional_box_size(20.0), 1.0);
+    EXPECT_DOUBLE_EQ(Chart::traditional_box_size(150.0), 2.0);
+    EXPECT_DOUBLE_EQ(Chart::traditional_box_size(5000.0), 50.0);
+    EXPECT_DOUBLE_EQ(Chart::traditional_box_size(30000.0), 500.0);
+}
+
+TEST_F(ChartTest, TraditionalKeepsConfigAndRecordsColumnBoxSize) {
+    ChartConfig cfg;
+    cfg.box_size_method = BoxSizeMethod::Traditional;
+    cfg.reversal = 3;
+    Chart c(cfg);
+
+    for (const double p : {90.0, 99.0, 95.0, 120.0, 150.0, 130.0, 96.0, 80.0}) c.add_data(p, now);
+
+    EXPECT_DOUBLE_EQ(c.config().box_size, 0.0);
+    ASSERT_GE(c.column_count(), 3u);
+    EXPECT_DOUBLE_EQ(c.column(0)->box_size(), 1.0);
+    for (size_t i = 0; i < c.column_count(); i++) {
+        EXPECT_GT(c.column(i)->box_size(), 0.0);
+    }
+    EXPECT_DOUBLE_EQ(c.current_box_size(), Chart::traditional_box_size(80.0));
+}
+
+TEST_F(ChartTest, TrendLinesKeepTheirBoxSize) {
+    ChartConfig cfg;
+    cfg.box_size_method = BoxSizeMethod::Traditional;
+    Chart c(cfg);
+
+    for (int i = 0; i < 200; i++) {
+        const double p = 60.0 + 80.0 * std::abs(std::sin(i * 0.07)) + 6.0 * std::sin(i * 0.9);
+        c.add_data(p, now + std::chrono::hours(i));
+    }
+
+    const TrendLineManager* tm = c.trend_line_manager();
+    EXPECT_FALSE(tm->all_trend_lines().empty());
+    for (const auto& line : tm->all_trend_lines()) {
+        // Internal and channel lines are parallel to their primary line instead.
+        if (line->family() != TrendLineFamily::Primary) continue;
+        const Column* anchor = c.column(line->start_point().column_index);
+        ASSERT_NE(anchor, nullptr);
+        EXPECT_DOUBLE_EQ(line->box_size(), anchor->box_size());
+    }
+}
+
+TEST_F(ChartTest, StorageUsesMemoryResource) {
+    ChartConfig cfg;
+    cfg.box_size_method = BoxSizeMethod::Fixed;
+    cfg.box_size = 1.0;
+
+    CountingResource counting;
+    Chart reference(cfg);
+    {
+        Chart c(cfg, &counting);
+        EXPECT_EQ(c.memory_resource(), &counting);
+        for (int i = 0; i < 500; i++) {
+            const double p = 100.0 + 20.0 * std::sin(i * 0.05);
+            c.add_data(p, now);
+            reference.add_data(p, now);
+        }
+        ASSERT_GT(c.column_count(), 3u);
+        EXPECT_GT(counting.allocated, 0u);
+        for (size_t i = 0; i < c.column_count(); i++) {
+            EXPECT_EQ(c.column(i)->get_allocator().resource(), &counting);
+            EXPECT_EQ(c.column(i)->box_count(), reference.column(i)->box_count());
+        }
+        const TrendLineManager* tm = c.trend_line_manager();
+        ASSERT_FALSE(tm->all_trend_lines().empty());
+        EXPECT_EQ(tm->all_trend_lines().get_allocator().resource(), &counting);
+        EXPECT_EQ(tm->all_trend_lines().front().get_deleter().resource, &counting);
+        EXPECT_EQ(tm->events().get_allocator().resource(), &counting);
+        EXPECT_EQ(tm->history().get_allocator().resource(), &counting);
+        EXPECT_EQ(tm->significant_lows().get_allocator().resource(), &counting);
+    }
+    EXPECT_EQ(counting.outstanding, 0u);
+
+    // A monotonic arena releases the whole chart at once.
+    std::pmr::monotonic_buffer_resource arena;
+    Chart arena_chart(cfg, &arena);
+    for (int i = 0; i < 500; i++) arena_chart.add_data(100.0 + 20.0 * std::sin(i * 0.05), now);
+    EXPECT_EQ(arena_chart.column_count(), reference.column_count());
+    EXPECT_EQ(Chart(cfg, nullptr).memory_resource(), std::pmr::get_default_resource());
+}
+
+TEST_F(ChartTest, CompactColumnsMatchFullStorage) {
+    ChartConfig cfg;
+    cfg.box_size_method = BoxSizeMethod::Fixed;
+    cfg.box_size = 0.1;
+    ChartConfig compact_cfg = cfg;
+    compact_cfg.compact_columns = true;
+
+    CountingResource full_bytes;
+    CountingResource compact_bytes;
+    Chart full(cfg, &full_bytes);
+    Chart compact(compact_cfg, &compact_bytes);
+    for (int i = 0; i < 2000; i++) {
+        const double p = 10.0 + 2.0 * std::sin(i * 0.01) + 0.6 * std::sin(i * 0.13);
+        full.add_data(p, now + std::chrono::hours(6 * i));
+        compact.add_data(p, now + std::chrono::hours(6 * i));
+    }
+
+    ASSERT_EQ(compact.column_count(), full.column_count());
+    ASSERT_GT(compact.column_count(), 20u);
+    size_t compacted = 0;
+    for (size_t i = 0; i < full.column_count(); i++) {
+        const Column* a = full.column(i);
+        const Column* b = compact.column(i);
+        if (b->is_compact()) ++compacted;
+        ASSERT_EQ(a->box_count(), b->box_count());
+        for (size_t j = 0; j < a->box_count(); j++) {
+            EXPECT_EQ(a->box_at(j).price(), b->box_at(j).price());
+            EXPECT_EQ(a->box_at(j).marker(), b->box_at(j).marker());
+        }
+    }
+    EXPECT_FALSE(compact.last_column()->is_compact());
+    EXPECT_EQ(compacted, compact.column_count() - 1);
+    EXPECT_LT(compact_bytes.outstanding, full_bytes.outstanding);
+    EXPECT_EQ(compact.all_prices(), full.all_prices());
+    EXPECT_EQ(compact.has_bullish_bias(), full.has_bullish_bias());
+}
+
+TEST_F(ChartTest, ColumnArraysTrackColumns) {
+    ChartConfig cfg;
+    cfg.box_size_method = BoxSizeMethod::ATR;
+    cfg.box_size = 1.0;
+    cfg.atr_period = 10;
+    cfg.atr_refresh = 25;
+    cfg.compact_columns = true;
+    Chart c(cfg);
+
+    const auto matches = [&c] {
+        if (c.column_highs().size() != c.column_count()) return false;
+        for (size_t i = 0; i < c.column_count(); i++) {
+            const Column* col = c.column(i);
+            if (c.column_highs()[i] != col->highest_price() || c.column_lows()[i] != col->lowest_price() ||
+                c.column_midpoints()[i] != (col->highest_price() + col->lowest_price()) / 2.0)
+                return false;
+        }
+        return true;
+    };
+
+    for (int i = 0; i < 400; i++) {
+        const double p = 100.0 + 15.0 * std::sin(i * 0.04) + 3.0 * std::sin(i * 0.5);
+        c.add_data(p + 1.0, p - 1.0, p, now + std::chrono::hours(i));
+        ASSERT_TRUE(matches()) << "bar " << i;
+    }
+    ASSERT_GT(c.column_count(), 5u);
+
+    double high = c.column(0)->highest_price();
+    double low = c.column(0)->lowest_price();
+    for (size_t i = 1; i < c.column_count(); i++) {
+        high = std::max(high, c.column(i)->highest_price());
+        low = std::min(low, c.column(i)->lowest_price());
+    }
+    EXPECT_EQ(c.highest_price(), high);
+    EXPECT_EQ(c.lowest_price(), low);
+
+    c.column(0)->add_box(c.highest_price() + 50.0, BoxType::X);
+    c.refresh_column_extremes();
+    EXPECT_TRUE(matches());
+
+    c.clear();
+    EXPECT_TRUE(c.column_midpoints().empty());
+    EXPECT_EQ(c.highest_price(), 0.0);
+}
+
+TEST_F(ChartTest, PriceLadderMatchesBoxScan) {
+    ChartConfig atr;
+    atr.box_size_method = BoxSizeMethod::ATR;
+    atr.box_size = 0.5;
+    atr.atr_period = 10;
+    atr.atr_refresh = 40;
+    ChartConfig fixed;
+    fixed.box_size_method = BoxSizeMethod::Fixed;
+    fixed.box_size = 0.5;
+    ChartConfig log;
+    log.box_size_method = BoxSizeMethod::Logarithmic;
+    log.box_size = 0.5;
+
+    for (const ChartConfig& cfg : {atr, fixed, log}) {
+        Chart c(cfg);
+        const auto scan = [&c] {
+            std::vector<double> prices;
+            for (size_t i = 0; i < c.column_count(); i++) {
+                const Column* col = c.column(i);
+                for (size_t j = 0; j < col->box_count(); j++) {
+                    const double price = col->box_at(j).price();
+                    if (std::ranges::none_of(prices, [price](const double p) { return std::abs(p - price) < 0.00001; }))
+                        prices.push_back(price);
+                }
+            }
+            std::ranges::sort(prices, std::greater<>());
+            return prices;
+        };
+
+        for (int i = 0; i < 300; i++) {
+            const double p = 100.0 + 15.0 * std::sin(i * 0.04) + 3.0 * std::sin(i * 0.5) + i * 0.05;
+            c.add_data(p + 1.0, p - 1.0, p, now + std::chrono::hours(i));
+            ASSERT_EQ(c.all_prices(), scan()) << "bar " << i;
+        }
+
+        const auto ladder = c.price_ladder();
+        ASSERT_FALSE(ladder.empty());
+        EXPECT_TRUE(std::ranges::is_sorted(ladder, std::greater<>()));
+        for (size_t r = 0; r < ladder.size(); r++) {
+            EXPECT_EQ(c.price_row(ladder[r]), static_cast<int>(r));
+        }
+        EXPECT_EQ(c.price_row(ladder.front() + 1000.0), -1);
+        EXPECT_EQ(c.price_row(ladder.back() - 0.2), -1);
+        EXPECT_EQ(c.price_row(ladder.front() - 0.2), -1);
+
+        c.clear();
+        EXPECT_TRUE(c.price_ladder().empty());
+    }
+}
+
+TEST_F(ChartTest, TypeIndexesTrackColumns) {
+    ChartConfig cfg;
+    cfg.box_size_method = BoxSizeMethod::ATR;
+    cfg.box_size = 0.5;
+    cfg.atr_period = 10;
+    cfg.atr_refresh = 40;
+    cfg.reversal = 1;
+    Chart c(cfg);
+
+    const auto matches = [&c] {
+        std::vector<size_t> x, o, mixed;
+        for (size_t i = 0; i < c.column_count(); i++) {
+            const ColumnType type = c.column(i)->type();
+            auto& list = type == ColumnType::X ? x : type == ColumnType::O ? o : mixed;
+            const int expected = list.empty() ? -1 : static_cast<int>(list.back());
+            if (c.previous_same_type(i) != expected) return false;
+            list.push_back(i);
+        }
+        return std::ranges::equal(c.x_column_indices(), x) && std::ranges::equal(c.o_column_indices(), o) &&
+               std::ranges::equal(c.mixed_column_indices(), mixed) && c.x_column_count() == x.size() &&
+               c.o_column_count() == o.size() && c.mixed_column_count() == mixed.size();
+    };
+
+    for (int i = 0; i < 300; i++) {
+        const double p = 100.0 + 15.0 * std::sin(i * 0.04) + 3.0 * std::sin(i * 0.5);
+        c.add_data(p + 1.0, p - 1.0, p, now + std::chrono::hours(i));
+        ASSERT_TRUE(matches()) << "bar " << i;
+    }
+    EXPECT_GT(c.mixed_column_count(), 0u);
+    EXPECT_EQ(c.previous_same_type(c.column_count()), -1);
+
+    c.clear();
+    EXPECT_EQ(c.x_column_count(), 0u);
+    EXPECT_TRUE(c.o_column_indices().empty());
+}
+
+TEST_F(ChartTest, ColumnTimesIndexBars) {
+    ChartConfig cfg;
+    cfg.box_size_method = BoxSizeMethod::Fixed;
+    cfg.box_size = 1.0;
+    cfg.reversal = 3;
+    Chart c(cfg);
+
+    std::vector<Timestamp> times;
+    std::vector<int> owner;
+    for (int i = 0; i < 500; i++) {
+        const double p = 100.0 + 15.0 * std::sin(i * 0.04) + 3.0 * std::sin(i * 0.5);
+        times.push_back(now + std::chrono::hours(i));
+        c.add_data(p + 1.0, p - 1.0, p, times.back());
+        owner.push_back(static_cast<int>(c.column_count()) - 1);
+    }
+    ASSERT_GT(c.column_count(), 5u);
+    ASSERT_EQ(c.column_start_times().size(), c.column_count());
+
+    size_t bars = 0;
+    for (size_t i = 0; i < c.column_count(); i++) {
+        const Column* col = c.column(i);
+        bars += col->bar_count();
+        EXPECT_LE(col->first_time(), col->last_time());
+        EXPECT_EQ(c.column_start_times()[i], col->first_time());
+    }
+    EXPECT_EQ(bars, times.size());
+    for (size_t i = 0; i < times.size(); i++) {
+        EXPECT_EQ(c.column_at(times[i]), owner[i]) << "bar " << i;
+    }
+    EXPECT_EQ(c.column_at(now - std::chrono::hours(1)), -1);
+    EXPECT_EQ(c.column(0)->first_time(), times.front());
+    EXPECT_EQ(c.last_column()->last_time(), times.back());
+}
+
+TEST_F(ChartTest, AsOfMatchesRebuild) {
+    ChartConfig fixed;
+    fixed.box_size_method = BoxSizeMethod::Fixed;
+    fixed.box_size = 1.0;
+    ChartConfig high_low;
+    high_low.method = ConstructionMethod::HighLow;
+    ChartConfig atr;
+    atr.box_size_method = BoxSizeMethod::ATR;
+    atr.box_size = 1.5;
+    atr.atr_refresh = 120;
+
+    for (ChartConfig cfg : {fixed, high_low, atr}) {
+        cfg.checkpoint_interval = 50;
+        Chart c(cfg);
+        std::vector<Timestamp> times;
+        for (int i = 0; i < 600; i++) {
+            const double p = 100.0 + 20.0 * std::sin(i * 0.03) + 4.0 * std::sin(i * 0.41);
+            times.push_back(now + std::chrono::hours(i));
+            c.add_data(p + 1.5, p - 1.5, p, times.back());
+        }
+        EXPECT_EQ(c.bar_log_size(), 600u);
+        ASSERT_GT(c.checkpoint_count(), 0u);
+
+        for (const int cut : {0, 37, 250, 333, 599}) {
+            cfg.checkpoint_interval = 0;
+            Chart reference(cfg);
+            for (int i = 0; i <= cut; i++) {
+                const double p = 100.0 + 20.0 * std::sin(i * 0.03) + 4.0 * std::sin(i * 0.41);
+                reference.add_data(p + 1.5, p - 1.5, p, times[i]);
+            }
+            const Chart view = c.as_of(times[cut]);
+            expect_same_chart(view, reference);
+            EXPECT_EQ(view.bar_log_size(), static_cast<size_t>(cut) + 1);
+            if (cfg.box_size_method != BoxSizeMethod::ATR) {
+                EXPECT_LT(view.replayed_bars(), 50u);
+            }
+        }
+        EXPECT_EQ(c.as_of(now - std::chrono::hours(1)).column_count(), 0u);
+    }
+}
+
+TEST_F(ChartTest, SpliceReplaysFromCheckpoint) {
+    ChartConfig cfg;
+    cfg.box_size_method = BoxSizeMethod::Fixed;
+    cfg.box_size = 1.0;
+    cfg.checkpoint_interval = 40;
+    const auto price = [](const int i) { return 100.0 + 20.0 * std::sin(i * 0.03) + 4.0 * std::sin(i * 0.41); };
+
+    Chart c(cfg);
+    for (int i = 0; i < 500; i++) {
+        if (i != 430) c.add_data(price(i), now + std::chrono::hours(i));
+    }
+    const std::uint64_t rebuilds = c.rebuild_count();
+    // The late bar is logged and replayed but lands inside boxes already drawn.
+    EXPECT_FALSE(c.splice_data(price(430), price(430), price(430), now + std::chrono::hours(430)));
+    EXPECT_GT(c.rebuild_count(), rebuilds);
+    EXPECT_EQ(c.bar_log_size(), 500u);
+    EXPECT_LE(c.replayed_bars(), 500u - 430u + 40u);
+
+    // Correct an earlier bar in place.
+    EXPECT_TRUE(c.splice_data(price(300) + 9.0, price(300) + 9.0, price(300) + 9.0, now + std::chrono::hours(300)));
+    EXPECT_EQ(c.bar_log_size(), 500u);
+    // Replacing a bar with itself leaves every column as it was.
+    EXPECT_FALSE(c.splice_data(price(200), price(200), price(200), now + std::chrono::hours(200)));
+
+    Chart reference(ChartConfig{cfg.method, cfg.box_size_method, cfg.box_size, cfg.reversal});
+    for (int i = 0; i < 500; i++) {
+        reference.add_data(price(i) + (i == 300 ? 9.0 : 0.0), now + std::chrono::hours(i));
+    }
+    expect_same_chart(c, reference);
+
+    Chart plain(ChartConfig{cfg.method, cfg.box_size_method, cfg.box_size, cfg.reversal});
+    plain.add_data(100.0, now);
+    EXPECT_FALSE(plain.splice_data(101.0, 101.0, 101.0, now));
+}
+
+TEST_F(ChartTest, SpliceLeavesEarlierColumnsAlone) {
+    ChartConfig cfg;
+    cfg.box_size_method = BoxSizeMethod::Fixed;
+    cfg.box_size = 1.0;
+    cfg.checkpoint_interval = 40;
+    const auto price = [](const int i) { return 100.0 + 20.0 * std::sin(i * 0.03) + 4.0 * std::sin(i * 0.41); };
+
+    Chart c(cfg);
+    for (int i = 0; i < 500; i++) {
+        if (i != 470) c.add_data(price(i), now + std::chrono::hours(i));
+    }
+    ASSERT_GT(c.column_count(), 3u);
+
+    // Re-indexing column 0 would pick up this box; a splice near the end must not visit it.
+    const double cached = c.column_highs()[0];
+    c.column(0)->add_box(cached + 50.0, BoxType::X);
+    c.splice_data(price(470), price(470), price(470), now + std::chrono::hours(470));
+    EXPECT_EQ(c.column_highs()[0], cached);
+    EXPECT_EQ(c.price_row(cached + 50.0), -1);
+
+    c.refresh_column_extremes();
+    EXPECT_EQ(c.column_highs()[0], cached + 50.0);
+}
@@ -0,0 +1,107 @@
+/// \file test_chart_family.cpp
+/// \brief Test chart family implementation.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include "pnf/pnf.hpp"
+#include <cmath>
+
+using namespace pnf;
+
+class ChartFamilyTest : public ::testing::Test {
+protected:
+    static std::vector<OHLC> bars(const Timestamp start, const int count) {
+        std::vector<OHLC> result;
+        for (int i = 0; i < count; i++) {
+            const double c = 100.0 + 15.0 * std::sin(i * 0.05) + 4.0 * std::sin(i * 0.37);
+            result.push_back({start + std::chrono::hours(24 * i), c, c + 1.5, c - 1.5, c, 0.0});
+        }
+        return result;
+    }
+
+    static std::vector<ChartConfig> configs() {
+        std::vector<ChartConfig> result;
+        for (const auto method : {ConstructionMethod::Close, ConstructionMethod::HighLow}) {
+            for (const int reversal : {1, 2, 3}) {
+                for (const double box : {0.5, 1.0, 2.0}) {
+                    result.push_back({method, BoxSizeMethod::Fixed, box, reversal});
+                }
+                result.push_back({method, BoxSizeMethod::Percentage, 1.0, reversal});
+                result.push_back({method, BoxSizeMethod::Traditional, 0.0, reversal});
+            }
+        }
+        return result;
+    }
+
+    static void expect_same(const Chart& a, const Chart& b) {
+        ASSERT_EQ(a.column_count(), b.column_count());
+        for (size_t c = 0; c < a.column_count(); c++) {
+            const Column* ca = a.column(c);
+            const Column* cb = b.column(c);
+            ASSERT_EQ(ca->type(), cb->type());
+            ASSERT_EQ(ca->box_count(), cb->box_count());
+            EXPECT_EQ(ca->bar_count(), cb->bar_count());
+            EXPECT_EQ(ca->first_time(), cb->first_time());
+            EXPECT_EQ(ca->last_time(), cb->last_time());
+            for (size_t k = 0; k < ca->box_count(); k++) {
+                EXPECT_DOUBLE_EQ(ca->get_box_at(k)->price(), cb->get_box_at(k)->price());
+                EXPECT_EQ(ca->get_box_at(k)->marker(), cb->get_box_at(k)->marker());
+            }
+        }
+        EXPECT_DOUBLE_EQ(a.current_box_size(), b.current_box_size());
+        EXPECT_EQ(a.has_bullish_bias(), b.has_bullish_bias());
+        EXPECT_EQ(a.has_bearish_bias(), b.has_bearish_bias());
+    }
+
+    Timestamp start = std::chrono::system_clock::now() - std::chrono::hours(24 * 800);
+};
+
+TEST_F(ChartFamilyTest, MatchesSeparateCharts) {
+    const auto data = bars(start, 700);
+    const auto cfgs = configs();
+
+    ChartFamily family(cfgs);
+    std::vector<Chart> separate;
+    for (const auto& cfg : cfgs) separate.emplace_back(cfg);
+
+    for (const auto& bar : data) {
+        const size_t updated = family.add_ohlc(bar);
+        size_t expected = 0;
+        for (size_t i = 0; i < separate.size(); i++) {
+            const bool c = separate[i].add_ohlc(bar);
+            EXPECT_EQ(family.changed(i), c);
+            if (c) expected++;
+        }
+        EXPECT_EQ(updated, expected);
+    }
+
+    ASSERT_EQ(family.size(), cfgs.size());
+    for (size_t i = 0; i < cfgs.size(); i++) {
+        SCOPED_TRACE(i);
+        expect_same(family.chart(i), separate[i]);
+    }
+    EXPECT_GT(family.quiet_updates(), 0u);
+}
+
+TEST_F(ChartFamilyTest, AddAndClear) {
+    ChartFamily family;
+    EXPECT_EQ(family.size(), 0u);
+    EXPECT_EQ(family.add({ConstructionMethod::Close, BoxSizeMethod::Fixed, 1.0, 3}), 0u);
+    EXPECT_EQ(family.add({ConstructionMethod::Close, BoxSizeMethod::Fixed, 2.0, 1}), 1u);
+
+    for (const auto& bar : bars(start, 100)) family.add_ohlc(bar);
+    EXPECT_GT(family.chart(0).column_count(), 0u);
+
+    family.clear();
+    EXPECT_EQ(family.chart(0).column_count(), 0u);
+    EXPECT_EQ(family.chart(1).column_count(), 0u);
+    EXPECT_EQ(family.quiet_updates(), 0u);
+    EXPECT_DOUBLE_EQ(family.config(1).box_size, 2.0);
+
+    EXPECT_EQ(family.add_data(50.0, start), 2u);
+    EXPECT_EQ(family.add_data(49.6, start + std::chrono::hours(24)), 0u);
+    EXPECT_EQ(family.quiet_updates(), 2u);
+}
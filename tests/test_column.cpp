@@ -73,4 +73,84 @@ TEST(ColumnTest, GetBoxAt) {
     Box* box = col.get_box_at(0);
     ASSERT_NE(box, nullptr);
     EXPECT_DOUBLE_EQ(box->price(), 100.0);
-}
\ No newline at end of file
+}
+TEST(ColumnTest, CompactRoundTrip) {
+    Column col(ColumnType::O);
+    col.set_box_size(0.1);
+    double price = 10.0;
+    for (int i = 0; i < 12; i++) {
+        if (i == 4) col.add_box(price, BoxType::O, MarkerTable::month(3));
+        else col.add_box(price, BoxType::O);
+        price = price + -1 * 0.1;
+    }
+    const Column full = col;
+
+    ASSERT_TRUE(col.compact());
+    EXPECT_TRUE(col.is_compact());
+    EXPECT_EQ(col.box_count(), full.box_count());
+    EXPECT_EQ(col.highest_price(), full.highest_price());
+    EXPECT_EQ(col.lowest_price(), full.lowest_price());
+    for (size_t i = 0; i < full.box_count(); i++) {
+        EXPECT_EQ(col.box_at(i).price(), full.box_at(i).price());
+        EXPECT_EQ(col.box_at(i).type(), BoxType::O);
+        EXPECT_EQ(col.box_at(i).marker_id(), full.box_at(i).marker_id());
+        EXPECT_TRUE(col.has_box(full.box_at(i).price()));
+    }
+    EXPECT_EQ(col.get_box_marker(full.box_at(4).price()), MarkerTable::name(MarkerTable::month(3)));
+    const Column& view = col;
+    EXPECT_EQ(view.get_box_at(0), nullptr);
+    EXPECT_EQ(view.get_box(full.box_at(0).price()), nullptr);
+    EXPECT_EQ(col.to_string(), full.to_string());
+    EXPECT_FALSE(col.has_box(10.05));
+
+    // Mutation restores full storage.
+    EXPECT_TRUE(col.add_box(price, BoxType::O));
+    EXPECT_FALSE(col.is_compact());
+    EXPECT_EQ(col.box_count(), full.box_count() + 1);
+    EXPECT_EQ(col.box_at(4).marker_id(), MarkerTable::month(3));
+}
+
+TEST(ColumnTest, CompactTallColumnMatchesFullStorage) {
+    // Long enough to span several anchor blocks in both directions.
+    for (const double step : {0.1, -0.1}) {
+        Column col(step > 0.0 ? ColumnType::X : ColumnType::O);
+        col.set_box_size(0.1);
+        const BoxType type = step > 0.0 ? BoxType::X : BoxType::O;
+        double price = 50.0;
+        for (int i = 0; i < 100; i++) {
+            if (i == 70) col.add_box(price, type, MarkerTable::month(7));
+            else col.add_box(price, type);
+            price = price + step;
+        }
+        const Column full = col;
+
+        ASSERT_TRUE(col.compact());
+        EXPECT_EQ(col.highest_price(), full.highest_price());
+        EXPECT_EQ(col.lowest_price(), full.lowest_price());
+        for (size_t i = 0; i < full.box_count(); i++) {
+            const double expected = full.box_at(i).price();
+            EXPECT_EQ(col.box_at(i).price(), expected) << i;
+            EXPECT_TRUE(col.has_box(expected)) << i;
+            EXPECT_FALSE(col.has_box(expected + step / 2)) << i;
+        }
+        EXPECT_EQ(col.get_box_marker(full.box_at(70).price()), MarkerTable::name(MarkerTable::month(7)));
+        EXPECT_FALSE(col.has_box(price));
+        EXPECT_EQ(col.to_string(), full.to_string());
+    }
+}
+
+TEST(ColumnTest, CompactRejectsIrregularColumns) {
+    Column mixed(ColumnType::Mixed);
+    mixed.add_box(1.0, BoxType::X);
+    mixed.add_box(2.0, BoxType::O);
+    EXPECT_FALSE(mixed.compact());
+
+    Column gapped(ColumnType::X);
+    gapped.set_box_size(1.0);
+    gapped.add_box(1.0, BoxType::X);
+    gapped.add_box(2.0, BoxType::X);
+    gapped.add_box(4.0, BoxType::X);
+    EXPECT_FALSE(gapped.compact());
+    EXPECT_EQ(gapped.box_count(), 3u);
+    EXPECT_FALSE(Column().compact());
+}
@@ -7,6 +7,9 @@
 
 #include <gtest/gtest.h>
 #include "pnf/pnf.hpp"
+#include <algorithm>
+#include <cmath>
+#include <memory_resource>
 
 using namespace pnf;
 
@@ -146,4 +149,183 @@ TEST(TypesTest, PatternClassification) {
     EXPECT_TRUE(is_bearish_pattern(PatternType::DoubleBottomBreakdown));
     EXPECT_FALSE(is_bullish_pattern(PatternType::None));
     EXPECT_FALSE(is_bearish_pattern(PatternType::None));
-}
\ No newline at end of file
+}
+
+TEST_F(IndicatorTest, SignalAtMatchesDetect) {
+    SignalDetector detector;
+    detector.detect(chart);
+    for (const auto& s : detector.signals()) {
+        EXPECT_EQ(SignalDetector::signal_at(chart, s.column_index), s.type);
+    }
+    EXPECT_EQ(SignalDetector::signal_at(chart, 0), SignalType::None);
+}
+
+TEST_F(IndicatorTest, DetectColumnMatchesDetect) {
+    PatternRecognizer full;
+    full.detect(chart);
+
+    PatternRecognizer incremental;
+    int total = 0;
+    for (size_t i = 0; i < chart.column_count(); i++) {
+        total += incremental.detect_column(chart, static_cast<int>(i));
+    }
+    EXPECT_EQ(total, full.pattern_count());
+    EXPECT_EQ(incremental.pattern_count(), full.pattern_count());
+
+    incremental.clear();
+    EXPECT_EQ(incremental.pattern_count(), 0);
+}
+
+TEST_F(IndicatorTest, ResultsUseMemoryResource) {
+    std::pmr::monotonic_buffer_resource arena;
+    Indicators arena_indicators(IndicatorConfig{}, &arena);
+    EXPECT_EQ(arena_indicators.memory_resource(), &arena);
+    arena_indicators.calculate(chart);
+    Indicators indicators;
+    indicators.calculate(chart);
+
+    EXPECT_EQ(arena_indicators.sma_short()->values().get_allocator().resource(), &arena);
+    EXPECT_EQ(arena_indicators.signals()->signals().get_allocator().resource(), &arena);
+    EXPECT_EQ(arena_indicators.sma_short()->values_copy(), indicators.sma_short()->values_copy());
+    EXPECT_EQ(arena_indicators.rsi()->values_copy(), indicators.rsi()->values_copy());
+    EXPECT_EQ(arena_indicators.patterns()->pattern_count(), indicators.patterns()->pattern_count());
+}
+
+TEST_F(IndicatorTest, NullResourceUsesDefault) {
+    auto* const fallback = std::pmr::get_default_resource();
+    EXPECT_EQ(Indicators(IndicatorConfig{}, nullptr).memory_resource(), fallback);
+    EXPECT_EQ(MovingAverage(5, nullptr).values().get_allocator().resource(), fallback);
+    EXPECT_EQ(BollingerBands(20, 2.0, nullptr).lower_band().get_allocator().resource(), fallback);
+    EXPECT_EQ(RSI(14, nullptr).values().get_allocator().resource(), fallback);
+    EXPECT_EQ(OnBalanceVolume(nullptr).values().get_allocator().resource(), fallback);
+    EXPECT_EQ(SignalDetector(nullptr).signals().get_allocator().resource(), fallback);
+    EXPECT_EQ(SupportResistance(0.01, nullptr).levels().get_allocator().resource(), fallback);
+    EXPECT_EQ(PriceObjectiveCalculator(nullptr).objectives().get_allocator().resource(), fallback);
+    EXPECT_EQ(CongestionDetector(4, 0.1, nullptr).zones().get_allocator().resource(), fallback);
+
+    PatternRecognizer patterns(nullptr);
+    patterns.detect(chart);
+    EXPECT_EQ(patterns.patterns().get_allocator().resource(), fallback);
+}
+
+TEST(IndicatorPipelineTest, UpdateMatchesCalculate) {
+    ChartConfig cfg;
+    cfg.box_size_method = BoxSizeMethod::ATR;
+    cfg.box_size = 0.5;
+    cfg.atr_period = 10;
+    cfg.atr_refresh = 120;
+    cfg.reversal = 2;
+    Chart chart(cfg);
+    Indicators incremental;
+
+    const auto start = std::chrono::system_clock::now();
+    for (int i = 0; i < 700; i++) {
+        const double p = 100.0 + 20.0 * std::sin(i * 0.03) + 4.0 * std::sin(i * 0.4);
+        chart.add_data(p + 0.8, p - 0.8, p, start + std::chrono::hours(i));
+        incremental.update(chart);
+        if (i % 25 != 24) continue;
+
+        Indicators full;
+        full.calculate(chart);
+        ASSERT_EQ(incremental.sma_short()->values_copy(), full.sma_short()->values_copy()) << i;
+        ASSERT_EQ(incremental.sma_long()->values_copy(), full.sma_long()->values_copy()) << i;
+        ASSERT_EQ(incremental.bollinger()->upper_copy(), full.bollinger()->upper_copy()) << i;
+        ASSERT_EQ(incremental.bollinger()->lower_copy(), full.bollinger()->lower_copy()) << i;
+        ASSERT_EQ(incremental.rsi()->values_copy(), full.rsi()->values_copy()) << i;
+        ASSERT_EQ(incremental.bullish_percent()->value(), full.bullish_percent()->value()) << i;
+        ASSERT_EQ(incremental.signals()->signals().size(), full.signals()->signals().size()) << i;
+        ASSERT_EQ(incremental.signals()->current_signal(), full.signals()->current_signal()) << i;
+        for (size_t s = 0; s < full.signals()->signals().size(); s++) {
+            EXPECT_EQ(incremental.signals()->signals()[s].column_index, full.signals()->signals()[s].column_index);
+            EXPECT_EQ(incremental.signals()->signals()[s].price, full.signals()->signals()[s].price);
+        }
+        const auto& a = incremental.patterns()->patterns();
+        const auto& b = full.patterns()->patterns();
+        ASSERT_EQ(a.size(), b.size()) << i;
+        for (size_t k = 0; k < a.size(); k++) {
+            EXPECT_EQ(a[k].type, b[k].type);
+            EXPECT_EQ(a[k].start_column, b[k].start_column);
+            EXPECT_EQ(a[k].end_column, b[k].end_column);
+            EXPECT_EQ(a[k].price, b[k].price);
+        }
+    }
+    EXPECT_GT(chart.rebuild_count(), 0u);
+    EXPECT_FALSE(incremental.patterns()->patterns().empty());
+    EXPECT_FALSE(incremental.signals()->signals().empty());
+}
+
+TEST(IndicatorPipelineTest, PoolMatchesSerial) {
+    ChartConfig cfg;
+    cfg.box_size_method = BoxSizeMethod::Fixed;
+    cfg.box_size = 0.5;
+    cfg.reversal = 2;
+    Chart chart(cfg);
+    const auto start = std::chrono::system_clock::now();
+    for (int i = 0; i < 2000; i++) {
+        const double p = 100.0 + 20.0 * std::sin(i * 0.03) + 4.0 * std::sin(i * 0.4);
+        chart.add_data(p, start + std::chrono::hours(i));
+    }
+
+    Indicators serial;
+    serial.calculate(chart);
+    ThreadPool pool(4);
+    Indicators parallel;
+    parallel.calculate(chart, pool);
+
+    EXPECT_EQ(parallel.sma_medium()->values_copy(), serial.sma_medium()->values_copy());
+    EXPECT_EQ(parallel.bollinger()->upper_copy(), serial.bollinger()->upper_copy());
+    EXPECT_EQ(parallel.rsi()->values_copy(), serial.rsi()->values_copy());
+    EXPECT_EQ(parallel.signals()->signals().size(), serial.signals()->signals().size());
+    EXPECT_EQ(parallel.patterns()->patterns().size(), serial.patterns()->patterns().size());
+    EXPECT_EQ(parallel.to_string(), serial.to_string());
+
+    // A pooled pass leaves the incremental state synced like a serial one.
+    chart.add_data(130.0, start + std::chrono::hours(2000));
+    parallel.update(chart);
+    serial.calculate(chart);
+    EXPECT_EQ(parallel.to_string(), serial.to_string());
+}
+
+TEST(IndicatorPipelineTest, ViewsMatchCopies) {
+    ChartConfig cfg;
+    cfg.box_size_method = BoxSizeMethod::Fixed;
+    cfg.box_size = 0.5;
+    cfg.reversal = 2;
+    Chart chart(cfg);
+    const auto start = std::chrono::system_clock::now();
+    for (int i = 0; i < 1500; i++) {
+        const double p = 100.0 + 20.0 * std::sin(i * 0.03) + 4.0 * std::sin(i * 0.4);
+        chart.add_data(p, start + std::chrono::hours(i));
+    }
+    Indicators indicators;
+    indicators.calculate(chart);
+
+    const auto same = [](auto view, const auto& copy, auto key) {
+        return std::ranges::equal(view, copy, {}, key, key);
+    };
+    const auto price = [](const auto& item) { return item.price; };
+    const SignalDetector& signals = *indicators.signals();
+    const PatternRecognizer& patterns = *indicators.patterns();
+    const SupportResistance& sr = *indicators.support_resistance();
+    const PriceObjectiveCalculator& objectives = *indicators.objectives();
+    EXPECT_TRUE(same(signals.buy_signals_view(), signals.buy_signals(), &Signal::column_index));
+    EXPECT_TRUE(same(signals.sell_signals_view(), signals.sell_signals(), &Signal::column_index));
+    EXPECT_TRUE(same(patterns.bullish_patterns_view(), patterns.bullish_patterns(), &Pattern::end_column));
+    EXPECT_TRUE(same(patterns.patterns_of_type_view(PatternType::DoubleTopBreakout),
+                     patterns.patterns_of_type(PatternType::DoubleTopBreakout), &Pattern::end_column));
+    EXPECT_TRUE(same(sr.resistance_levels_view(), sr.resistance_levels(), price));
+    EXPECT_TRUE(same(sr.significant_levels_view(2), sr.significant_levels(2), price));
+    EXPECT_TRUE(same(sr.support_prices_view(), sr.support_prices(), std::identity{}));
+    EXPECT_TRUE(same(objectives.bearish_targets_view(), objectives.bearish_targets(), std::identity{}));
+    EXPECT_FALSE(signals.buy_signals().empty());
+    EXPECT_FALSE(sr.support_prices().empty());
+
+    const IndicatorData data = indicators.export_data();
+    const IndicatorDataView view = indicators.export_view();
+    EXPECT_TRUE(std::ranges::equal(view.rsi, data.rsi));
+    EXPECT_TRUE(std::ranges::equal(view.bollinger_upper, data.bollinger_upper));
+    EXPECT_EQ(view.signals.size(), data.signals.size());
+    EXPECT_EQ(view.patterns.size(), data.patterns.size());
+    EXPECT_EQ(view.levels.size(), data.support_levels.size() + data.resistance_levels.size());
+    EXPECT_EQ(view.signals.data(), indicators.signals()->signals().data());
+}
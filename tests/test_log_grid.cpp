@@ -0,0 +1,120 @@
+/// \file test_log_grid.cpp
+/// \brief Test logarithmic box grid implementation.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include "pnf/pnf.hpp"
+#include <cmath>
+
+using namespace pnf;
+
+class LogGridTest : public ::testing::Test {
+protected:
+    static ChartConfig log_config(const ConstructionMethod method = ConstructionMethod::Close) {
+        ChartConfig cfg;
+        cfg.method = method;
+        cfg.box_size_method = BoxSizeMethod::Logarithmic;
+        cfg.box_size = 2.0;
+        cfg.reversal = 3;
+        return cfg;
+    }
+
+    Timestamp now = std::chrono::system_clock::now();
+};
+
+TEST_F(LogGridTest, LevelsAreGeometric) {
+    LogBoxGrid grid(2.0);
+    EXPECT_DOUBLE_EQ(grid.ratio(), 1.02);
+    EXPECT_DOUBLE_EQ(grid.level(0), 1.0);
+    EXPECT_DOUBLE_EQ(grid.level(10), std::pow(1.02, 10));
+    EXPECT_DOUBLE_EQ(grid.level(-3), std::pow(1.02, -3));
+    EXPECT_DOUBLE_EQ(LogBoxGrid(0.0).percent(), 1.0);
+}
+
+TEST_F(LogGridTest, IndexLookupInsideAndOutsideTable) {
+    LogBoxGrid grid(1.0);
+    const int k = grid.floor_index(100.0);
+    EXPECT_LE(grid.level(k), 100.0);
+    EXPECT_GT(grid.level(k + 1), 100.0);
+    EXPECT_EQ(grid.ceil_index(100.0), k + 1);
+    EXPECT_EQ(grid.table_size(), 0u);
+
+    const double exact = grid.at(k);
+    EXPECT_GT(grid.table_size(), 0u);
+    EXPECT_EQ(grid.floor_index(exact), k);
+    EXPECT_EQ(grid.ceil_index(exact), k);
+
+    grid.at(k - 40);
+    EXPECT_LE(grid.first_index(), k - 40);
+    for (int i = k - 40; i <= k + 5; i++) {
+        EXPECT_EQ(grid.floor_index(grid.level(i)), i);
+        EXPECT_DOUBLE_EQ(grid.at(i), std::pow(1.01, i));
+    }
+}
+
+TEST_F(LogGridTest, ColumnsShareGridLevels) {
+    for (const auto method : {ConstructionMethod::Close, ConstructionMethod::HighLow}) {
+        Chart chart(log_config(method));
+        for (int i = 0; i < 400; i++) {
+            const double c = 50.0 * std::exp(0.6 * std::sin(i * 0.04)) * (1.0 + 0.02 * std::sin(i * 0.9));
+            chart.add_data(c * 1.01, c * 0.99, c, now + std::chrono::hours(i));
+        }
+        ASSERT_GT(chart.column_count(), 3u);
+        const LogBoxGrid* grid = chart.log_grid();
+        ASSERT_NE(grid, nullptr);
+
+        for (size_t c = 0; c < chart.column_count(); c++) {
+            const Column* col = chart.column(c);
+            for (size_t b = 0; b < col->box_count(); b++) {
+                const double price = col->get_box_at(b)->price();
+                EXPECT_EQ(price, grid->level(grid->floor_index(price)));
+            }
+            const int rows = grid->floor_index(col->highest_price()) - grid->floor_index(col->lowest_price()) + 1;
+            EXPECT_EQ(static_cast<size_t>(rows), col->box_count());
+        }
+    }
+}
+
+TEST_F(LogGridTest, ReversalCountsLevels) {
+    Chart chart(log_config());
+    const LogBoxGrid* grid = chart.log_grid();
+    chart.add_data(100.0, now);
+    const int top = grid->floor_index(chart.last_column()->highest_price());
+
+    chart.add_data(grid->level(top - 2), now);
+    EXPECT_EQ(chart.column_count(), 1u);
+    chart.add_data(grid->level(top - 3), now);
+    ASSERT_EQ(chart.column_count(), 2u);
+    EXPECT_EQ(chart.last_column()->type(), ColumnType::O);
+    EXPECT_EQ(chart.last_column()->box_count(), 3u);
+}
+
+TEST_F(LogGridTest, RejectsNonPositivePrices) {
+    Chart chart(log_config());
+    EXPECT_FALSE(chart.add_data(0.0, now));
+    EXPECT_FALSE(chart.add_data(-5.0, now));
+    EXPECT_EQ(chart.column_count(), 0u);
+    EXPECT_EQ(Chart().log_grid(), nullptr);
+}
+
+TEST_F(LogGridTest, AsciiRendererUsesLevelRows) {
+    Chart chart(log_config());
+    for (const double p : {100.0, 110.0, 120.0, 105.0, 95.0, 115.0}) chart.add_data(p, now);
+
+    RenderConfig cfg;
+    cfg.show_column_numbers = false;
+    cfg.show_month_markers = false;
+    const std::string out = AsciiRenderer(cfg).render(chart);
+
+    const LogBoxGrid* grid = chart.log_grid();
+    double lo = chart.column(0)->lowest_price(), hi = chart.column(0)->highest_price();
+    for (size_t c = 0; c < chart.column_count(); c++) {
+        lo = std::min(lo, chart.column(c)->lowest_price());
+        hi = std::max(hi, chart.column(c)->highest_price());
+    }
+    const auto rows = static_cast<size_t>(grid->floor_index(hi) - grid->floor_index(lo) + 1);
+    EXPECT_EQ(static_cast<size_t>(std::count(out.begin(), out.end(), '\n')), rows);
+}
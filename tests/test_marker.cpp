@@ -0,0 +1,86 @@
+/// \file test_marker.cpp
+/// \brief Test interned box marker implementation.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include "pnf/pnf.hpp"
+#include <cmath>
+#include <thread>
+#include <vector>
+
+using namespace pnf;
+
+TEST(MarkerTableTest, MonthCodesArePreRegistered) {
+    const std::string codes = "123456789ABC";
+    for (int m = 1; m <= 12; m++) {
+        const MarkerId id = MarkerTable::month(m);
+        EXPECT_EQ(id, m);
+        EXPECT_EQ(MarkerTable::name(id), std::string(1, codes[m - 1]));
+        EXPECT_EQ(MarkerTable::intern(std::string(1, codes[m - 1])), id);
+    }
+    EXPECT_EQ(MarkerTable::month(0), MarkerTable::none);
+    EXPECT_EQ(MarkerTable::month(13), MarkerTable::none);
+    EXPECT_EQ(MarkerTable::intern(""), MarkerTable::none);
+    EXPECT_TRUE(MarkerTable::name(MarkerTable::none).empty());
+    EXPECT_TRUE(MarkerTable::name(60000).empty());
+}
+
+TEST(MarkerTableTest, UserMarkersInternOnce) {
+    const MarkerId id = MarkerTable::intern("earnings");
+    EXPECT_GT(id, MarkerTable::month_count);
+    EXPECT_EQ(MarkerTable::intern("earnings"), id);
+    EXPECT_EQ(MarkerTable::name(id), "earnings");
+    EXPECT_NE(MarkerTable::intern("split"), id);
+    EXPECT_GE(MarkerTable::size(), MarkerTable::month_count + 2u);
+}
+
+TEST(MarkerTableTest, ConcurrentInternAgrees) {
+    std::vector<std::vector<MarkerId>> ids(4);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < ids.size(); t++) {
+        threads.emplace_back([&ids, t] {
+            for (int i = 0; i < 200; i++) ids[t].push_back(MarkerTable::intern("event-" + std::to_string(i)));
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    for (size_t t = 1; t < ids.size(); t++) EXPECT_EQ(ids[t], ids[0]);
+    EXPECT_EQ(MarkerTable::name(ids[0][17]), "event-17");
+}
+
+TEST(MarkerTableTest, BoxStoresMarkerId) {
+    EXPECT_LE(sizeof(Box), 16u);
+
+    Box box(10.0, BoxType::X, "A");
+    EXPECT_EQ(box.marker_id(), MarkerTable::month(10));
+    EXPECT_EQ(box.marker(), "A");
+    EXPECT_EQ(box.to_string(), "10A");
+
+    box.set_marker("note");
+    EXPECT_EQ(box.marker(), "note");
+    box.set_marker_id(MarkerTable::none);
+    EXPECT_TRUE(box.marker().empty());
+    EXPECT_EQ(box.to_string(), "10X");
+}
+
+TEST(MarkerTableTest, ChartWritesMonthIds) {
+    Chart chart;
+    const Timestamp start = std::chrono::system_clock::now() - std::chrono::hours(24 * 400);
+    for (int i = 0; i < 300; i++) {
+        chart.add_data(100.0 + 10.0 * std::sin(i * 0.1), start + std::chrono::hours(24 * i));
+    }
+
+    size_t marked = 0;
+    for (size_t c = 0; c < chart.column_count(); c++) {
+        const Column* col = chart.column(c);
+        for (size_t b = 0; b < col->box_count(); b++) {
+            const Box* box = col->get_box_at(b);
+            if (box->marker_id() == MarkerTable::none) continue;
+            EXPECT_LE(box->marker_id(), MarkerTable::month_count);
+            marked++;
+        }
+    }
+    EXPECT_GT(marked, 0u);
+}
@@ -0,0 +1,157 @@
+/// \file test_mask.cpp
+/// \brief Test column masks and comparison kernels.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include "pnf/pnf.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+using namespace pnf;
+
+namespace {
+    std::vector<double> wave(const size_t n, const double phase) {
+        std::vector<double> v(n);
+        for (size_t i = 0; i < n; i++) v[i] = 50.0 + 30.0 * std::sin(static_cast<double>(i) * 0.37 + phase);
+        return v;
+    }
+
+    std::vector<SimdLevel> levels() {
+        std::vector<SimdLevel> result{SimdLevel::Scalar};
+        if (supported_simd_level() >= SimdLevel::AVX2) result.push_back(SimdLevel::AVX2);
+        if (supported_simd_level() >= SimdLevel::AVX512) result.push_back(SimdLevel::AVX512);
+        return result;
+    }
+
+    class SimdLevelGuard {
+    public:
+        SimdLevelGuard() : saved_(simd_level()) {}
+        ~SimdLevelGuard() { set_simd_level(saved_); }
+
+    private:
+        SimdLevel saved_;
+    };
+}
+
+TEST(ColumnMaskTest, BitOperations) {
+    ColumnMask mask(130);
+    EXPECT_EQ(mask.words().size(), 3u);
+    mask.set(0);
+    mask.set(64);
+    mask.set(129);
+    mask.set(130);
+    EXPECT_TRUE(mask.test(64));
+    EXPECT_FALSE(mask.test(130));
+    EXPECT_EQ(mask.count(), 3u);
+    EXPECT_EQ(mask.indices(), (std::vector<size_t>{0, 64, 129}));
+
+    ColumnMask other(130);
+    other.set(64);
+    EXPECT_EQ((mask & other).indices(), (std::vector<size_t>{64}));
+    mask.clear_before(65);
+    EXPECT_EQ(mask.indices(), (std::vector<size_t>{129}));
+    EXPECT_FALSE(ColumnMask(10).any());
+}
+
+TEST(ColumnMaskTest, KernelsMatchScalarLoops) {
+    SimdLevelGuard guard;
+    std::vector<double> values = wave(301, 0.0);
+    const std::vector<double> bounds = wave(301, 1.3);
+    values[17] = std::numeric_limits<double>::quiet_NaN();
+    const std::vector<double> level_prices{25.0, 52.0, 71.5};
+
+    for (const SimdLevel level : levels()) {
+        EXPECT_EQ(set_simd_level(level), level);
+        for (const size_t first : {0u, 3u, 64u, 70u, 300u, 400u}) {
+            const ColumnMask gt = mask_greater(values, bounds, first);
+            const ColumnMask lt = mask_less(values, 60.0, first);
+            const ColumnMask up = mask_cross_above(values, 50.0, first);
+            const ColumnMask down = mask_cross_below(values, 50.0, first);
+            ASSERT_EQ(gt.size(), values.size());
+            for (size_t i = 0; i < values.size(); i++) {
+                const bool valid = i >= first;
+                EXPECT_EQ(gt.test(i), valid && values[i] > bounds[i]) << i;
+                EXPECT_EQ(lt.test(i), valid && values[i] < 60.0) << i;
+                const bool can_cross = valid && i >= 1;
+                EXPECT_EQ(up.test(i), can_cross && values[i - 1] <= 50.0 && values[i] > 50.0) << i;
+                EXPECT_EQ(down.test(i), can_cross && values[i - 1] >= 50.0 && values[i] < 50.0) << i;
+            }
+        }
+
+        const ColumnMask near = mask_near_any(values, level_prices, 0.02);
+        for (size_t i = 0; i < values.size(); i++) {
+            bool expected = false;
+            for (const double l : level_prices) expected |= std::abs(values[i] - l) / l < 0.02;
+            EXPECT_EQ(near.test(i), expected) << i;
+        }
+    }
+}
+
+TEST(ColumnMaskTest, IndicatorMasksMatchAccessors) {
+    ChartConfig cfg;
+    cfg.box_size_method = BoxSizeMethod::Fixed;
+    cfg.box_size = 1.0;
+    cfg.reversal = 1;
+    Chart chart(cfg);
+    const auto start = std::chrono::system_clock::now();
+    for (int i = 0; i < 600; i++) {
+        chart.add_data(100.0 + 25.0 * std::sin(i * 0.05) + 8.0 * std::sin(i * 0.31), start + std::chrono::hours(i));
+    }
+
+    Indicators indicators;
+    indicators.calculate(chart);
+    const auto& bands = *indicators.bollinger();
+    const auto& rsi = *indicators.rsi();
+    const auto& sr = *indicators.support_resistance();
+
+    std::vector<double> midpoints;
+    for (size_t i = 0; i < chart.column_count(); i++) {
+        const Column* col = chart.column(i);
+        midpoints.push_back((col->highest_price() + col->lowest_price()) / 2.0);
+    }
+
+    const ColumnMask above = bands.above_upper_mask(midpoints);
+    const ColumnMask below = bands.below_lower_mask(midpoints);
+    const ColumnMask overbought = rsi.overbought_mask();
+    const ColumnMask oversold = rsi.oversold_mask(40.0);
+    const ColumnMask near_support = sr.near_support_mask(midpoints);
+    const ColumnMask near_resistance = sr.near_resistance_mask(midpoints, 0.01);
+    for (size_t i = 0; i < midpoints.size(); i++) {
+        const int c = static_cast<int>(i);
+        EXPECT_EQ(above.test(i), bands.is_above_upper(c, midpoints[i]));
+        EXPECT_EQ(below.test(i), bands.is_below_lower(c, midpoints[i]));
+        EXPECT_EQ(overbought.test(i), rsi.is_overbought(c));
+        EXPECT_EQ(oversold.test(i), rsi.is_oversold_custom(c, 40.0));
+        EXPECT_EQ(near_support.test(i), sr.is_near_support(midpoints[i]));
+        EXPECT_EQ(near_resistance.test(i), sr.is_near_resistance(midpoints[i], 0.01));
+    }
+
+    const ColumnMask crosses = rsi.cross_above_mask(50.0);
+    for (const size_t i : crosses.indices()) {
+        EXPECT_TRUE(rsi.has_value(static_cast<int>(i) - 1));
+        EXPECT_LE(rsi.value(static_cast<int>(i) - 1), 50.0);
+        EXPECT_GT(rsi.value(static_cast<int>(i)), 50.0);
+    }
+}
+
+TEST(ColumnMaskTest, ReductionsMatchScalar) {
+    SimdLevelGuard guard;
+    std::vector<double> values = wave(203, 0.4);
+    values[150] = 95.0;
+    values[3] = -7.0;
+    for (const SimdLevel level : levels()) {
+        set_simd_level(level);
+        for (const size_t n : {0u, 1u, 5u, 8u, 13u, 151u, 203u}) {
+            const std::span<const double> head(values.data(), n);
+            const double expected_max = n ? *std::max_element(head.begin(), head.end()) : 0.0;
+            const double expected_min = n ? *std::min_element(head.begin(), head.end()) : 0.0;
+            EXPECT_EQ(series_max(head), expected_max) << n;
+            EXPECT_EQ(series_min(head), expected_min) << n;
+        }
+    }
+}
@@ -0,0 +1,102 @@
+/// \file test_relative_strength.cpp
+/// \brief Test relative strength chart implementation.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include "pnf/pnf.hpp"
+#include <cmath>
+
+using namespace pnf;
+
+class RelativeStrengthTest : public ::testing::Test {
+protected:
+    static std::vector<OHLC> series(const Timestamp start, const int count, const int step_hours,
+                                    const double base, const double drift) {
+        std::vector<OHLC> bars;
+        for (int i = 0; i < count; i++) {
+            const double c = base * (1.0 + drift * i) * (1.0 + 0.05 * std::sin(i * 0.3));
+            bars.push_back({start + std::chrono::hours(i * step_hours), c, c, c, c, 0.0});
+        }
+        return bars;
+    }
+
+    Timestamp start = std::chrono::system_clock::now();
+};
+
+TEST_F(RelativeStrengthTest, WaitsForBothLegs) {
+    RelativeStrengthChart rs;
+    EXPECT_FALSE(rs.update_symbol(50.0, start));
+    EXPECT_FALSE(rs.has_ratio());
+    EXPECT_EQ(rs.chart().column_count(), 0u);
+
+    EXPECT_TRUE(rs.update_benchmark(100.0, start + std::chrono::hours(1)));
+    EXPECT_TRUE(rs.has_ratio());
+    EXPECT_DOUBLE_EQ(rs.ratio(), 50.0);
+    EXPECT_EQ(rs.chart().column_count(), 1u);
+}
+
+TEST_F(RelativeStrengthTest, AsOfJoinUsesLatestLegs) {
+    RelativeStrengthChart rs;
+    rs.update(50.0, 100.0, start);
+    rs.update_symbol(60.0, start + std::chrono::hours(1));
+    EXPECT_DOUBLE_EQ(rs.ratio(), 60.0);
+    rs.update_benchmark(120.0, start + std::chrono::hours(2));
+    EXPECT_DOUBLE_EQ(rs.ratio(), 50.0);
+    EXPECT_EQ(rs.ratio_count(), 3u);
+}
+
+TEST_F(RelativeStrengthTest, IgnoresNonPositivePrices) {
+    RelativeStrengthChart rs;
+    rs.update(50.0, 100.0, start);
+    EXPECT_FALSE(rs.update_benchmark(0.0, start));
+    EXPECT_DOUBLE_EQ(rs.benchmark_price(), 100.0);
+    EXPECT_EQ(rs.ratio_count(), 1u);
+}
+
+TEST_F(RelativeStrengthTest, BuildMatchesStreaming) {
+    const auto symbol = series(start, 300, 1, 50.0, 0.002);
+    const auto benchmark = series(start, 150, 2, 100.0, 0.0005);
+
+    const auto built = RelativeStrengthChart::build(symbol, benchmark);
+
+    RelativeStrengthChart streamed;
+    size_t j = 0;
+    for (const auto& bar : symbol) {
+        if (j < benchmark.size() && benchmark[j].time == bar.time) {
+            streamed.update(bar.close, benchmark[j].close, bar.time);
+            j++;
+        } else {
+            streamed.update_symbol(bar.close, bar.time);
+        }
+    }
+
+    EXPECT_EQ(built.ratio_count(), streamed.ratio_count());
+    EXPECT_DOUBLE_EQ(built.ratio(), streamed.ratio());
+    EXPECT_EQ(built.chart().column_count(), streamed.chart().column_count());
+    EXPECT_GT(built.chart().column_count(), 1u);
+}
+
+TEST_F(RelativeStrengthTest, UsesPercentageBoxes) {
+    const auto built = RelativeStrengthChart::build(series(start, 100, 1, 50.0, 0.01),
+                                                    series(start, 100, 1, 100.0, 0.0));
+    EXPECT_EQ(built.config().chart.box_size_method, BoxSizeMethod::Percentage);
+    EXPECT_NEAR(built.chart().current_box_size(), built.ratio() * 0.0325, 1e-9);
+}
+
+TEST_F(RelativeStrengthTest, UniverseMatchesSequential) {
+    const auto benchmark = series(start, 200, 1, 100.0, 0.001);
+    std::vector<std::vector<OHLC>> symbols;
+    for (int k = 0; k < 8; k++) symbols.push_back(series(start, 200, 1, 20.0 + k, 0.001 * k));
+
+    ThreadPool pool(4);
+    const auto universe = RelativeStrengthChart::build_universe(symbols, benchmark, pool);
+    ASSERT_EQ(universe.size(), symbols.size());
+    for (size_t k = 0; k < symbols.size(); k++) {
+        const auto expected = RelativeStrengthChart::build(symbols[k], benchmark);
+        EXPECT_DOUBLE_EQ(universe[k].ratio(), expected.ratio());
+        EXPECT_EQ(universe[k].chart().column_count(), expected.chart().column_count());
+    }
+}
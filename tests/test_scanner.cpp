@@ -0,0 +1,235 @@
+/// \file test_scanner.cpp
+/// \brief Test scanner implementation.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include "pnf/pnf.hpp"
+#include <cmath>
+
+using namespace pnf;
+
+class ScannerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ChartConfig cfg;
+        cfg.box_size_method = BoxSizeMethod::Fixed;
+        cfg.box_size = 1.0;
+        cfg.reversal = 3;
+
+        // Double top breakout by 2 boxes on the last column.
+        breakout = std::make_unique<Chart>(cfg);
+        for (const double p : {100.0, 105.0, 101.0, 107.0}) breakout->add_data(p, now);
+
+        // Double top breakout by 6 boxes on the last column.
+        strong = std::make_unique<Chart>(cfg);
+        for (const double p : {100.0, 105.0, 101.0, 111.0}) strong->add_data(p, now);
+
+        // Double bottom breakdown on the last column.
+        breakdown = std::make_unique<Chart>(cfg);
+        for (const double p : {100.0, 95.0, 99.0, 93.0}) breakdown->add_data(p, now);
+
+        for (Chart* c : {breakout.get(), strong.get(), breakdown.get()}) {
+            auto ind = std::make_unique<Indicators>();
+            ind->calculate(*c);
+            indicators.push_back(std::move(ind));
+        }
+    }
+
+    void fill(Scanner& scanner, const bool with_indicators) const {
+        scanner.add("BRK", *breakout, with_indicators ? indicators[0].get() : nullptr);
+        scanner.add("STR", *strong, with_indicators ? indicators[1].get() : nullptr);
+        scanner.add("DWN", *breakdown, with_indicators ? indicators[2].get() : nullptr);
+    }
+
+    Timestamp now = std::chrono::system_clock::now();
+    std::unique_ptr<Chart> breakout;
+    std::unique_ptr<Chart> strong;
+    std::unique_ptr<Chart> breakdown;
+    std::vector<std::unique_ptr<Indicators>> indicators;
+};
+
+TEST_F(ScannerTest, EmptyQueryMatchesEverything) {
+    Scanner scanner;
+    fill(scanner, false);
+    EXPECT_EQ(scanner.size(), 3u);
+    EXPECT_EQ(CompiledScanQuery(ScanQuery{}).step_count(), 0u);
+    EXPECT_EQ(scanner.scan(ScanQuery{}).size(), 3u);
+}
+
+TEST_F(ScannerTest, SignalQueryRanksByBreakoutStrength) {
+    Scanner scanner;
+    fill(scanner, false);
+
+    ScanQuery query;
+    query.signal = SignalType::Buy;
+    const auto matches = scanner.scan(query);
+
+    ASSERT_EQ(matches.size(), 2u);
+    EXPECT_EQ(matches[0].symbol, "STR");
+    EXPECT_EQ(matches[1].symbol, "BRK");
+    EXPECT_GT(matches[0].score, matches[1].score);
+    EXPECT_DOUBLE_EQ(matches[1].score, 2.0);
+    EXPECT_EQ(matches[0].signal, SignalType::Buy);
+    EXPECT_DOUBLE_EQ(matches[1].price, 107.0);
+    EXPECT_EQ(matches[1].column, 2);
+
+    query.limit = 1;
+    EXPECT_EQ(scanner.scan(query).size(), 1u);
+}
+
+TEST_F(ScannerTest, PatternQuery) {
+    Scanner scanner;
+    fill(scanner, false);
+
+    ScanQuery query;
+    query.patterns = {PatternType::DoubleBottomBreakdown, PatternType::TripleBottomBreakdown};
+    const auto matches = scanner.scan(query);
+
+    ASSERT_EQ(matches.size(), 1u);
+    EXPECT_EQ(matches[0].symbol, "DWN");
+    EXPECT_EQ(matches[0].pattern, PatternType::DoubleBottomBreakdown);
+}
+
+TEST_F(ScannerTest, IndicatorsAndChartAgree) {
+    Scanner direct;
+    fill(direct, false);
+    Scanner cached;
+    fill(cached, true);
+
+    ScanQuery query;
+    query.patterns = {PatternType::DoubleTopBreakout};
+    query.signal = SignalType::Buy;
+    query.rsi_max = 100.0;
+    query.rsi_min = 1.0;
+
+    const auto a = direct.scan(query);
+    const auto b = cached.scan(query);
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); i++) {
+        EXPECT_EQ(a[i].index, b[i].index);
+        EXPECT_EQ(a[i].pattern, b[i].pattern);
+    }
+}
+
+TEST_F(ScannerTest, RsiFilter) {
+    Scanner scanner;
+    fill(scanner, true);
+
+    ScanQuery query;
+    query.rsi_min = 0.0;
+    query.rsi_max = 40.0;
+    for (const auto& m : scanner.scan(query)) {
+        const auto& values = indicators[m.index]->rsi()->values();
+        EXPECT_LE(values.back(), 40.0);
+    }
+}
+
+TEST_F(ScannerTest, MinColumnsAndLookback) {
+    Scanner scanner;
+    fill(scanner, false);
+
+    ScanQuery query;
+    query.min_columns = 4;
+    const auto long_enough = scanner.scan(query);
+    ASSERT_EQ(long_enough.size(), 1u);
+    EXPECT_EQ(long_enough[0].symbol, "DWN");
+    query.min_columns = 5;
+    EXPECT_TRUE(scanner.scan(query).empty());
+
+    query.min_columns = 0;
+    query.signal = SignalType::Sell;
+    query.lookback = 3;
+    const auto matches = scanner.scan(query);
+    ASSERT_EQ(matches.size(), 1u);
+    EXPECT_EQ(matches[0].symbol, "DWN");
+}
+
+TEST_F(ScannerTest, ParallelMatchesSequential) {
+    std::vector<std::unique_ptr<Chart>> charts;
+    for (int k = 0; k < 64; k++) {
+        ChartConfig cfg;
+        cfg.box_size_method = BoxSizeMethod::Fixed;
+        cfg.box_size = 1.0;
+        auto chart = std::make_unique<Chart>(cfg);
+        for (int i = 0; i < 200; i++) {
+            chart->add_data(100.0 + 12.0 * std::sin(i * (0.05 + 0.003 * k)) + k * 0.1, now);
+        }
+        charts.push_back(std::move(chart));
+    }
+
+    Scanner sequential;
+    ThreadPool pool(4);
+    Scanner parallel(&pool);
+    for (size_t k = 0; k < charts.size(); k++) {
+        sequential.add("S" + std::to_string(k), *charts[k]);
+        parallel.add("S" + std::to_string(k), *charts[k]);
+    }
+
+    ScanQuery query;
+    query.signal = SignalType::Buy;
+    query.lookback = 2;
+    query.rsi_max = 90.0;
+
+    const auto a = sequential.scan(query);
+    const auto b = parallel.scan(query);
+    ASSERT_EQ(a.size(), b.size());
+    for (size_t i = 0; i < a.size(); i++) {
+        EXPECT_EQ(a[i].symbol, b[i].symbol);
+        EXPECT_DOUBLE_EQ(a[i].score, b[i].score);
+    }
+}
+
+TEST_F(ScannerTest, ChartOnlyContextIsTrailing) {
+    ChartConfig cfg;
+    cfg.box_size_method = BoxSizeMethod::Fixed;
+    cfg.box_size = 1.0;
+    cfg.reversal = 3;
+    Chart chart(cfg);
+
+    // Support at 100 early on, then a long 60-75 range, then a rally back to 100.
+    for (const double p : {120.0, 100.0, 130.0}) chart.add_data(p, now);
+    for (int i = 0; i < 40; i++) {
+        chart.add_data(60.0, now);
+        chart.add_data(75.0, now);
+    }
+    chart.add_data(60.0, now);
+    chart.add_data(100.0, now);
+    ASSERT_GT(chart.column_count(), 60u);
+
+    Scanner scanner;
+    scanner.add("RNG", chart);
+    ScanQuery query;
+    query.near_support = 0.005;
+    EXPECT_TRUE(scanner.scan(query).empty());
+    query.context_columns = 0;
+    EXPECT_EQ(scanner.scan(query).size(), 1u);
+}
+
+TEST_F(ScannerTest, ChartOnlyCatapultMatchesIndicators) {
+    ChartConfig cfg;
+    cfg.box_size_method = BoxSizeMethod::Fixed;
+    cfg.box_size = 1.0;
+    cfg.reversal = 3;
+    Chart chart(cfg);
+
+    // Triple top breakout at 106, pullback, then a double top breakout at 108.
+    for (const double p : {100.0, 105.0, 101.0, 105.0, 101.0, 106.0, 102.0, 108.0}) chart.add_data(p, now);
+    Indicators ind;
+    ind.calculate(chart);
+
+    Scanner direct;
+    direct.add("CAT", chart);
+    Scanner cached;
+    cached.add("CAT", chart, &ind);
+
+    ScanQuery query;
+    query.patterns = {PatternType::BullishCatapult};
+    const auto a = direct.scan(query);
+    const auto b = cached.scan(query);
+    ASSERT_EQ(b.size(), 1u);
+    ASSERT_EQ(a.size(), 1u);
+    EXPECT_EQ(a[0].pattern, PatternType::BullishCatapult);
+}
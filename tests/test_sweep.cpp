@@ -0,0 +1,136 @@
+/// \file test_sweep.cpp
+/// \brief Test parameter sweep implementation.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include "pnf/pnf.hpp"
+#include <cmath>
+
+using namespace pnf;
+
+class SweepTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        const Timestamp start = std::chrono::system_clock::now();
+        for (int i = 0; i < 400; i++) {
+            const double mid = 100.0 + 10.0 * std::sin(i * 0.07) + i * 0.02;
+            OHLC bar;
+            bar.time = start + std::chrono::hours(i);
+            bar.open = mid;
+            bar.high = mid + 0.6;
+            bar.low = mid - 0.6;
+            bar.close = mid + 0.2 * std::cos(i * 0.5);
+            bar.volume = 1000.0;
+            bars.push_back(bar);
+        }
+    }
+
+    std::vector<OHLC> bars;
+};
+
+TEST_F(SweepTest, GridExpansion) {
+    SweepGrid grid;
+    grid.box_sizes = {0.5, 1.0};
+    grid.box_size_methods = {BoxSizeMethod::Fixed};
+    grid.reversals = {1, 2, 3};
+    grid.methods = {ConstructionMethod::Close, ConstructionMethod::HighLow};
+
+    const auto configs = grid.configs();
+    ASSERT_EQ(configs.size(), grid.size());
+    EXPECT_EQ(configs.size(), 12u);
+    EXPECT_EQ(configs[0].method, ConstructionMethod::Close);
+    EXPECT_DOUBLE_EQ(configs[0].box_size, 0.5);
+    EXPECT_EQ(configs[0].reversal, 1);
+    EXPECT_EQ(configs[1].reversal, 2);
+    EXPECT_DOUBLE_EQ(configs[3].box_size, 1.0);
+    EXPECT_EQ(configs[6].method, ConstructionMethod::HighLow);
+}
+
+TEST_F(SweepTest, MatchesSequentialEvaluation) {
+    SweepGrid grid;
+    grid.box_sizes = {0.5, 1.0, 2.0};
+    grid.box_size_methods = {BoxSizeMethod::Fixed};
+    grid.reversals = {2, 3};
+    grid.methods = {ConstructionMethod::Close, ConstructionMethod::HighLow};
+
+    SweepOptions options;
+    options.threads = 4;
+    const ParameterSweep sweep(options);
+    const auto results = sweep.run(bars, grid);
+    const auto configs = grid.configs();
+    ASSERT_EQ(results.size(), configs.size());
+
+    for (size_t i = 0; i < configs.size(); i++) {
+        const auto expected = ParameterSweep::evaluate(bars, configs[i]);
+        EXPECT_EQ(results[i].config.reversal, configs[i].reversal);
+        EXPECT_EQ(results[i].column_count, expected.column_count);
+        EXPECT_EQ(results[i].buy_signals, expected.buy_signals);
+        EXPECT_EQ(results[i].sell_signals, expected.sell_signals);
+        EXPECT_EQ(results[i].pattern_count, expected.pattern_count);
+        EXPECT_EQ(results[i].objectives_hit, expected.objectives_hit);
+    }
+}
+
+TEST_F(SweepTest, ResultMatchesChartAndIndicators) {
+    ChartConfig cfg;
+    cfg.box_size_method = BoxSizeMethod::Fixed;
+    cfg.box_size = 1.0;
+    cfg.reversal = 3;
+
+    Chart chart(cfg);
+    for (const auto& bar : bars) chart.add_ohlc(bar);
+    SignalDetector detector;
+    detector.detect(chart);
+    PatternRecognizer recognizer;
+    recognizer.detect(chart);
+
+    const auto result = ParameterSweep::evaluate(bars, cfg);
+    EXPECT_GT(result.column_count, 1);
+    EXPECT_EQ(result.column_count, static_cast<int>(chart.column_count()));
+    EXPECT_EQ(result.x_column_count + result.o_column_count, result.column_count);
+    EXPECT_EQ(result.buy_signals, detector.buy_count());
+    EXPECT_EQ(result.sell_signals, detector.sell_count());
+    EXPECT_EQ(result.pattern_count, recognizer.pattern_count());
+    EXPECT_GE(result.objective_hit_rate, 0.0);
+    EXPECT_LE(result.objective_hit_rate, 1.0);
+    EXPECT_LE(result.objectives_hit, result.objective_count);
+}
+
+TEST_F(SweepTest, DisabledIndicatorsStayZero) {
+    ChartConfig cfg;
+    cfg.box_size_method = BoxSizeMethod::Fixed;
+    cfg.box_size = 1.0;
+
+    SweepOptions options;
+    options.signals = false;
+    options.patterns = false;
+    options.objectives = false;
+
+    const auto result = ParameterSweep::evaluate(bars, cfg, options);
+    EXPECT_GT(result.column_count, 0);
+    EXPECT_EQ(result.buy_signals + result.sell_signals, 0);
+    EXPECT_EQ(result.pattern_count, 0);
+    EXPECT_EQ(result.objective_count, 0);
+}
+
+TEST_F(SweepTest, SharedPool) {
+    ThreadPool pool(2);
+    const ParameterSweep sweep(pool);
+    const std::vector<ChartConfig> configs(5);
+    const auto results = sweep.run(bars, configs);
+    ASSERT_EQ(results.size(), 5u);
+    for (const auto& r : results) {
+        EXPECT_EQ(r.column_count, results[0].column_count);
+    }
+}
+
+TEST_F(SweepTest, EmptyInputs) {
+    const ParameterSweep sweep;
+    EXPECT_TRUE(sweep.run(bars, std::vector<ChartConfig>{}).empty());
+    const auto results = sweep.run({}, std::vector<ChartConfig>(2));
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[0].column_count, 0);
+}
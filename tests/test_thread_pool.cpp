@@ -0,0 +1,64 @@
+/// \file test_thread_pool.cpp
+/// \brief Test thread pool implementation.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include "pnf/pnf.hpp"
+#include <atomic>
+#include <stdexcept>
+
+using namespace pnf;
+
+TEST(ThreadPoolTest, DefaultSizeIsPositive) {
+    const ThreadPool pool;
+    EXPECT_GE(pool.size(), 1u);
+}
+
+TEST(ThreadPoolTest, SubmitAndWait) {
+    ThreadPool pool(4);
+    std::atomic<int> counter{0};
+    for (int i = 0; i < 1000; i++) {
+        pool.submit([&counter] { counter.fetch_add(1); });
+    }
+    pool.wait();
+    EXPECT_EQ(counter.load(), 1000);
+}
+
+TEST(ThreadPoolTest, ParallelForVisitsEveryIndexOnce) {
+    ThreadPool pool(4);
+    std::vector<int> hits(10000, 0);
+    pool.parallel_for(hits.size(), [&hits](const size_t i) { hits[i]++; });
+    for (const int h : hits) {
+        EXPECT_EQ(h, 1);
+    }
+}
+
+TEST(ThreadPoolTest, NestedParallelFor) {
+    ThreadPool pool(2);
+    std::atomic<int> counter{0};
+    pool.parallel_for(8, [&](size_t) {
+        pool.parallel_for(16, [&](size_t) { counter.fetch_add(1); });
+    });
+    EXPECT_EQ(counter.load(), 8 * 16);
+}
+
+TEST(ThreadPoolTest, ParallelForPropagatesException) {
+    ThreadPool pool(4);
+    EXPECT_THROW(pool.parallel_for(100, [](const size_t i) {
+        if (i == 42) throw std::runtime_error("boom");
+    }), std::runtime_error);
+
+    std::atomic<int> counter{0};
+    pool.parallel_for(10, [&counter](size_t) { counter.fetch_add(1); });
+    EXPECT_EQ(counter.load(), 10);
+}
+
+TEST(ThreadPoolTest, WaitPropagatesException) {
+    ThreadPool pool(2);
+    pool.submit([] { throw std::runtime_error("boom"); });
+    EXPECT_THROW(pool.wait(), std::runtime_error);
+    EXPECT_NO_THROW(pool.wait());
+}
@@ -0,0 +1,105 @@
+/// \file test_timeframe.cpp
+/// \brief Test multi-timeframe chart implementation.
+
+//
+// Created by gregorian-rayne on 17/10/2026.
+//
+
+#include <gtest/gtest.h>
+#include "pnf/pnf.hpp"
+#include <cmath>
+
+using namespace pnf;
+
+class TimeframeTest : public ::testing::Test {
+protected:
+    static std::vector<TimeframeSpec> specs() {
+        const ChartConfig config{ConstructionMethod::HighLow, BoxSizeMethod::Fixed, 1.0, 3};
+        return {{"M1", std::chrono::minutes(1), config},
+                {"H1", std::chrono::hours(1), config},
+                {"D1", std::chrono::hours(24), config}};
+    }
+
+    static double price_at(const int i) {
+        return 100.0 + 10.0 * std::sin(i * 0.01) + 3.0 * std::sin(i * 0.07);
+    }
+
+    // Midnight UTC, so every bucket boundary is aligned.
+    Timestamp start = Timestamp(std::chrono::hours(24 * 20000));
+};
+
+TEST_F(TimeframeTest, AggregatesTicksIntoBars) {
+    MultiTimeframeChart mtf({{"M1", std::chrono::minutes(1), {}}});
+    mtf.add_tick(10.0, 1.0, start);
+    mtf.add_tick(12.0, 2.0, start + std::chrono::seconds(10));
+    mtf.add_tick(9.0, 3.0, start + std::chrono::seconds(20));
+    mtf.add_tick(11.0, 4.0, start + std::chrono::seconds(59));
+
+    mtf.snapshot([&](const std::vector<TimeframeView>& views, const Timestamp as_of) {
+        ASSERT_EQ(views.size(), 1u);
+        ASSERT_NE(views[0].forming, nullptr);
+        const OHLC& bar = *views[0].forming;
+        EXPECT_EQ(bar.time, start);
+        EXPECT_DOUBLE_EQ(bar.open, 10.0);
+        EXPECT_DOUBLE_EQ(bar.high, 12.0);
+        EXPECT_DOUBLE_EQ(bar.low, 9.0);
+        EXPECT_DOUBLE_EQ(bar.close, 11.0);
+        EXPECT_DOUBLE_EQ(bar.volume, 10.0);
+        EXPECT_EQ(views[0].completed_bars, 0u);
+        EXPECT_EQ(as_of, start + std::chrono::seconds(59));
+    });
+
+    mtf.add_tick(11.5, 1.0, start + std::chrono::minutes(1));
+    mtf.snapshot([&](const std::vector<TimeframeView>& views, Timestamp) {
+        EXPECT_EQ(views[0].completed_bars, 1u);
+        EXPECT_DOUBLE_EQ(views[0].forming->open, 11.5);
+    });
+}
+
+TEST_F(TimeframeTest, MatchesSeparatelyResampledCharts) {
+    MultiTimeframeChart mtf(specs());
+    const auto config = specs()[1].chart;
+    Chart h1(config);
+
+    const int minutes = 60 * 24 * 3;
+    OHLC hour{};
+    for (int i = 0; i < minutes; i++) {
+        const double p = price_at(i);
+        const OHLC m1{start + std::chrono::minutes(i), p, p + 0.4, p - 0.4, p, 1.0};
+        mtf.add_bar(m1);
+
+        if (i % 60 == 0) {
+            hour = m1;
+        } else {
+            hour.high = std::max(hour.high, m1.high);
+            hour.low = std::min(hour.low, m1.low);
+            hour.close = m1.close;
+            hour.volume += m1.volume;
+        }
+        if (i % 60 == 59) h1.add_ohlc(hour);
+    }
+    mtf.flush();
+
+    const Chart& built = mtf.chart(mtf.find("H1"));
+    ASSERT_EQ(built.column_count(), h1.column_count());
+    for (size_t c = 0; c < h1.column_count(); c++) {
+        EXPECT_EQ(built.column(c)->type(), h1.column(c)->type());
+        EXPECT_DOUBLE_EQ(built.column(c)->highest_price(), h1.column(c)->highest_price());
+        EXPECT_DOUBLE_EQ(built.column(c)->lowest_price(), h1.column(c)->lowest_price());
+    }
+
+    mtf.snapshot([&](const std::vector<TimeframeView>& views, Timestamp) {
+        EXPECT_EQ(views[0].completed_bars, static_cast<size_t>(minutes));
+        EXPECT_EQ(views[1].completed_bars, static_cast<size_t>(minutes / 60));
+        EXPECT_EQ(views[2].completed_bars, 3u);
+        for (const auto& view : views) EXPECT_EQ(view.forming, nullptr);
+    });
+}
+
+TEST_F(TimeframeTest, FindAndClampedPeriod) {
+    MultiTimeframeChart mtf({{"bad", std::chrono::seconds(0), {}}, {"H1", std::chrono::hours(1), {}}});
+    EXPECT_EQ(mtf.timeframe_count(), 2u);
+    EXPECT_EQ(mtf.spec(0).period, std::chrono::seconds(1));
+    EXPECT_EQ(mtf.find("H1"), 1u);
+    EXPECT_EQ(mtf.find("W1"), 2u);
+}
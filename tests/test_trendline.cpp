@@ -7,6 +7,8 @@
 
 #include <gtest/gtest.h>
 #include "pnf/pnf.hpp"
+#include <algorithm>
+#include <cmath>
 
 using namespace pnf;
 
@@ -53,6 +55,14 @@ TEST(TrendLineTest, SetActive) {
     EXPECT_FALSE(line.is_active());
 }
 
+TEST(TrendLineTest, MarkBroken) {
+    TrendLine line(TrendLineType::BullishSupport, 2, 100.0, 0, 1.0);
+    EXPECT_EQ(line.break_column(), -1);
+    line.mark_broken(7);
+    EXPECT_FALSE(line.is_active());
+    EXPECT_EQ(line.break_column(), 7);
+}
+
 TEST(TrendLineManagerTest, Creation) {
     const TrendLineManager manager(1.0);
 
@@ -65,4 +75,174 @@ TEST(TrendLineManagerTest, Clear) {
     TrendLineManager manager(1.0);
     manager.clear();
     EXPECT_EQ(manager.active_trend_line(), nullptr);
-}
\ No newline at end of file
+}
+namespace {
+    /// Reference classification matching the original backward scan.
+    bool reference_low(const Chart& chart, const int i) {
+        const Column* col = chart.column(i);
+        if (col->type() != ColumnType::O || i < 1) return false;
+        const Column* prev = chart.column(i - 1);
+        if (prev->type() != ColumnType::X || col->lowest_price() >= prev->highest_price()) return false;
+        for (int j = 1; j <= std::min(3, i); j++) {
+            if (chart.column(i - j)->lowest_price() < col->lowest_price()) return false;
+        }
+        return true;
+    }
+
+    bool reference_high(const Chart& chart, const int i) {
+        const Column* col = chart.column(i);
+        if (col->type() != ColumnType::X || i < 1) return false;
+        const Column* prev = chart.column(i - 1);
+        if (prev->type() != ColumnType::O || col->highest_price() <= prev->lowest_price()) return false;
+        for (int j = 1; j <= std::min(3, i); j++) {
+            if (chart.column(i - j)->highest_price() > col->highest_price()) return false;
+        }
+        return true;
+    }
+}
+
+TEST(TrendLineManagerTest, PivotStacksMatchFullScan) {
+    ChartConfig cfg;
+    cfg.box_size_method = BoxSizeMethod::Fixed;
+    cfg.box_size = 1.0;
+    Chart chart(cfg);
+    const Timestamp now = std::chrono::system_clock::now();
+    for (int i = 0; i < 20000; i++) {
+        chart.add_data(500.0 + 200.0 * std::sin(i * 0.003) + 12.0 * std::sin(i * 0.21), now);
+    }
+    ASSERT_GT(chart.column_count(), 500u);
+
+    std::pmr::vector<int> lows, highs;
+    for (int i = 0; i + 1 < static_cast<int>(chart.column_count()); i++) {
+        if (reference_low(chart, i)) lows.push_back(i);
+        if (reference_high(chart, i)) highs.push_back(i);
+    }
+
+    const TrendLineManager* tm = chart.trend_line_manager();
+    EXPECT_EQ(tm->significant_lows(), lows);
+    EXPECT_EQ(tm->significant_highs(), highs);
+    EXPECT_FALSE(tm->all_trend_lines().empty());
+
+    chart.clear();
+    EXPECT_TRUE(tm->significant_lows().empty());
+    EXPECT_TRUE(tm->all_trend_lines().empty());
+}
+
+TEST(TrendLineManagerTest, HistoryMatchesReplay) {
+    ChartConfig cfg;
+    cfg.box_size_method = BoxSizeMethod::Fixed;
+    cfg.box_size = 1.0;
+    Chart chart(cfg);
+    const TrendLineManager* tm = chart.trend_line_manager();
+    const Timestamp now = std::chrono::system_clock::now();
+
+    // Record the live answer right after each column is created.
+    std::vector<const TrendLine*> governing;
+    std::vector<int> bias;
+    for (int i = 0; i < 20000; i++) {
+        chart.add_data(500.0 + 200.0 * std::sin(i * 0.003) + 12.0 * std::sin(i * 0.21), now);
+        if (chart.column_count() > governing.size()) {
+            const TrendLine* active = tm->active_trend_line();
+            governing.push_back(active && active->is_active() ? active : nullptr);
+            bias.push_back(chart.has_bullish_bias() ? 1 : chart.has_bearish_bias() ? -1 : 0);
+        }
+    }
+    ASSERT_GT(tm->history().size(), 2u);
+    EXPECT_EQ(tm->history().size(), static_cast<size_t>(std::count_if(
+        tm->all_trend_lines().begin(), tm->all_trend_lines().end(),
+        [](const auto& line) { return line->family() == TrendLineFamily::Primary; })));
+
+    size_t broken = 0;
+    for (size_t c = 0; c < governing.size(); c++) {
+        const int col = static_cast<int>(c);
+        EXPECT_EQ(tm->line_at(col), governing[c]) << "column " << c;
+        EXPECT_EQ(tm->bullish_bias_at(col), bias[c] == 1);
+        EXPECT_EQ(tm->bearish_bias_at(col), bias[c] == -1);
+    }
+    for (size_t i = 1; i < tm->history().size(); i++) {
+        EXPECT_LT(tm->history()[i - 1].from_column, tm->history()[i].from_column);
+        if (tm->history()[i - 1].line->break_column() >= 0) broken++;
+    }
+    EXPECT_GT(broken, 0u);
+    EXPECT_EQ(tm->line_at(-1), nullptr);
+
+    chart.clear();
+    EXPECT_TRUE(tm->history().empty());
+}
+
+TEST(TrendLineTest, FamiliesAndSides) {
+    const TrendLine channel(TrendLineType::BullishChannel, 0, 110.0, 0, 1.0);
+    EXPECT_EQ(channel.family(), TrendLineFamily::Channel);
+    EXPECT_TRUE(channel.is_rising());
+    EXPECT_FALSE(channel.holds_above());
+    EXPECT_DOUBLE_EQ(channel.price_at_column(3), 113.0);
+    EXPECT_TRUE(channel.is_broken(3, 114.5));
+    EXPECT_FALSE(channel.is_broken(3, 100.0));
+
+    const TrendLine internal(TrendLineType::BearishInternal, 0, 90.0, 0, 1.0);
+    EXPECT_EQ(internal.family(), TrendLineFamily::Internal);
+    EXPECT_FALSE(internal.is_rising());
+    EXPECT_FALSE(internal.holds_above());
+    EXPECT_DOUBLE_EQ(internal.price_at_column(2), 88.0);
+    EXPECT_EQ(TrendLine(TrendLineType::BearishResistance, 0, 1.0, 0, 1.0).family(), TrendLineFamily::Primary);
+}
+
+TEST(TrendLineManagerTest, SecondaryLinesMatchBruteForce) {
+    ChartConfig cfg;
+    cfg.box_size_method = BoxSizeMethod::Fixed;
+    cfg.box_size = 1.0;
+    Chart chart(cfg);
+    const Timestamp now = std::chrono::system_clock::now();
+    for (int i = 0; i < 20000; i++) {
+        chart.add_data(500.0 + 200.0 * std::sin(i * 0.003) + 12.0 * std::sin(i * 0.21), now);
+    }
+    const TrendLineManager* tm = chart.trend_line_manager();
+    ASSERT_FALSE(tm->history(TrendLineFamily::Internal).empty());
+    ASSERT_FALSE(tm->history(TrendLineFamily::Channel).empty());
+
+    // Every channel must clear all finalised extremes since its primary line's anchor.
+    for (const auto& span : tm->history(TrendLineFamily::Channel)) {
+        const TrendLine* parent = tm->line_at(span.from_column);
+        ASSERT_NE(parent, nullptr);
+        EXPECT_EQ(span.line->is_rising(), parent->is_rising());
+        const TrendLinePoint start = span.line->start_point();
+        for (int j = parent->start_point().column_index + 1; j < span.from_column; j++) {
+            const double line = start.price + (span.line->is_rising() ? 1.0 : -1.0) * (j - start.column_index);
+            if (span.line->is_rising())
+                EXPECT_LE(chart.column(j)->highest_price(), line + 1e-9);
+            else
+                EXPECT_GE(chart.column(j)->lowest_price(), line - 1e-9);
+        }
+    }
+
+    // Internal lines start at a pivot inside the trend, more than a box off the primary line.
+    for (const auto& span : tm->history(TrendLineFamily::Internal)) {
+        const TrendLine* parent = tm->line_at(span.from_column);
+        ASSERT_NE(parent, nullptr);
+        const TrendLinePoint start = span.line->start_point();
+        EXPECT_GT(start.column_index, parent->start_point().column_index);
+        const auto& pivots = parent->is_rising() ? tm->significant_lows() : tm->significant_highs();
+        EXPECT_TRUE(std::binary_search(pivots.begin(), pivots.end(), start.column_index));
+        EXPECT_GT(std::abs(start.price - parent->price_at_column(start.column_index)), 1.0);
+    }
+
+    size_t channel_breaks = 0;
+    int last = 0;
+    for (const auto& event : tm->events()) {
+        EXPECT_GE(event.column, last);
+        last = event.column;
+        if (event.type == TrendLineEventType::Broken) {
+            EXPECT_EQ(event.line->break_column(), event.column);
+            if (event.line->family() == TrendLineFamily::Channel) channel_breaks++;
+        }
+    }
+    EXPECT_GT(channel_breaks, 0u);
+    EXPECT_EQ(static_cast<size_t>(std::count_if(tm->events().begin(), tm->events().end(),
+        [](const TrendLineEvent& e) { return e.type == TrendLineEventType::Drawn; })), tm->all_trend_lines().size());
+
+    chart.clear();
+    EXPECT_TRUE(tm->events().empty());
+    EXPECT_TRUE(tm->history(TrendLineFamily::Channel).empty());
+    EXPECT_EQ(tm->channel_line(), nullptr);
+    EXPECT_EQ(tm->internal_line(), nullptr);
+}
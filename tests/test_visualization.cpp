@@ -139,6 +139,8 @@ TEST_F(VisualizationTest, JsonExporterClass) {
     std::string output = exporter.export_chart(*chart);
     EXPECT_FALSE(output.empty());
     EXPECT_NE(output.find("box_size"), std::string::npos);
+    EXPECT_NE(output.find("first_time"), std::string::npos);
+    EXPECT_NE(output.find("bar_count"), std::string::npos);
 }
 
 TEST_F(VisualizationTest, JsonExporterIndicators) {
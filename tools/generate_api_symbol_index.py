@@ -33,6 +33,17 @@ CPP_HEADERS = [
     ROOT / "headers" / "pnf" / "visualization.hpp",
     ROOT / "headers" / "pnf" / "csv_loader.hpp",
     ROOT / "headers" / "pnf" / "version.hpp",
+    ROOT / "headers" / "pnf" / "thread_pool.hpp",
+    ROOT / "headers" / "pnf" / "sweep.hpp",
+    ROOT / "headers" / "pnf" / "backtest.hpp",
+    ROOT / "headers" / "pnf" / "breadth.hpp",
+    ROOT / "headers" / "pnf" / "scanner.hpp",
+    ROOT / "headers" / "pnf" / "relative_strength.hpp",
+    ROOT / "headers" / "pnf" / "timeframe.hpp",
+    ROOT / "headers" / "pnf" / "chart_family.hpp",
+    ROOT / "headers" / "pnf" / "log_grid.hpp",
+    ROOT / "headers" / "pnf" / "marker.hpp",
+    ROOT / "headers" / "pnf" / "mask.hpp",
 ]
 
 